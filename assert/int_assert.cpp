@@ -45,8 +45,8 @@ int_assert::int_assert(MODULE *module)
                                 PT_enumeration, "within_mode", get_within_mode_offset(),
                                 PT_KEYWORD,"WITHIN_VALUE",(enumeration)IN_ABS,
                                 PT_KEYWORD,"WITHIN_RATIO",(enumeration)IN_RATIO,
-                                PT_int32, "value", get_value_offset(),
-                                PT_int32, "within", get_within_offset(),
+                                PT_int64, "value", get_value_offset(),
+                                PT_int64, "within", get_within_offset(),
                                 PT_char1024, "target", get_target_offset(),
                                 NULL)<1){
             char msg[256];
@@ -134,12 +134,22 @@ TIMESTAMP int_assert::commit(TIMESTAMP t1, TIMESTAMP t2)
 		range = within;
 	}
     
-	// test the target value
-	int64 x; target_prop.getp(x);
+	// test the target value - read it at its own width
+	int64 x;
+	if ( target_prop.get_type()==PT_int16 )
+	{
+		int16 x16; target_prop.getp(x16); x = x16;
+	}
+	else if ( target_prop.get_type()==PT_int32 )
+	{
+		int32 x32; target_prop.getp(x32); x = x32;
+	}
+	else
+		target_prop.getp(x);
 	if ( status == ASSERT_TRUE )
 	{
         int64 theDiff = x-value;
-        if(theDiff > 0xFFFFFFFF || theDiff < -0xFFFFFFFF){
+        if(theDiff > 0xFFFFFFFFLL || theDiff < -0xFFFFFFFFLL){
             gl_warning("int_assert may be incorrect, difference range outside 32-bit abs() range");
         }
 		int64 m = fabs((double) theDiff);
@@ -155,7 +165,7 @@ TIMESTAMP int_assert::commit(TIMESTAMP t1, TIMESTAMP t2)
 	else if ( status == ASSERT_FALSE )
 	{
         int64 theDiff = x-value;
-        if(theDiff > 0xFFFFFFFF || theDiff < -0xFFFFFFFF){
+        if(theDiff > 0xFFFFFFFFLL || theDiff < -0xFFFFFFFFLL){
             gl_warning("int_assert may be incorrect, difference range outside 32-bit abs() range");
         }
         int64 m = fabs((double) theDiff);
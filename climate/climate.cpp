@@ -530,12 +530,22 @@ int tmy2_reader::read_data(double *dnr, double *dhr, double *ghr, double *tdb, d
 */
 double tmy2_reader::calc_solar(COMPASS_PTS cpt, short doy, double lat, double sol_time, double dnr, double dhr, double ghr, double gnd_ref, double vert_angle = 90)
 {
-	SolarAngles *sa = new SolarAngles();
+	SolarAngles sa;
 	double surface_angle = surface_angles[cpt];
-	double cos_incident = sa->cos_incident(lat,RAD(vert_angle),RAD(surface_angle),sol_time,doy);
-	delete sa;
+	double cos_incident = sa.cos_incident(lat,RAD(vert_angle),RAD(surface_angle),sol_time,doy);
 
 	//double solar = (dnr * cos_incident + dhr/2 + ghr * gnd_ref);
+	return calc_solar(cos_incident,dnr,dhr);
+}
+/**
+	Calculate the solar radiation on a surface whose incidence is already known
+
+	@param cos_incident cosine of the angle of incidence on the surface
+	@param dnr Direct Normal Radiation
+	@param dhr Diffuse Horizontal Radiation
+*/
+double tmy2_reader::calc_solar(double cos_incident, double dnr, double dhr)
+{
 	double solar = dnr * cos_incident + dhr;
 
 	if (peak_solar==0 || solar>peak_solar) peak_solar = solar;
@@ -550,6 +560,125 @@ void tmy2_reader::close( ) {
 
 /**@}**********************************************************/
 
+/**	@addtogroup solar_table Solar geometry table
+	@ingroup climate
+
+	The solar position only depends on the location and the local time, so the geometry
+	used with CSV weather data is tabulated by time of day every solar_table_interval
+	seconds and linearly interpolated between entries.  Entries are computed the first
+	time they are used, so coarse weather steps never compute more geometry than they did
+	before, and climate objects at the same location share the table for the current day.
+ @{
+ **/
+
+/** Compute the solar geometry at a local standard time on a given day **/
+static void calc_solar_geometry(short yearday, short doy, double std_time, double latitude, double longitude, double tz_meridian, SOLARGEOMETRY *geometry)
+{
+	SolarAngles sa;
+	double sol_time = sa.solar_time(std_time,yearday,RAD(tz_meridian),RAD(longitude));
+	geometry->zenith = sa.zenith(doy,RAD(latitude),sol_time);
+	geometry->cos_incident[CP_H] = sa.cos_incident(RAD(latitude),RAD(0.0),RAD(surface_angles[CP_E]),sol_time,yearday);
+	for ( int cpt = CP_N ; cpt < CP_LAST ; cpt++ )
+		geometry->cos_incident[cpt] = sa.cos_incident(RAD(latitude),RAD(90.0),RAD(surface_angles[cpt]),sol_time,yearday);
+}
+
+/** Compute the solar geometry at the local time \p dt **/
+static void calc_solar_geometry(DATETIME &dt, double latitude, double longitude, double tz_meridian, SOLARGEOMETRY *geometry)
+{
+	SolarAngles sa;
+	double std_time = (double)dt.hour + dt.minute/60.0 + dt.second/3600.0 + (dt.is_dst ? -1:0);
+	calc_solar_geometry(dt.yearday,sa.day_of_yr(dt.month,dt.day),std_time,latitude,longitude,tz_meridian,geometry);
+}
+
+class solar_table {
+private:
+	double latitude; ///< location latitude (deg)
+	double longitude; ///< location longitude (deg)
+	double tz_meridian; ///< timezone meridian (deg)
+	int interval; ///< time between entries (s)
+	int size; ///< number of entries in a day
+	int year, yearday; ///< day currently tabulated
+	SOLARGEOMETRY *entry; ///< entries for standard time followed by entries for daylight time
+	bool *valid; ///< entries already computed for the current day
+	LOCKVAR lock;
+	solar_table *next;
+	static solar_table *first;
+	static LOCKVAR first_lock;
+private:
+	solar_table(double lat, double lon, double tzm, int dt)
+		: latitude(lat), longitude(lon), tz_meridian(tzm), interval(dt), year(-1), yearday(-1), lock(0), next(NULL)
+	{
+		size = 86400/interval + 2;
+		entry = new SOLARGEOMETRY[2*size];
+		valid = new bool[2*size];
+	};
+	/** Get entry \p n of day \p dt, computing it if needed (table must be locked) **/
+	SOLARGEOMETRY *get_entry(DATETIME &dt, int n)
+	{
+		int k = (dt.is_dst ? size : 0) + n;
+		if ( !valid[k] )
+		{
+			SolarAngles sa;
+			int t = n*interval;
+			double std_time = (double)(t/3600) + ((t/60)%60)/60.0 + (t%60)/3600.0 + (dt.is_dst ? -1:0);
+			calc_solar_geometry(dt.yearday,sa.day_of_yr(dt.month,dt.day),std_time,latitude,longitude,tz_meridian,&entry[k]);
+			valid[k] = true;
+		}
+		return &entry[k];
+	};
+public:
+	/** Find the table for a location, creating it if none exists yet **/
+	static solar_table *find(double lat, double lon, double tzm, int dt)
+	{
+		solar_table *table;
+		WRITELOCK(&first_lock);
+		for ( table = first ; table != NULL ; table = table->next )
+		{
+			if ( table->latitude == lat && table->longitude == lon && table->tz_meridian == tzm && table->interval == dt )
+				break;
+		}
+		if ( table == NULL )
+		{
+			table = new solar_table(lat,lon,tzm,dt);
+			table->next = first;
+			first = table;
+		}
+		WRITEUNLOCK(&first_lock);
+		return table;
+	};
+	/** Get the solar geometry at the local time \p dt **/
+	void get(DATETIME &dt, SOLARGEOMETRY *geometry)
+	{
+		int t = dt.hour*3600 + dt.minute*60 + dt.second;
+		int n = t/interval;
+		double f = (double)(t%interval)/interval;
+		WRITELOCK(&lock);
+		if ( dt.year != year || dt.yearday != yearday )
+		{
+			memset(valid,0,sizeof(bool)*2*size);
+			year = dt.year;
+			yearday = dt.yearday;
+		}
+		SOLARGEOMETRY *g0 = get_entry(dt,n);
+		if ( f == 0.0 )
+		{
+			*geometry = *g0;
+		}
+		else
+		{
+			SOLARGEOMETRY *g1 = get_entry(dt,n+1);
+			geometry->zenith = g0->zenith + f*(g1->zenith-g0->zenith);
+			for ( int cpt = CP_H ; cpt < CP_LAST ; cpt++ )
+				geometry->cos_incident[cpt] = g0->cos_incident[cpt] + f*(g1->cos_incident[cpt]-g0->cos_incident[cpt]);
+		}
+		WRITEUNLOCK(&lock);
+	};
+};
+solar_table *solar_table::first = NULL;
+LOCKVAR solar_table::first_lock = 0;
+
+/**@}**********************************************************/
+
 /**	@addtogroup climate Weather (climate)
 	@ingroup modules
 
@@ -619,6 +748,7 @@ climate::climate(MODULE *module) : gld_object()
 			PT_double,"cloud_alpha[pu]",PADDR(cloud_alpha),PT_DEFAULT,"400 pu", PT_DESCRIPTION,"cloud alpha",
 			PT_double,"cloud_num_layers[pu]",PADDR(cloud_num_layers),PT_DEFAULT,"40 pu", PT_DESCRIPTION,"number of cloud layers",
 			PT_double,"cloud_aerosol_transmissivity[pu]",PADDR(cloud_aerosol_transmissivity),PT_DEFAULT,"0.95 pu", PT_DESCRIPTION,"cloud aerosal transmissivity",
+			PT_double,"solar_table_interval[s]",PADDR(solar_table_interval),PT_DEFAULT,"60 s", PT_DESCRIPTION,"interval at which the solar geometry is tabulated for CSV weather data (0 computes it at every sync)",
 			NULL)<1) GL_THROW("unable to publish properties in %s",__FILE__);
 		gl_publish_function(oclass,	"calculate_solar_radiation_degrees", (FUNCTIONADDR)calculate_solar_radiation_degrees);
 		gl_publish_function(oclass,	"calculate_solar_radiation_radians", (FUNCTIONADDR)calculate_solar_radiation_radians);
@@ -669,6 +799,7 @@ void climate::set_defaults(bool is_template)
 	MIN_LON = 0;
 	MAX_LON = 0;
 	global_transmissivity = 1.0;
+	geometry = NULL;
 	if ( is_template )
 		defaults = this;
 }
@@ -817,6 +948,17 @@ int climate::init(OBJECT *parent)
 
 			//Set the timezone offset - stolen from TMY code below
 			tz_meridian =  15 * tz_num_offset;//std_meridians[-file.tz_offset-5];
+
+			//Share the tabulated solar geometry with other climates at this location
+			if (solar_table_interval < 0)
+			{
+				gl_error("climate:%s - solar_table_interval cannot be negative",obj->name);
+				return 0;
+			}
+			else if (solar_table_interval >= 1)
+			{
+				geometry = solar_table::find(reader->latitude,reader->longitude,tz_meridian,(int)std::min(solar_table_interval,86400.0));
+			}
 		}
 
 		return rv;
@@ -1489,52 +1631,70 @@ void climate::convert_to_fuzzy_cloud( double cut_elevation, int num_fuzzy_layers
 	double shade_step_size = 1.0/alpha;
 
 	if (cut_elevation == EMPTY_VALUE ) { //Initialization call uses EMPTY_VALUE as the cut elevation.
-    //TDH: trivially parallelizable
 		//Resizing fuzzy cloud pattern
-		fuzzy_cloud_pattern.resize(num_fuzzy_layers);
-		for (int i = 0; i < num_fuzzy_layers; ++i ) {
-			fuzzy_cloud_pattern[i].resize(cloud_pattern_size);
-			for(int j = 0; j < cloud_pattern_size; j++ ) {
-				fuzzy_cloud_pattern[i][j].resize(cloud_pattern_size);
-			}
+		//The layers are all accumulated into the first one, so only that one is stored.
+		fuzzy_cloud_pattern.resize(1);
+		fuzzy_cloud_pattern[0].resize(cloud_pattern_size);
+		for(int j = 0; j < cloud_pattern_size; j++ ) {
+			fuzzy_cloud_pattern[0][j].assign(cloud_pattern_size,0);
 		}
-
-		//Initializing fuzzy cloud pattern
-    //TDH: trivially parallelizable
-		for (int i = 0; i < num_fuzzy_layers; i++ ) {
-			for (int j = 0; j < cloud_pattern_size; j++ ) {
-				for (int k = 0; k < cloud_pattern_size; k++ ) {
-					fuzzy_cloud_pattern[i][j][k] = 0;
-				 }
-			 }
-		 }
 	}
 
 	//Filling in fuzzy pattern with random values
-  //TDH: trivially parallelizable
+	//The first layer visits the whole pattern and coerces clear sky and EMPTY_VALUES into 0. After
+	//  that only cloudy pixels below the (decreasing) layer cut accumulate, so the later layers only
+	//  visit the list of those pixels, in the same order so the random values drawn are the same.
+	std::vector<std::pair<int,int> > cloudy;
 	for (int i = 0; i < num_fuzzy_layers; i++ ) 
 	{
 		double rand_upper = ((double)(i+1)/(double)num_fuzzy_layers)*cut_elevation;
 		double rand_lower = (((double)(i+1)-1)/(double)num_fuzzy_layers)*cut_elevation;
-		for (int j = 0; j < cloud_pattern_size; j++ ) 
+		double layer_cut = cut_elevation - ((i+1)*shade_step_size);
+		if ( i == 0 )
 		{
-			for (int kk = 0; kk < cloud_pattern_size; kk++ ) 
+			for (int j = 0; j < cloud_pattern_size; j++ ) 
 			{
-				if (binary_cloud_pattern[j][kk] == 0.0 && normalized_cloud_pattern[j][kk] != EMPTY_VALUE && fuzzy_cloud_pattern[0][j][kk] != EMPTY_VALUE ) 
-				{ 
-					//Areas with 0 in the binary pattern are cloudy
-					if (normalized_cloud_pattern[j][kk] <= cut_elevation - ((i+1)*shade_step_size) ) 
+				std::vector<int> &binary = binary_cloud_pattern[j];
+				std::vector<double> &normalized = normalized_cloud_pattern[j];
+				std::vector<double> &fuzzy = fuzzy_cloud_pattern[0][j];
+				for (int kk = 0; kk < cloud_pattern_size; kk++ ) 
+				{
+					if (binary[kk] == 0.0 && normalized[kk] != EMPTY_VALUE && fuzzy[kk] != EMPTY_VALUE ) 
 					{ 
-						//only values below the cut elevation accumulate
-						fuzzy_cloud_pattern[0][j][kk] = gl_random_uniform(RNGSTATE,rand_lower, rand_upper)  + fuzzy_cloud_pattern[0][j][kk];
+						//Areas with 0 in the binary pattern are cloudy
+						if (normalized[kk] <= layer_cut ) 
+						{ 
+							//only values below the cut elevation accumulate
+							fuzzy[kk] = gl_random_uniform(RNGSTATE,rand_lower, rand_upper)  + fuzzy[kk];
+							cloudy.push_back(std::make_pair(j,kk));
+						}
+					}
+					else 
+					{ 
+						//EMPTY_VALUES get coerced into 0.
+						fuzzy[kk] = 0;
+						if (binary[kk] == 0.0 && normalized[kk] != EMPTY_VALUE && normalized[kk] <= layer_cut )
+						{
+							//cloudy pixels that were EMPTY_VALUES accumulate from the next layer on
+							cloudy.push_back(std::make_pair(j,kk));
+						}
 					}
 				}
-				else 
-				{ 
-					//EMPTY_VALUES get coerced into 0.
-					fuzzy_cloud_pattern[0][j][kk] = 0;
+			}
+		}
+		else
+		{
+			size_t n = 0;
+			for (size_t p = 0; p < cloudy.size(); p++ )
+			{
+				int j = cloudy[p].first, kk = cloudy[p].second;
+				if (normalized_cloud_pattern[j][kk] <= layer_cut )
+				{
+					fuzzy_cloud_pattern[0][j][kk] = gl_random_uniform(RNGSTATE,rand_lower, rand_upper)  + fuzzy_cloud_pattern[0][j][kk];
+					cloudy[n++] = cloudy[p];
 				}
 			}
+			cloudy.resize(n);
 		}
 	}
 
@@ -2066,26 +2226,20 @@ TIMESTAMP climate::presync(TIMESTAMP t0) /* called in presync */
 	// TODO: need to read the cloud stuff from the csv file
 	// changes appear to be limited to weather.h, weather.cpp, csv_reader.h, csv_reader.cpp
 	if(t0 > TS_ZERO && reader_type == RT_CSV ) {
-		gld_clock now(t0);
 		csv_reader *cr = OBJECTDATA(reader,csv_reader);
 		csv_rv = cr->get_data(t0, &temperature, &humidity, &solar_direct, &solar_diffuse, &solar_global, &global_horizontal_extra, &wind_speed,&wind_dir, &opq_sky_cov, &tot_sky_cov, &rainfall, &snowdepth, &pressure);
 		// calculate the solar radiation
-		double sol_time = sa->solar_time((double)now.get_hour()+now.get_minute()/60.0+now.get_second()/3600.0 + (now.get_is_dst() ? -1:0),now.get_yearday(),RAD(tz_meridian),RAD(reader->longitude));
-		//std::cout << now.get_hour() << "," << now.get_minute() << "," << now.get_second() <<"," << now.get_is_dst() << "," << now.get_yearday() << "," << tz_meridian << "," << reader->longitude << std::endl;
-		//std::cout << sol_time << std::endl;
+		SOLARGEOMETRY solar_geometry;
 		gl_localtime(t0, &dt);
-		short day_of_yr = sa->day_of_yr(dt.month,dt.day);
-		solar_zenith = sa->zenith(day_of_yr, RAD(reader->latitude), sol_time);
-		double sol_rad = 0.0;
-
+		if ( geometry != NULL )
+			geometry->get(dt,&solar_geometry);
+		else
+			calc_solar_geometry(dt,reader->latitude,reader->longitude,tz_meridian,&solar_geometry);
+		solar_zenith = solar_geometry.zenith;
 
 		for(COMPASS_PTS c_point = CP_H; c_point < CP_LAST;c_point=COMPASS_PTS(c_point+1) ) {
-			if(c_point == CP_H)
-				sol_rad = file->calc_solar(CP_E,now.get_yearday(),RAD(reader->latitude),sol_time,solar_direct,solar_diffuse,solar_global,ground_reflectivity,0.0);//(double)dnr * cos_incident + dhr;
-			else
-				sol_rad = file->calc_solar(c_point,now.get_yearday(),RAD(reader->latitude),sol_time,solar_direct,solar_diffuse,solar_global,ground_reflectivity);//(double)dnr * cos_incident + dhr;
 			/* TMY2 solar radiation data is in Watt-hours per square meter. */
-			solar_flux[c_point] = sol_rad;
+			solar_flux[c_point] = file->calc_solar(solar_geometry.cos_incident[c_point],solar_direct,solar_diffuse);
 		}
 	}
 
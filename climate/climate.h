@@ -157,6 +157,7 @@ public:
 	/** obtain records **/
 
 	double calc_solar(COMPASS_PTS cpt, short doy, double lat, double sol_time, double dnr, double dhr, double ghr, double gnd_ref, double vert_angle);
+	double calc_solar(double cos_incident, double dnr, double dhr);
 
 };
 
@@ -168,6 +169,14 @@ typedef struct s_climate_record {
 	double solar;
 } CLIMATERECORD;
 
+/** Solar geometry at one point in time **/
+typedef struct s_solar_geometry {
+	double zenith; ///< solar zenith angle (rad)
+	double cos_incident[CP_LAST]; ///< cosine of incidence on each compass point (CP_H is horizontal)
+} SOLARGEOMETRY;
+
+class solar_table;
+
 typedef	enum e_record_type {
 		RT_NONE,
 		RT_TMY2,
@@ -228,6 +237,8 @@ private:
 	tmy2_reader *file;
 	weather_reader *reader_hndl;
 	TMYDATA *tmy;
+	double solar_table_interval; ///< interval at which the CSV solar geometry is tabulated (s)
+	solar_table *geometry; ///< tabulated solar geometry (NULL if computed at every sync)
 public:
 	enumeration reader_type;
 	static CLASS *oclass;
@@ -5,10 +5,29 @@
 
  **/
 
+#include <string>
+#include <vector>
 #include "csv_reader.h"
 
 CLASS *csv_reader::oclass = 0;
 
+/*	Weather files that have already been parsed, so that readers which open the same file
+	with the same columns and time format share the samples instead of parsing the file
+	again.  The header property lines are kept so they can be applied to each reader.
+ */
+typedef struct s_csv_data {
+	char256 filename;
+	char256 columns_str;
+	char32 timefmt;
+	std::vector<std::string> properties;
+	int column_ct;
+	PROPERTY **columns;
+	weather **samples;
+	long int sample_ct;
+	struct s_csv_data *next;
+} CSVDATA;
+static CSVDATA *csv_data = NULL;
+
 EXPORT int create_csv_reader(OBJECT **obj, OBJECT *parent)
 {
 	*obj = gl_create_object(csv_reader::oclass);
@@ -91,6 +110,34 @@ int csv_reader::open(const char *file)
 	}
 
 	strncpy(filename, file, 127);
+
+	// share the samples of a reader that already parsed this file
+	for ( CSVDATA *data = csv_data ; data != NULL ; data = data->next )
+	{
+		if ( strcmp(data->filename,file) == 0 && strcmp(data->columns_str,columns_str) == 0 && strcmp(data->timefmt,timefmt) == 0 )
+		{
+			for ( std::vector<std::string>::iterator prop = data->properties.begin() ; prop != data->properties.end() ; prop++ )
+			{
+				strncpy(line, prop->c_str(), sizeof(line)-1);
+				line[sizeof(line)-1] = '\0';
+				if ( 0 == read_prop(line) )
+				{
+					gl_error("csv_reader::open ~ property read failure in '%s'", file);
+					return 0;
+				}
+			}
+			column_ct = data->column_ct;
+			columns = data->columns;
+			samples = data->samples;
+			sample_ct = data->sample_ct;
+			obj->latitude = lat_deg + (lat_deg > 0 ? lat_min : -lat_min) / 60;
+			obj->longitude = long_deg + (long_deg > 0 ? long_min : -long_min) / 60;
+			status = CR_OPEN;
+			return 1;
+		}
+	}
+	std::vector<std::string> properties;
+
 	infile = fopen(filename, "r");
 	if ( infile == 0 ) 
 	{
@@ -134,8 +181,10 @@ int csv_reader::open(const char *file)
 			// property
 			if ( 0 == read_prop(line+1) ) {
 				gl_error("csv_reader::open ~ property read failure on line %i", linenum);
+				fclose(infile);
 				return 0;
 			} else {
+				properties.push_back(line+1);
 				continue;
 			}
 		}
@@ -144,6 +193,7 @@ int csv_reader::open(const char *file)
 			if ( 0 == read_header(line) )
 			{
 				gl_error("csv_reader::open ~ column header read failure on line %i", linenum);
+				fclose(infile);
 				return 0;
 			} else {
 				has_cols = 1;
@@ -155,6 +205,7 @@ int csv_reader::open(const char *file)
 			if ( 0 == line_rv ) 
 			{
 				gl_error("csv_reader::open ~ data line read failure on line %i", linenum);
+				fclose(infile);
 				return 0;
 			}
 			else if (1 == line_rv )
@@ -177,6 +228,21 @@ int csv_reader::open(const char *file)
 		samples[i] = wtr;
 	}
 	sample_ct = i; // if wtr was the limiting factor, truncate the count
+	fclose(infile);
+	infile = NULL;
+
+	CSVDATA *data = new CSVDATA;
+	strcpy(data->filename, file);
+	strcpy(data->columns_str, columns_str);
+	strcpy(data->timefmt, timefmt);
+	data->properties = properties;
+	data->column_ct = column_ct;
+	data->columns = columns;
+	data->samples = samples;
+	data->sample_ct = sample_ct;
+	data->next = csv_data;
+	csv_data = data;
+	status = CR_OPEN;
 
 //	index = -1;	// forces to start on zero-eth index
 
@@ -500,8 +566,20 @@ TIMESTAMP csv_reader::get_data(TIMESTAMP t0, double *temp, double *humid, double
 		}
 		index = sample_ct - i - 1;
 #endif
-		for ( i = 0; i < sample_ct; ++i ) 
+		/*	Samples are in time order within the year, so bisect for the first sample at
+		 *	or after t0.  Leap days on non-leap years are skipped, so they are compared
+		 *	using the first sample after them.
+		 */
+		int lo = 0, hi = sample_ct;
+		while ( lo < hi )
 		{
+			int mid = (lo+hi)/2;
+			for ( i = mid; i < sample_ct && !ISLEAPYEAR(now.year) && samples[i]->month == 2 && samples[i]->day == 29; ++i ) {}
+			if ( i == sample_ct )
+			{
+				hi = mid;
+				continue;
+			}
 			guess_dt.year = now.year;
 			guess_dt.month = samples[i]->month;
 			guess_dt.day = samples[i]->day;
@@ -509,19 +587,15 @@ TIMESTAMP csv_reader::get_data(TIMESTAMP t0, double *temp, double *humid, double
 			guess_dt.minute = samples[i]->minute;
 			guess_dt.second = samples[i]->second;
 			strcpy(guess_dt.tz, now.tz);
-//			strcpy(guess_dt.tz, "GMT");
-			if ( guess_dt.month == 2 && guess_dt.day == 29 ) 
-			{
-				if ( !ISLEAPYEAR(now.year))
-					continue; // skip leap days on non-leap years
-			}
 			guess_ts = (TIMESTAMP)gl_mktime(&guess_dt);
-
-			if ( guess_ts >= t0 ) {
-				i -= 1; // we want the sample *before* this one
-				break;
-			}
+			if ( guess_ts >= t0 )
+				hi = mid;
+			else
+				lo = i+1;
 		}
+		for ( i = lo; i < sample_ct && !ISLEAPYEAR(now.year) && samples[i]->month == 2 && samples[i]->day == 29; ++i ) {}
+		if ( i < sample_ct )
+			i -= 1; // we want the sample *before* this one
 
 		index = i;
 
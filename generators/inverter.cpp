@@ -5738,8 +5738,7 @@ SIMULATIONMODE inverter::inter_deltaupdate(unsigned int64 delta_time, unsigned l
 	//						curr_state.Q_Out[0] = VA_Out.Im();
 							if (pCircuit_V[0].Mag() > 0.0)
 							{
-								curr_state.ed[0] = ((~(complex(Pref, Qref_PI[0])/(*pCircuit_V))) - (~(complex(curr_state.P_Out[0],curr_state.Q_Out[0])/(*pCircuit_V)))).Re();
-								curr_state.eq[0] = ((~(complex(Pref, Qref_PI[0])/(*pCircuit_V))) - (~(complex(curr_state.P_Out[0],curr_state.Q_Out[0])/(*pCircuit_V)))).Im();
+								PI_current_error(complex(Pref, Qref_PI[0]), complex(curr_state.P_Out[0],curr_state.Q_Out[0]), *pCircuit_V, curr_state.ed[0], curr_state.eq[0]);
 							}
 							else
 							{
@@ -5764,8 +5763,7 @@ SIMULATIONMODE inverter::inter_deltaupdate(unsigned int64 delta_time, unsigned l
 	//							curr_state.Q_Out[i] = VA_Out.Im() / 3.0; // Q_Out for each phase is calculated seperately now above
 								if (pCircuit_V[i].Mag() > 0.0)
 								{
-									curr_state.ed[i] = ((~(complex(Pref/3.0, Qref_PI[i])/(pCircuit_V[i]))) - (~(complex(curr_state.P_Out[i],curr_state.Q_Out[i])/(pCircuit_V[i])))).Re();
-									curr_state.eq[i] = ((~(complex(Pref/3.0, Qref_PI[i])/(pCircuit_V[i]))) - (~(complex(curr_state.P_Out[i],curr_state.Q_Out[i])/(pCircuit_V[i])))).Im();
+									PI_current_error(complex(Pref/3.0, Qref_PI[i]), complex(curr_state.P_Out[i],curr_state.Q_Out[i]), pCircuit_V[i], curr_state.ed[i], curr_state.eq[i]);
 								}
 								else
 								{
@@ -6126,13 +6124,13 @@ SIMULATIONMODE inverter::inter_deltaupdate(unsigned int64 delta_time, unsigned l
 					// PI controller variables
 					if ((phases & 0x10) == 0x10) {
 
-						pred_state.P_Out[0] = (*pCircuit_V * ~(I_Out[0])).Re();
-						pred_state.Q_Out[0] = (*pCircuit_V * ~(I_Out[0])).Im();
+						work_power_vals = *pCircuit_V * ~(I_Out[0]);
+						pred_state.P_Out[0] = work_power_vals.Re();
+						pred_state.Q_Out[0] = work_power_vals.Im();
 
 						if (pCircuit_V[0].Mag() > 0.0)
 						{
-							pred_state.ed[0] = ((~(complex(Pref, Qref_PI[0])/(*pCircuit_V))) - (~(complex(pred_state.P_Out[0],pred_state.Q_Out[0])/(*pCircuit_V)))).Re();
-							pred_state.eq[0] = ((~(complex(Pref, Qref_PI[0])/(*pCircuit_V))) - (~(complex(pred_state.P_Out[0],pred_state.Q_Out[0])/(*pCircuit_V)))).Im();
+							PI_current_error(complex(Pref, Qref_PI[0]), complex(pred_state.P_Out[0],pred_state.Q_Out[0]), *pCircuit_V, pred_state.ed[0], pred_state.eq[0]);
 						}
 						else
 						{
@@ -6168,8 +6166,9 @@ SIMULATIONMODE inverter::inter_deltaupdate(unsigned int64 delta_time, unsigned l
 						for ( i = 0 ; i < 3 ; i++ ) 
 						{
 
-							pred_state.P_Out[i] = (pCircuit_V[i] * ~(I_Out[i])).Re();
-							pred_state.Q_Out[i] = (pCircuit_V[i] * ~(I_Out[i])).Im();
+							work_power_vals = pCircuit_V[i] * ~(I_Out[i]);
+							pred_state.P_Out[i] = work_power_vals.Re();
+							pred_state.Q_Out[i] = work_power_vals.Im();
 
 							// if (Pref > 0) {
 							// 	int stop_temp = 0;
@@ -6177,8 +6176,7 @@ SIMULATIONMODE inverter::inter_deltaupdate(unsigned int64 delta_time, unsigned l
 
 							if (pCircuit_V[i].Mag() > 0.0)
 							{
-								pred_state.ed[i] = ((~(complex(Pref/3.0, Qref_PI[i])/(pCircuit_V[i]))) - (~(complex(pred_state.P_Out[i],pred_state.Q_Out[i])/(pCircuit_V[i])))).Re();
-								pred_state.eq[i] = ((~(complex(Pref/3.0, Qref_PI[i])/(pCircuit_V[i]))) - (~(complex(pred_state.P_Out[i],pred_state.Q_Out[i])/(pCircuit_V[i])))).Im();
+								PI_current_error(complex(Pref/3.0, Qref_PI[i]), complex(pred_state.P_Out[i],pred_state.Q_Out[i]), pCircuit_V[i], pred_state.ed[i], pred_state.eq[i]);
 							}
 							else
 							{
@@ -6332,8 +6330,7 @@ SIMULATIONMODE inverter::inter_deltaupdate(unsigned int64 delta_time, unsigned l
 						curr_state.Q_Out[0] = VA_Out.Im();
 						if (pCircuit_V[0].Mag() > 0.0)
 						{
-							curr_state.ed[0] = ((~(complex(Pref, Qref_PI[0])/(*pCircuit_V))) - (~(complex(curr_state.P_Out[0],curr_state.Q_Out[0])/(*pCircuit_V)))).Re();
-							curr_state.eq[0] = ((~(complex(Pref, Qref_PI[0])/(*pCircuit_V))) - (~(complex(curr_state.P_Out[0],curr_state.Q_Out[0])/(*pCircuit_V)))).Im();
+							PI_current_error(complex(Pref, Qref_PI[0]), complex(curr_state.P_Out[0],curr_state.Q_Out[0]), *pCircuit_V, curr_state.ed[0], curr_state.eq[0]);
 						}
 						else
 						{
@@ -6361,16 +6358,16 @@ SIMULATIONMODE inverter::inter_deltaupdate(unsigned int64 delta_time, unsigned l
 //							curr_VA_out[i] = (pCircuit_V[i] * ~(I_Out[i]));
 
 //							curr_state.P_Out[i] = VA_Out.Re() / 3.0;
-							curr_state.P_Out[i] = (pCircuit_V[i] * ~(I_Out[i])).Re();
-							curr_state.Q_Out[i] = (pCircuit_V[i] * ~(I_Out[i])).Im();
+							work_power_vals = pCircuit_V[i] * ~(I_Out[i]);
+							curr_state.P_Out[i] = work_power_vals.Re();
+							curr_state.Q_Out[i] = work_power_vals.Im();
 //							curr_state.Q_Out[i] = VA_Out.Im() / 3.0;
 							prev_error_ed = curr_state.ed[i];
 							prev_error_eq = curr_state.eq[i];
 
 							if (pCircuit_V[i].Mag() > 0.0)
 							{
-								curr_state.ed[i] = ((~(complex(Pref/3.0, Qref_PI[i])/(pCircuit_V[i]))) - (~(complex(curr_state.P_Out[i],curr_state.Q_Out[i])/(pCircuit_V[i])))).Re();
-								curr_state.eq[i] = ((~(complex(Pref/3.0, Qref_PI[i])/(pCircuit_V[i]))) - (~(complex(curr_state.P_Out[i],curr_state.Q_Out[i])/(pCircuit_V[i])))).Im();
+								PI_current_error(complex(Pref/3.0, Qref_PI[i]), complex(curr_state.P_Out[i],curr_state.Q_Out[i]), pCircuit_V[i], curr_state.ed[i], curr_state.eq[i]);
 							}
 							else
 							{
@@ -7826,6 +7823,17 @@ double inverter::perform_1547_checks(double timestepvalue)
 	}
 }
 
+//PI controller current error for one phase - reference less present output current, as d and q parts
+//Computed once per phase so the two conjugate divisions are shared by both parts
+void inverter::PI_current_error(complex Sref, complex Sout, complex Vterm, double &ed, double &eq)
+{
+	complex error_val;
+
+	error_val = (~(Sref/Vterm)) - (~(Sout/Vterm));
+	ed = error_val.Re();
+	eq = error_val.Im();
+}
+
 //Function to perform exp(j*val)
 //Basically a complex rotation
 complex inverter::complex_exp(double angle)
@@ -453,6 +453,7 @@ public:
 	complex *get_complex(OBJECT *obj, const char *name);
 	double *get_double(OBJECT *obj, const char *name);
 	complex complex_exp(double angle);
+	void PI_current_error(complex Sref, complex Sout, complex Vterm, double &ed, double &eq);
 	STATUS init_PI_dynamics(INV_STATE *curr_time);
 	STATUS init_PID_dynamics(void);
 #ifdef OPTIONAL
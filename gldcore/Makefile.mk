@@ -4,6 +4,7 @@ dist_pkgdata_DATA += gldcore/gridlabd.cnf
 
 GLD_SOURCES_PLACE_HOLDER = 
 GLD_SOURCES_PLACE_HOLDER += gldcore/aggregate.cpp gldcore/aggregate.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/benchmark.cpp gldcore/benchmark.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/class.cpp gldcore/class.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/cmdarg.cpp gldcore/cmdarg.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/compare.cpp gldcore/compare.h
@@ -49,12 +50,14 @@ GLD_SOURCES_PLACE_HOLDER += gldcore/matlab.cpp gldcore/matlab.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/module.cpp gldcore/module.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/object.cpp gldcore/object.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/output.cpp gldcore/output.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/perfcounter.cpp gldcore/perfcounter.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/platform.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/property.cpp gldcore/property.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/random.cpp gldcore/random.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/realtime.cpp gldcore/realtime.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/sanitize.cpp gldcore/sanitize.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/save.cpp gldcore/save.h
+GLD_SOURCES_PLACE_HOLDER += gldcore/scenario.cpp gldcore/scenario.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/schedule.cpp gldcore/schedule.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/server.cpp gldcore/server.h
 GLD_SOURCES_PLACE_HOLDER += gldcore/setup.cpp gldcore/setup.h
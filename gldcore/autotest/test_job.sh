@@ -0,0 +1,36 @@
+#!/bin/bash
+# Runs --job on two small models, one with a comma in its name, and checks the
+# summary rows, memory admission, processor affinity and resume.  The binary under test is
+# passed as the first argument.
+gridlabd=${1:-gridlabd}
+rm -rf job && mkdir job || exit 1
+for name in a b,c ; do
+	cat > "job/$name.glm" <<-END
+	clock {
+		starttime '2000-01-01 00:00:00';
+		stoptime '2000-01-01 01:00:00';
+	}
+	class test {
+		double x;
+	}
+	object test {
+		x 1;
+	}
+	#system grep Cpus_allowed_list /proc/self/status > affinity_$name.txt
+	END
+done
+
+# a huge job_memory admits one job at a time, and each slot is pinned to one processor
+"$gridlabd" -W job --threadcount 2 -D job_affinity=cpu -D job_memory=1000000 --job || exit 1
+[ $(grep -c ',0,' job/gridlabd-job.csv) -eq 2 ] || { echo "job summary does not have two successful rows"; exit 1; }
+grep -q '/b,c.glm,' job/gridlabd-job.csv || { echo "job summary is missing b,c.glm"; exit 1; }
+if [ -f /proc/self/status ]; then
+	for name in a b,c ; do
+		grep -qE 'Cpus_allowed_list:[[:space:]]+[0-9]+$' "job/affinity_$name.txt" || { echo "$name.glm was not pinned to one processor"; exit 1; }
+	done
+fi
+
+# resuming must not rerun either model
+"$gridlabd" -W job --threadcount 2 -D job_resume=1 --job || exit 1
+[ $(grep -c ',0,' job/gridlabd-job.csv) -eq 2 ] || { echo "resumed job reran completed models"; exit 1; }
+exit 0
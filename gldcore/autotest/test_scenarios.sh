@@ -0,0 +1,13 @@
+#!/bin/bash
+# Runs test_scenarios.glm with its scenario file, then checks the sensor noise each scenario
+# recorded: scenarios with the same seed must draw the same noise and scenarios with
+# different seeds different noise, whatever the seeds are.  The binary under test is passed
+# as the first argument.
+gridlabd=${1:-gridlabd}
+"$gridlabd" -D SCENARIOS=1 ../test_scenarios.glm || exit 1
+for name in low repeat high ; do
+	[ $(grep -vc '^#' $name/sensor.csv) -gt 1 ] || { echo "scenario $name recorded no sensor measurements"; exit 1; }
+done
+cmp -s <(grep -v '^#' low/sensor.csv) <(grep -v '^#' repeat/sensor.csv) || { echo "scenarios with the same seed recorded different noise"; exit 1; }
+cmp -s <(grep -v '^#' low/sensor.csv) <(grep -v '^#' high/sensor.csv) && { echo "scenarios with different seeds recorded the same noise"; exit 1; }
+exit 0
@@ -0,0 +1,576 @@
+// $Id$
+// Copyright (C) 2012 Battelle Memorial Institute
+//
+// Benchmark suite.  Synthetic models of increasing size are generated for each
+// benchmark case, run in a separate gridlabd process at each requested thread
+// count, and their throughput, NR solver time and memory high-water mark are
+// written to a JSON results file.  When a baseline results file is given, each
+// run is compared against it and regressions beyond the tolerance are reported.
+//
+// Usage: gridlabd --benchmark [cases=feeder,houses,players,recorders]
+//                             [sizes=1000,10000,...] [threads=1,2,...]
+//                             [hours=<n>] [output=<file>] [baseline=<file>]
+//                             [tolerance=<percent>] [keep]
+//
+
+#ifdef WIN32
+#include <windows.h>
+#include <direct.h>
+#define mkdir(X,Y) _mkdir(X)
+#define rmdir _rmdir
+#else
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "globals.h"
+#include "output.h"
+#include "benchmark.h"
+#include "exec.h"
+
+SET_MYCONTEXT(DMC_BENCHMARK)
+
+#define MAXRUNS 256
+
+/** benchmark case names, in the order of the BENCHMARKCASE bits */
+static const char *case_name[] = {"feeder","houses","players","recorders"};
+#define N_CASES (sizeof(case_name)/sizeof(case_name[0]))
+
+/** benchmark options */
+static set bench_cases = BC_DEFAULT;
+static unsigned int bench_sizes[16] = {1000,10000};
+static size_t n_sizes = 2;
+static unsigned int bench_threads[16] = {1};
+static size_t n_threads = 1;
+static unsigned int bench_hours = 4;
+static char bench_output[1024] = "benchmark.json";
+static char bench_baseline[1024] = "";
+static double bench_tolerance = 10.0;
+static bool bench_keep = false;
+
+/** result of a single benchmark run */
+typedef struct s_benchresult {
+	char name[64];				///< case name
+	unsigned int size;			///< requested model size
+	unsigned int threads;		///< thread count used
+	int exitcode;				///< exit code of the run
+	unsigned int objects;		///< objects reported by the run
+	unsigned int timesteps;		///< timesteps reported by the run
+	double wall_time;			///< elapsed wall time (s)
+	double rate;				///< objects*steps per second
+	double nr_time;				///< total NR solver time (s)
+	unsigned int nr_iterations;	///< total NR iterations
+	long maxrss;				///< memory high-water mark (kB)
+} BENCHRESULT;
+static BENCHRESULT result[MAXRUNS];
+static size_t n_results = 0;
+
+/** wall clock time in seconds */
+static double wall_clock(void)
+{
+#ifdef WIN32
+	return (double)GetTickCount()/1000.0;
+#else
+	struct timeval tv;
+	gettimeofday(&tv,NULL);
+	return (double)tv.tv_sec + (double)tv.tv_usec/1e6;
+#endif
+}
+
+/** parse a comma separated list of unsigned integers */
+static size_t parse_list(const char *value, unsigned int *list, size_t max)
+{
+	size_t n = 0;
+	char buffer[1024];
+	strncpy(buffer,value,sizeof(buffer)-1);
+	buffer[sizeof(buffer)-1] = '\0';
+	for ( char *next=NULL, *item=strtok_s(buffer,",",&next) ; item!=NULL && n<max ; item=strtok_s(NULL,",",&next) )
+	{
+		unsigned int x = (unsigned int)strtoul(item,NULL,10);
+		if ( x==0 )
+		{
+			output_error("benchmark list item '%s' is not a positive integer", item);
+			return 0;
+		}
+		list[n++] = x;
+	}
+	return n;
+}
+
+/** parse the benchmark options */
+static bool parse_options(int argc, const char *argv[])
+{
+	for ( int i = 1 ; i < argc ; i++ )
+	{
+		char name[64], value[1024];
+		if ( strcmp(argv[i],"keep")==0 )
+		{
+			bench_keep = true;
+			continue;
+		}
+		if ( sscanf(argv[i],"%63[^=]=%1023[^\n]",name,value)!=2 )
+		{
+			output_error("benchmark option '%s' is not valid", argv[i]);
+			return false;
+		}
+		if ( strcmp(name,"cases")==0 )
+		{
+			char *next=NULL;
+			bench_cases = BC_NONE;
+			for ( char *item=strtok_s(value,",",&next) ; item!=NULL ; item=strtok_s(NULL,",",&next) )
+			{
+				size_t n;
+				for ( n = 0 ; n < N_CASES ; n++ )
+				{
+					if ( strcmp(item,case_name[n])==0 )
+						break;
+				}
+				if ( n==N_CASES )
+				{
+					output_error("benchmark case '%s' is not known", item);
+					return false;
+				}
+				bench_cases |= (1<<n);
+			}
+		}
+		else if ( strcmp(name,"sizes")==0 )
+		{
+			if ( (n_sizes=parse_list(value,bench_sizes,sizeof(bench_sizes)/sizeof(bench_sizes[0])))==0 )
+				return false;
+		}
+		else if ( strcmp(name,"threads")==0 )
+		{
+			if ( (n_threads=parse_list(value,bench_threads,sizeof(bench_threads)/sizeof(bench_threads[0])))==0 )
+				return false;
+		}
+		else if ( strcmp(name,"hours")==0 )
+		{
+			if ( (bench_hours=(unsigned int)atoi(value))==0 || bench_hours>720 )
+			{
+				output_error("benchmark hours must be an integer from 1 to 720");
+				return false;
+			}
+		}
+		else if ( strcmp(name,"output")==0 )
+			strcpy(bench_output,value);
+		else if ( strcmp(name,"baseline")==0 )
+			strcpy(bench_baseline,value);
+		else if ( strcmp(name,"tolerance")==0 )
+			bench_tolerance = atof(value);
+		else
+		{
+			output_error("benchmark option '%s' is not known", name);
+			return false;
+		}
+	}
+	return true;
+}
+
+/** write the common clock directive */
+static void write_clock(FILE *fp)
+{
+	fprintf(fp,"clock {\n\ttimezone PST+8PDT;\n\tstarttime '2000-01-01 00:00:00';\n\tstoptime '2000-01-%02u %02u:00:00';\n}\n", 1+bench_hours/24, bench_hours%24);
+}
+
+/** radial feeder with a 4-ary tree of scheduled three-phase loads */
+static bool write_feeder(FILE *fp, unsigned int size)
+{
+	write_clock(fp);
+	fprintf(fp,"module powerflow {\n\tsolver_method NR;\n\tsolver_profile_enable true;\n}\n");
+	fprintf(fp,"schedule bench_shape {\n\t0-14 * * * * 0.8;\n\t15-29 * * * * 1.0;\n\t30-44 * * * * 1.2;\n\t45-59 * * * * 0.9;\n}\n");
+	fprintf(fp,"object line_configuration {\n\tname bench_lc;\n"
+		"\tz11 0.3465+1.0179j;\n\tz12 0.1560+0.5017j;\n\tz13 0.1580+0.4236j;\n"
+		"\tz21 0.1560+0.5017j;\n\tz22 0.3375+1.0478j;\n\tz23 0.1535+0.3849j;\n"
+		"\tz31 0.1580+0.4236j;\n\tz32 0.1535+0.3849j;\n\tz33 0.3414+1.0348j;\n}\n");
+	fprintf(fp,"object node {\n\tname n0;\n\tphases ABCN;\n\tbustype SWING;\n\tnominal_voltage 7200;\n}\n");
+	for ( unsigned int n = 1 ; n < size ; n++ )
+	{
+		fprintf(fp,"object load {\n\tname n%u;\n\tphases ABCN;\n\tnominal_voltage 7200;\n", n);
+		fprintf(fp,"\tbase_power_A bench_shape*%u;\n\tbase_power_B bench_shape*%u;\n\tbase_power_C bench_shape*%u;\n", 1500+n%5*100, 1500+n%7*100, 1500+n%3*100);
+		fprintf(fp,"\tpower_fraction_A 1;\n\tpower_fraction_B 1;\n\tpower_fraction_C 1;\n");
+		fprintf(fp,"\tpower_pf_A 0.95;\n\tpower_pf_B 0.95;\n\tpower_pf_C 0.95;\n}\n");
+		fprintf(fp,"object overhead_line {\n\tphases ABCN;\n\tfrom n%u;\n\tto n%u;\n\tlength 200;\n\tconfiguration bench_lc;\n}\n", (n-1)/4, n);
+	}
+	return true;
+}
+
+/** standalone houses with varied envelopes and setpoints sharing one climate */
+static bool write_houses(FILE *fp, unsigned int size)
+{
+	write_clock(fp);
+	fprintf(fp,"module climate;\nmodule residential {\n\timplicit_enduses NONE;\n}\n");
+	fprintf(fp,"object climate {\n\tname bench_weather;\n}\n");
+	for ( unsigned int n = 0 ; n < size ; n++ )
+	{
+		fprintf(fp,"object house {\n\tname h%u;\n\tfloor_area %u;\n\theating_setpoint %.1f;\n\tcooling_setpoint %.1f;\n}\n",
+			n, 1500+n%7*100, 68+n%5*0.5, 76+n%3*0.5);
+	}
+	return true;
+}
+
+/** loads on a swing bus, each driven by a player */
+static bool write_players(FILE *fp, unsigned int size)
+{
+	FILE *player = fopen("bench.player","w");
+	if ( player==NULL )
+	{
+		output_error("unable to create benchmark player file: %s", strerror(errno));
+		return false;
+	}
+	for ( unsigned int h = 0 ; h <= bench_hours ; h++ )
+	{
+		for ( unsigned int m = 0 ; m < 60 ; m += 5 )
+			fprintf(player,"2000-01-%02u %02u:%02u:00,%u+%uj\n", 1+h/24, h%24, m, 1000+(h*60+m)%300, 100+m);
+	}
+	fclose(player);
+	write_clock(fp);
+	fprintf(fp,"module powerflow;\nmodule tape;\n");
+	fprintf(fp,"object node {\n\tname n0;\n\tphases ABCN;\n\tbustype SWING;\n\tnominal_voltage 7200;\n}\n");
+	for ( unsigned int n = 1 ; n < size ; n++ )
+	{
+		fprintf(fp,"object load {\n\tname n%u;\n\tparent n0;\n\tphases ABCN;\n\tnominal_voltage 7200;\n", n);
+		fprintf(fp,"\tobject player {\n\t\tproperty constant_power_A;\n\t\tfile bench.player;\n\t};\n}\n");
+	}
+	return true;
+}
+
+/** loads on a swing bus, each sampled by a recorder */
+static bool write_recorders(FILE *fp, unsigned int size)
+{
+#ifndef WIN32
+	struct rlimit limit;
+	if ( getrlimit(RLIMIT_NOFILE,&limit)==0 && limit.rlim_cur!=RLIM_INFINITY && (rlim_t)size+64>limit.rlim_cur )
+	{
+		output_warning("benchmark recorders size %u exceeds the open file limit %u", size, (unsigned int)limit.rlim_cur);
+		return false;
+	}
+#endif
+	write_clock(fp);
+	fprintf(fp,"module powerflow;\nmodule tape;\n");
+	fprintf(fp,"object node {\n\tname n0;\n\tphases ABCN;\n\tbustype SWING;\n\tnominal_voltage 7200;\n}\n");
+	for ( unsigned int n = 1 ; n < size ; n++ )
+	{
+		fprintf(fp,"object load {\n\tname n%u;\n\tparent n0;\n\tphases ABCN;\n\tnominal_voltage 7200;\n\tconstant_power_A %u+100j;\n", n, 1000+n%300);
+		fprintf(fp,"\tobject recorder {\n\t\tproperty voltage_A,constant_power_A;\n\t\tfile n%u.csv;\n\t\tinterval 60;\n\t};\n}\n", n);
+	}
+	return true;
+}
+
+typedef bool (*GENERATOR)(FILE*,unsigned int);
+static GENERATOR generator[] = {write_feeder, write_houses, write_players, write_recorders};
+
+/** read the objects and timestep counts from the run's profile output */
+static void read_profile(const char *dir, BENCHRESULT *res)
+{
+	char fname[1024];
+	if ( snprintf(fname,sizeof(fname),"%s/gridlabd.pro",dir)>=(int)sizeof(fname) )
+	{
+		output_warning("benchmark run folder '%s' is too long to read its profile", dir);
+		return;
+	}
+	FILE *fp = fopen(fname,"r");
+	if ( fp==NULL )
+	{
+		output_warning("benchmark run '%s' produced no profile", dir);
+		return;
+	}
+	char line[1024];
+	while ( fgets(line,sizeof(line),fp)!=NULL )
+	{
+		sscanf(line,"Total objects %u",&res->objects);
+		sscanf(line,"Time steps completed %u",&res->timesteps);
+	}
+	fclose(fp);
+}
+
+/** read the total NR solution time and iterations from the solver profile */
+static void read_solver_profile(const char *dir, BENCHRESULT *res)
+{
+	char fname[1024];
+	if ( snprintf(fname,sizeof(fname),"%s/solver_nr_profile.csv",dir)>=(int)sizeof(fname) )
+	{
+		output_warning("benchmark run folder '%s' is too long to read its solver profile", dir);
+		return;
+	}
+	FILE *fp = fopen(fname,"r");
+	if ( fp==NULL )
+		return; // not a powerflow NR model
+	char line[1024];
+	while ( fgets(line,sizeof(line),fp)!=NULL )
+	{
+		double duration;
+		unsigned int iterations;
+		char *p = strchr(line,',');
+		if ( p!=NULL && sscanf(p,",%lf,%u",&duration,&iterations)==2 )
+		{
+			res->nr_time += duration/1e6;
+			res->nr_iterations += iterations;
+		}
+	}
+	fclose(fp);
+}
+
+/** run the model in a child gridlabd and collect its exit code and resource usage */
+static int run_model(const char *dir, unsigned int threads, long *maxrss)
+{
+	char threadcount[32];
+	sprintf(threadcount,"%u",threads);
+	*maxrss = 0;
+#ifdef WIN32
+	char command[2048];
+	sprintf(command,"%s -W %s --threadcount %s --profile --redirect all model.glm", _pgmptr, dir, threadcount);
+	IN_MYCONTEXT output_debug("calling system('%s')",command);
+	return system(command);
+#else
+	// run this binary rather than whichever gridlabd is first on the path
+	const char *args[] = {global_execname,"-W",dir,"--threadcount",threadcount,"--profile","--redirect","all","model.glm",NULL};
+	pid_t pid = fork();
+	if ( pid<0 )
+	{
+		output_error("unable to start benchmark run in '%s': %s", dir, strerror(errno));
+		return -1;
+	}
+	if ( pid==0 )
+	{
+#ifdef __linux__
+		execv("/proc/self/exe",(char*const*)args);
+#endif
+		if ( strchr(global_execname,'/')!=NULL )
+			execv(global_execname,(char*const*)args);
+		else
+			execvp(global_execname,(char*const*)args);
+		_exit(XC_SHFAILED);
+	}
+	int status;
+	struct rusage usage;
+	if ( wait4(pid,&status,0,&usage)<0 )
+	{
+		output_error("unable to wait for benchmark run in '%s': %s", dir, strerror(errno));
+		return -1;
+	}
+	*maxrss = usage.ru_maxrss;
+#ifdef __APPLE__
+	*maxrss /= 1024; // darwin reports bytes
+#endif
+	return WIFEXITED(status) ? WEXITSTATUS(status) : 128+WTERMSIG(status);
+#endif
+}
+
+/** generate and run one benchmark case */
+static bool run_case(size_t id, unsigned int size, unsigned int threads, BENCHRESULT *res)
+{
+	memset(res,0,sizeof(BENCHRESULT));
+	strcpy(res->name,case_name[id]);
+	res->size = size;
+	res->threads = threads;
+
+	char dir[1024];
+	sprintf(dir,"benchmark/%s-%u",case_name[id],size);
+	mkdir("benchmark",0750);
+	mkdir(dir,0750);
+
+	char cwd[1024];
+	if ( getcwd(cwd,sizeof(cwd))==NULL || chdir(dir)!=0 )
+	{
+		output_error("unable to access benchmark folder '%s'", dir);
+		return false;
+	}
+	FILE *fp = fopen("model.glm","w");
+	bool ok = fp!=NULL && generator[id](fp,size);
+	if ( fp!=NULL )
+		fclose(fp);
+	if ( chdir(cwd)!=0 || !ok )
+	{
+		output_error("unable to generate benchmark model '%s'", dir);
+		return false;
+	}
+
+	output_raw("Running %s (size %u, %u thread%s)...\r", case_name[id], size, threads, threads>1?"s":"");
+	double t = wall_clock();
+	res->exitcode = run_model(dir,threads,&res->maxrss);
+	res->wall_time = wall_clock() - t;
+	if ( res->exitcode!=XC_SUCCESS )
+	{
+		output_error("benchmark %s (size %u, %u threads) failed with exit code %d", case_name[id], size, threads, res->exitcode);
+		return false;
+	}
+	read_profile(dir,res);
+	read_solver_profile(dir,res);
+	res->rate = res->wall_time>0 ? (double)res->objects*(double)res->timesteps/res->wall_time : 0;
+
+	if ( !bench_keep )
+	{
+		char command[1100];
+		sprintf(command,
+#ifdef WIN32
+			"rmdir /s /q \"%s\"",
+#else
+			"rm -rf '%s'",
+#endif
+			dir);
+		if ( system(command)!=0 )
+			output_warning("unable to remove benchmark folder '%s'", dir);
+	}
+	return true;
+}
+
+/** write the results file, one run per line so it can be read back as a baseline */
+static bool write_results(const char *fname)
+{
+	FILE *fp = fopen(fname,"w");
+	if ( fp==NULL )
+	{
+		output_error("unable to write benchmark results to '%s': %s", fname, strerror(errno));
+		return false;
+	}
+	fprintf(fp,"{\n\t\"application\" : \"gridlabd\",\n");
+	fprintf(fp,"\t\"version\" : \"%d.%d.%d-%d\",\n", global_version_major, global_version_minor, global_version_patch, global_version_build);
+	fprintf(fp,"\t\"platform\" : \"%d-bit %s\",\n", (int)sizeof(void*)*8, global_platform);
+	fprintf(fp,"\t\"hours\" : %u,\n", bench_hours);
+	fprintf(fp,"\t\"results\" : [\n");
+	for ( size_t n = 0 ; n < n_results ; n++ )
+	{
+		BENCHRESULT *res = &result[n];
+		fprintf(fp,"\t\t{\"case\" : \"%s\", \"size\" : %u, \"threads\" : %u, \"exitcode\" : %d, "
+			"\"objects\" : %u, \"timesteps\" : %u, \"wall_time\" : %.3f, \"object_steps_per_second\" : %.1f, "
+			"\"nr_solve_time\" : %.6f, \"nr_iterations\" : %u, \"memory_highwater\" : %ld}%s\n",
+			res->name, res->size, res->threads, res->exitcode,
+			res->objects, res->timesteps, res->wall_time, res->rate,
+			res->nr_time, res->nr_iterations, res->maxrss, n+1<n_results?",":"");
+	}
+	fprintf(fp,"\t]\n}\n");
+	fclose(fp);
+	return true;
+}
+
+/** find a numeric or string field in a results line */
+static bool get_field(const char *line, const char *name, char *value, size_t len)
+{
+	char tag[64];
+	sprintf(tag,"\"%s\" : ",name);
+	const char *p = strstr(line,tag);
+	if ( p==NULL )
+		return false;
+	p += strlen(tag);
+	if ( *p=='"' ) p++;
+	size_t n = strcspn(p,"\",}");
+	if ( n>=len ) n = len-1;
+	strncpy(value,p,n);
+	value[n] = '\0';
+	return true;
+}
+
+/** compare the results with the baseline, returns number of regressions */
+static int compare_baseline(const char *fname)
+{
+	FILE *fp = fopen(fname,"r");
+	if ( fp==NULL )
+	{
+		output_error("unable to read benchmark baseline '%s': %s", fname, strerror(errno));
+		return -1;
+	}
+	int regressions = 0;
+	output_message("\nBenchmark comparison with baseline '%s' (tolerance %.1f%%)", fname, bench_tolerance);
+	output_message("Case       Size      Threads   Rate change  NR time change  Memory change");
+	output_message("---------- --------- --------- ------------ --------------- -------------");
+	char line[1024];
+	while ( fgets(line,sizeof(line),fp)!=NULL )
+	{
+		char name[64], size[32], threads[32], rate[32], nr_time[32], memory[32];
+		if ( !get_field(line,"case",name,sizeof(name))
+			|| !get_field(line,"size",size,sizeof(size))
+			|| !get_field(line,"threads",threads,sizeof(threads))
+			|| !get_field(line,"object_steps_per_second",rate,sizeof(rate))
+			|| !get_field(line,"nr_solve_time",nr_time,sizeof(nr_time))
+			|| !get_field(line,"memory_highwater",memory,sizeof(memory)) )
+			continue;
+		for ( size_t n = 0 ; n < n_results ; n++ )
+		{
+			BENCHRESULT *res = &result[n];
+			if ( strcmp(res->name,name)!=0 || res->size!=(unsigned int)atoi(size) || res->threads!=(unsigned int)atoi(threads) || res->exitcode!=XC_SUCCESS )
+				continue;
+			double base_rate = atof(rate), base_nr = atof(nr_time), base_mem = atof(memory);
+			double d_rate = base_rate>0 ? (res->rate/base_rate-1)*100 : 0;
+			double d_nr = base_nr>0 ? (res->nr_time/base_nr-1)*100 : 0;
+			double d_mem = base_mem>0 ? ((double)res->maxrss/base_mem-1)*100 : 0;
+			bool regressed = d_rate < -bench_tolerance || d_nr > bench_tolerance || d_mem > bench_tolerance;
+			output_message("%-10s %9u %9u %+11.1f%% %+14.1f%% %+12.1f%%%s", res->name, res->size, res->threads, d_rate, d_nr, d_mem, regressed?"  REGRESSION":"");
+			if ( regressed )
+				regressions++;
+		}
+	}
+	fclose(fp);
+	return regressions;
+}
+
+/** main benchmark routine */
+int benchmark(void *main, int argc, const char *argv[])
+{
+	if ( !parse_options(argc,argv) )
+		exit(XC_ARGERR);
+	global_suppress_repeat_messages = 0;
+	output_message("Starting benchmark in directory '%s'", global_workdir);
+
+	int failures = 0;
+	for ( size_t id = 0 ; id < N_CASES ; id++ )
+	{
+		if ( (bench_cases&(1<<id))==0 )
+			continue;
+		for ( size_t s = 0 ; s < n_sizes ; s++ )
+		{
+			for ( size_t t = 0 ; t < n_threads ; t++ )
+			{
+				if ( n_results==MAXRUNS )
+				{
+					output_warning("benchmark run limit of %d reached", MAXRUNS);
+					break;
+				}
+				if ( !run_case(id,bench_sizes[s],bench_threads[t],&result[n_results]) )
+					failures++;
+				n_results++;
+			}
+		}
+	}
+
+	if ( !bench_keep )
+		rmdir("benchmark");
+
+	output_message("\nBenchmark results");
+	output_message("Case       Size      Threads   Objects   Steps    Wall (s)  kObj.steps/s  NR (s)   NR iter  Memory (MB)");
+	output_message("---------- --------- --------- --------- -------- --------- ------------- -------- -------- -----------");
+	for ( size_t n = 0 ; n < n_results ; n++ )
+	{
+		BENCHRESULT *res = &result[n];
+		if ( res->exitcode!=XC_SUCCESS )
+			output_message("%-10s %9u %9u (failed with exit code %d)", res->name, res->size, res->threads, res->exitcode);
+		else
+			output_message("%-10s %9u %9u %9u %8u %9.2f %13.1f %8.3f %8u %11.1f", res->name, res->size, res->threads,
+				res->objects, res->timesteps, res->wall_time, res->rate/1000, res->nr_time, res->nr_iterations, res->maxrss/1024.0);
+	}
+	if ( !write_results(bench_output) )
+		failures++;
+	else
+		output_message("\nBenchmark results saved to '%s'", bench_output);
+
+	if ( strcmp(bench_baseline,"")!=0 )
+	{
+		int regressions = compare_baseline(bench_baseline);
+		if ( regressions<0 )
+			failures++;
+		else if ( regressions>0 )
+		{
+			output_error("%d benchmark regression%s found", regressions, regressions>1?"s":"");
+			failures += regressions;
+		}
+	}
+
+	exit(failures==0 ? XC_SUCCESS : XC_TSTERR);
+}
@@ -0,0 +1,22 @@
+/* $Id$
+   Copyright (C) 2012 Battelle Memorial Institute
+ */
+
+#ifndef _BENCHMARK_H
+#define _BENCHMARK_H
+
+#include "platform.h"
+
+typedef enum {
+	BC_NONE		= 0x0000,	///< no benchmark cases
+	BC_FEEDER	= 0x0001,	///< radial NR feeder with scheduled loads
+	BC_HOUSES	= 0x0002,	///< standalone houses sharing one climate
+	BC_PLAYERS	= 0x0004,	///< loads driven by players
+	BC_RECORDERS= 0x0008,	///< loads sampled by recorders
+	BC_ALL		= 0x000f,	///< all benchmark cases
+	BC_DEFAULT	= BC_ALL,	///< default benchmark cases
+} BENCHMARKCASE;
+
+int benchmark(void *main, int argc, const char *argv[]);
+
+#endif
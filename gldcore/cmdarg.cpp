@@ -442,6 +442,16 @@ int GldCmdarg::mt_profile(int argc, const char *argv[])
 	}
 }
 
+DEPRECATED static int perfcounters(void *main, int argc, const char *argv[])
+{
+	return ((GldMain*)main)->get_cmdarg()->perfcounters(argc,argv);
+}
+int GldCmdarg::perfcounters(int argc, const char *argv[])
+{
+	global_perfcounters = !global_perfcounters;
+	return 0;
+}
+
 DEPRECATED static int pauseatexit(void *main, int argc, const char *argv[])
 {
 	return ((GldMain*)main)->get_cmdarg()->pauseatexit(argc,argv);
@@ -1169,6 +1179,27 @@ int GldCmdarg::threadcount(int argc, const char *argv[])
 	return 1;
 }
 
+DEPRECATED static int scenarios(void *main, int argc, const char *argv[])
+{
+	return ((GldMain*)main)->get_cmdarg()->scenarios(argc,argv);
+}
+int GldCmdarg::scenarios(int argc, const char *argv[])
+{
+	if ( argc>1 )
+		strncpy(global_scenario_file,(argc--,*++argv),sizeof(global_scenario_file)-1);
+	else
+	{
+		output_fatal("missing scenario file name");
+		/*	TROUBLESHOOT
+			The <b>--scenarios</b> command line directive
+			was not followed by the name of a scenario file.  The correct syntax is
+			<b>--scenarios <i>filename</i></b>.
+		 */
+		return CMDERR;
+	}
+	return 1;
+}
+
 DEPRECATED static int output(void *main, int argc, const char *argv[])
 {
 	return ((GldMain*)main)->get_cmdarg()->output(argc,argv);
@@ -1765,6 +1796,7 @@ int GldCmdarg::origin(int argc, const char *argv[])
 
 #include "job.h"
 #include "validate.h"
+#include "benchmark.h"
 
 /*********************************************/
 /* ADD NEW CMDARG PROCESSORS ABOVE THIS HERE */
@@ -1783,6 +1815,7 @@ DEPRECATED static CMDARG main_commands[] = {
 	{"debugger",	NULL,	debugger,		NULL, "Enables the debugger" },
 	{"dumpall",		NULL,	dumpall,		NULL, "Dumps the global variable list" },
 	{"mt_profile",	NULL,	mt_profile,		"<n-threads>", "Analyses multithreaded performance profile" },
+	{"perfcounters",NULL,	perfcounters,	NULL, "Toggles collection of hardware performance counters by class and pass" },
 	{"profile",		NULL,	profile,		NULL, "Toggles performance profiling of core and modules while simulation runs" },
 	{"quiet",		"q",	quiet,			NULL, "Toggles suppression of all but error and fatal messages" },
 	{"verbose",		"v",	verbose,		NULL, "Toggles output of verbose messages" },
@@ -1816,6 +1849,7 @@ DEPRECATED static CMDARG main_commands[] = {
 	{"testall",		NULL,	testall,		"=<filename>", "Perform tests of modules listed in file" },
 	{"unitstest",	NULL,	unitstest,		NULL, "Perform unit conversion system test" },
 	{"validate",	NULL,	validate,		"...", "Perform model validation check" },
+	{"benchmark",	NULL,	benchmark,		"...", "Run the synthetic model benchmark suite" },
 
 	{NULL,NULL,NULL,NULL, "File and I/O Formatting"},
 	{"kml",			NULL,	kml,			"[=<filename>]", "Output to KML (Google Earth) file of model (only supported by some modules)" },
@@ -1838,6 +1872,7 @@ DEPRECATED static CMDARG main_commands[] = {
 	{"pidfile",		NULL,	pidfile,		"[=<filename>]", "Set the process ID file (default is gridlabd.pid)" },
 	{"threadcount", "T",	threadcount,	"<n>", "Set the maximum number of threads allowed" },
 	{"job",			NULL,	job,			"...", "Start a job"},
+	{"scenarios",	NULL,	scenarios,		"<file>", "Fork the scenarios in <file> from the initialized model" },
 
 	{NULL,NULL,NULL,NULL, "System options"},
 	{"avlbalance",	NULL,	avlbalance,		NULL, "Toggles automatic balancing of object index" },
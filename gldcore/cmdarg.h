@@ -67,6 +67,7 @@ public:
 	int _check_version(int argc, const char *argv[]);
 	int profile(int argc, const char *argv[]);
 	int mt_profile(int argc, const char *argv[]);
+	int perfcounters(int argc, const char *argv[]);
 	int pauseatexit(int argc, const char *argv[]);
 	int compile(int argc, const char *argv[]);
 	int license(int argc, const char *argv[]);
@@ -95,6 +96,7 @@ public:
 	int redirect(int argc, const char *argv[]);
 	int libinfo(int argc, const char *argv[]);
 	int threadcount(int argc, const char *argv[]);
+	int scenarios(int argc, const char *argv[]);
 	int output(int argc, const char *argv[]);
 	int environment(int argc, const char *argv[]);
 	int xmlencoding(int argc, const char *argv[]);
@@ -30,7 +30,9 @@ typedef enum {I='i',J='j',A='d', R='r'} CNOTATION; /**< complex number notation
 #ifndef __cplusplus
 typedef struct s_complex {
 #else
+class dcomplex;
 class complex { 
+	friend class dcomplex;
 private:
 #endif
 	double r; /**< the real part */
@@ -93,6 +95,7 @@ public:
 		f = CNOTATION_DEFAULT;
 		return *this;
 	};
+	inline complex &operator = (const dcomplex &x); /**< dcomplex assignment, keeps the notation */
 
 	/* access operations */
 	inline double & Re(void) /**< access to real part */
@@ -360,6 +363,177 @@ public:
 };
 #endif
 
+/** The dcomplex value is the compact form used for computation.  It holds only the real and
+	imaginary parts, so it is 16 bytes and has the same layout as \p std::complex<double> and
+	as the leading part of \p complex.  The notation is not stored; it only matters when a
+	value is converted to or from a string, which is done through \p complex properties.
+	Arrays of dcomplex values are what powerflow solvers and other inner loops should use.
+ **/
+#ifndef __cplusplus
+typedef struct s_dcomplex {
+	double r; /**< the real part */
+	double i; /**< the imaginary part */
+} dcomplex;
+#else
+class dcomplex {
+	friend class complex;
+private:
+	double r; /**< the real part */
+	double i; /**< the imaginary part */
+public:
+	inline dcomplex() : r(0), i(0) {}; /**< create a zero complex number */
+	inline dcomplex(double re) : r(re), i(0) {}; /**< create a complex number with only a real part */
+	inline dcomplex(double re, double im) : r(re), i(im) {}; /**< create a complex number with both real and imaginary parts */
+	inline dcomplex(const complex &x) : r(x.r), i(x.i) {}; /**< copy the value of a complex number, dropping its notation */
+	inline operator complex(void) const /**< convert to a complex number in the default notation */
+	{
+		return complex(r,i);
+	};
+
+	/* assignment operations */
+	inline dcomplex &operator = (double x) /**< double assignment */
+	{
+		r = x;
+		i = 0;
+		return *this;
+	};
+
+	/* access operations */
+	inline double & Re(void) { return r; }; /**< access to real part */
+	inline double Re(void) const { return r; };
+	inline double & Im(void) { return i; }; /**< access to imaginary part */
+	inline double Im(void) const { return i; };
+	inline double Mag(void) const /**< compute magnitude */
+	{
+		return sqrt(r*r+i*i);
+	};
+	inline double Arg(void) const /**< compute angle */
+	{
+		if (r==0)
+		{
+			if (i>0)
+				return PI/2;
+			else if (i==0)
+				return 0;
+			else
+				return -PI/2;
+		}
+		else if (r>0)
+			return atan(i/r);
+		else
+			return PI+atan(i/r);
+	};
+	inline double Ang(void) const
+	{
+		return Arg()*180.0/PI;
+	};
+	inline void SetRect(double rp, double ip) /**< set rectangular value */
+	{
+		r = rp;
+		i = ip;
+	};
+	inline void SetPolar(double m, double a) /**< set polar values */
+	{
+		r = (m*cos(a));
+		i = (m*sin(a));
+	};
+
+	inline dcomplex operator - (void) const /**< change sign */
+	{
+		return dcomplex(-r,-i);
+	};
+	inline dcomplex operator ~ (void) const /**< complex conjugate */
+	{
+		return dcomplex(r,-i);
+	};
+
+	/* reflexive math operations */
+	inline dcomplex &operator += (double x) /**< add a double to the real part */
+	{
+		r += x;
+		return *this;
+	};
+	inline dcomplex &operator -= (double x) /**< subtract a double from the real part */
+	{
+		r -= x;
+		return *this;
+	};
+	inline dcomplex &operator *= (double x) /**< multiply by a double */
+	{
+		r *= x;
+		i *= x;
+		return *this;
+	};
+	inline dcomplex &operator /= (double x) /**< divide by a double */
+	{
+		r /= x;
+		i /= x;
+		return *this;
+	};
+	inline dcomplex &operator += (dcomplex x) /**< add a complex number */
+	{
+		r += x.r;
+		i += x.i;
+		return *this;
+	};
+	inline dcomplex &operator -= (dcomplex x) /**< subtract a complex number */
+	{
+		r -= x.r;
+		i -= x.i;
+		return *this;
+	};
+	inline dcomplex &operator *= (dcomplex x) /**< multiply by a complex number */
+	{
+		double pr=r;
+		r = pr * x.r - i * x.i;
+		i = pr * x.i + i * x.r;
+		return *this;
+	};
+	inline dcomplex &operator /= (dcomplex y) /**< divide by a complex number */
+	{
+		double xr=r;
+		double a = y.r*y.r+y.i*y.i;
+		r = (xr*y.r+i*y.i)/a;
+		i = (i*y.r-xr*y.i)/a;
+		return *this;
+	};
+
+	/* binary math operations */
+	inline dcomplex operator + (double y) const { dcomplex x(*this); return x+=y; }; /**< double sum */
+	inline dcomplex operator - (double y) const { dcomplex x(*this); return x-=y; }; /**< double subtract */
+	inline dcomplex operator * (double y) const { dcomplex x(*this); return x*=y; }; /**< double multiply */
+	inline dcomplex operator / (double y) const { dcomplex x(*this); return x/=y; }; /**< double divide */
+	inline dcomplex operator + (dcomplex y) const { dcomplex x(*this); return x+=y; }; /**< complex sum */
+	inline dcomplex operator - (dcomplex y) const { dcomplex x(*this); return x-=y; }; /**< complex subtract */
+	inline dcomplex operator * (dcomplex y) const { dcomplex x(*this); return x*=y; }; /**< complex multiply */
+	inline dcomplex operator / (dcomplex y) const { dcomplex x(*this); return x/=y; }; /**< complex divide */
+
+	/* comparison */
+	inline bool IsZero(double err=0.0) const /**< zero test */
+	{
+		return Mag()<=err;
+	};
+
+	/* magnitude comparisons */
+	inline bool operator == (double m) const { return Mag()==m; };
+	inline bool operator != (double m) const { return Mag()!=m; };
+	inline bool operator < (double m) const { return Mag()<m; };
+	inline bool operator <= (double m) const { return Mag()<=m; };
+	inline bool operator > (double m) const { return Mag()>m; };
+	inline bool operator >= (double m) const { return Mag()>=m; };
+	inline bool IsFinite(void) const { return isfinite(r) && isfinite(i); };
+};
+inline complex &complex::operator = (const dcomplex &x)
+{
+	r = x.r;
+	i = x.i;
+	return *this;
+}
+#if __cplusplus >= 201103L
+static_assert(sizeof(dcomplex)==2*sizeof(double),"dcomplex must not be padded");
+#endif
+#endif
+
 int complex_from_string(void *c, const char *str);
 int complex_set_part(void *c, const char *name, const char *value);
 
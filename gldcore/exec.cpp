@@ -132,6 +132,8 @@
 #include "link.h"
 #include "save.h"
 #include "lock.h"
+#include "perfcounter.h"
+#include "scenario.h"
 #include "pthread.h"
 
 SET_MYCONTEXT(DMC_EXEC)
@@ -2180,6 +2182,10 @@ STATUS GldExec::exec_start(void)
 	/* initialize the main loop state control */
 	mls_init();
 
+	/* prepare hardware counters before init so init passes are counted */
+	if ( global_perfcounters )
+		perfcounter_init();
+
 	/* perform object initialization */
 	if (init_all() == FAILED)
 	{
@@ -2216,6 +2222,14 @@ STATUS GldExec::exec_start(void)
 	if (global_compileonly)
 		return SUCCESS;
 
+	/* fork scenarios from the initialized model, the master returns once they are done */
+	if ( global_scenario_file[0]!='\0' )
+	{
+		SCENARIORESULT result = scenario_fork(global_scenario_file);
+		if ( result!=SCR_CHILD )
+			return result==SCR_SUCCESS ? SUCCESS : FAILED;
+	}
+
 	/* enable non-determinism check, if any */
 	if (global_randomseed!=0 && global_threadcount>1)
 		global_nondeterminism_warning = 1;
@@ -2861,6 +2875,10 @@ STATUS GldExec::exec_start(void)
 		output_error("finalize_all() failed");
 	}
 
+	/* write the counter profile before the term scripts so they can read it */
+	if ( global_perfcounters && !sync_isinvalid(NULL) )
+		perfcounter_dump(NULL);
+
 	/* run term scripts, if any */
 	if ( run_termscripts()!=XC_SUCCESS )
 	{
@@ -2965,6 +2983,8 @@ STATUS GldExec::exec_start(void)
 		output_profile("\n");
 		object_synctime_profile_dump(NULL);
 	}
+	if ( global_perfcounters )
+		perfcounter_term();
 
 	/* terminate links */
 	if ( thread ) free(thread);
@@ -162,7 +162,8 @@ DEPRECATED static KEYWORD dmc_keys[] = {
 		{"VERSION", 	DMC_VERSION, 		dmc_keys+50},
 		{"XCORE", 		DMC_XCORE, 			dmc_keys+51},
 		{"MAIN",		DMC_MAIN,			dmc_keys+52},
-		{"CMDARG",		DMC_CMDARG,			NULL},
+		{"CMDARG",		DMC_CMDARG,			dmc_keys+53},
+		{"BENCHMARK",	DMC_BENCHMARK,		NULL},
 };
 DEPRECATED static KEYWORD vtc_keys[] = {
 	{"SYNC",		VTC_SYNC,		vtc_keys+1},
@@ -208,7 +209,11 @@ DEPRECATED static struct s_varmap {
 	{"dumpall", PT_bool, &global_dumpall, PA_PUBLIC, "dumpall enable flag"},
 	{"runchecks", PT_bool, &global_runchecks, PA_PUBLIC, "runchecks enable flag"},
 	{"threadcount", PT_int32, &global_threadcount, PA_PUBLIC, "number of threads to use while using multicore"},
+	{"scenario_file", PT_char1024, &global_scenario_file, PA_PUBLIC, "scenario file to fork after initialization"},
+	{"scenario_limit", PT_int32, &global_scenario_limit, PA_PUBLIC, "maximum number of concurrent scenarios (0 means one per processor)"},
+	{"scenario_summary", PT_char1024, &global_scenario_summary, PA_PUBLIC, "scenario summary filename"},
 	{"profiler", PT_bool, &global_profiler, PA_PUBLIC, "profiler enable flag"},
+	{"perfcounters", PT_bool, &global_perfcounters, PA_PUBLIC, "hardware performance counter enable flag"},
 	{"pauseatexit", PT_bool, &global_pauseatexit, PA_PUBLIC, "pause at exit flag"},
 	{"testoutputfile", PT_char1024, &global_testoutputfile, PA_PUBLIC, "filename for test output"},
 	{"xml_encoding", PT_int32, &global_xml_encoding, PA_PUBLIC, "XML data encoding"},
@@ -301,6 +306,7 @@ DEPRECATED static struct s_varmap {
 	{"run_powerworld", PT_bool, &global_run_powerworld, PA_PUBLIC, "boolean that that says your system is set up correctly to run with PowerWorld"},
 	{"bigranks", PT_bool, &global_bigranks, PA_PUBLIC, "enable fast/blind set_rank operations"},
 	{"exename", PT_char1024, &global_execname, PA_REFERENCE, "argv[0] value"},
+	{"execpath", PT_char1024, &global_execpath, PA_REFERENCE, "resolved path of the running executable"},
 	{"wget_options", PT_char1024, &global_wget_options, PA_PUBLIC, "wget/curl options"},
 	{"curl_options", PT_char1024, &global_wget_options, PA_PUBLIC, "wget/curl options"},
 	{"svnroot", PT_char1024, &global_svnroot, PA_PUBLIC, "svnroot"},
@@ -106,7 +106,11 @@ GLOBAL int global_dumpall INIT(FALSE);	/**< Flags all modules to dump data after
 GLOBAL int global_runchecks INIT(FALSE); /**< Flags module check code to be called after initialization */
 /** @todo Set the threadcount to zero to automatically use the maximum system resources (tickets 180) */
 GLOBAL int global_threadcount INIT(1); /**< the maximum thread limit, zero means automagically determine best thread count */
+GLOBAL char global_scenario_file[1024] INIT(""); /**< Specifies the scenario file to fork from the initialized model */
+GLOBAL int global_scenario_limit INIT(0); /**< the maximum number of concurrent scenarios, zero means one per processor */
+GLOBAL char global_scenario_summary[1024] INIT("scenarios.csv"); /**< Specifies the scenario summary file */
 GLOBAL int global_profiler INIT(0); /**< Flags the profiler to process class performance data */
+GLOBAL int global_perfcounters INIT(0); /**< Flags the collection of hardware performance counters by class and pass */
 GLOBAL int global_pauseatexit INIT(0); /**< Enable a pause for user input after exit */
 GLOBAL char global_testoutputfile[1024] INIT("test.txt"); /**< Specifies the test output file */
 GLOBAL int global_xml_encoding INIT(8);  /**< Specifies XML encoding (default is 8) */
@@ -137,6 +141,7 @@ GLOBAL char global_trace[1024] INIT(""); /**< comma separate list of runtime cal
 GLOBAL int global_gdb_window INIT(0); /**< start gdb in a separate window */
 GLOBAL int global_process_id INIT(0); /**< the main process id */
 GLOBAL char global_execname[1024] INIT(""); /**< the main program full path */
+GLOBAL char global_execpath[1024] INIT(""); /**< resolved path of the running executable, used to start child runs */
 GLOBAL char global_tmp[1024] /**< location for temp files */
 #ifdef WIN32
 							INIT("C:\\WINDOWS\\TEMP");
@@ -393,8 +398,9 @@ typedef enum {
 	DMC_VALIDATE	= 0x0001000000000000,
 	DMC_VERSION		= 0x0002000000000000,
 	DMC_XCORE		= 0x0004000000000000,
+	DMC_BENCHMARK	= 0x0008000000000000,
 	DMC_NONE		=  0, /**< no messages allowed */
-	DMC_ALL			= 0x0007ffffffffffff, /**< all messages allowed */
+	DMC_ALL			= 0x000fffffffffffff, /**< all messages allowed */
 } GLOBALMESSAGECONTEXT;
 GLOBAL set global_output_message_context INIT(DMC_ALL); /**< message context control variable */
 
@@ -620,6 +620,11 @@ inline char *gl_getvalue(OBJECT *obj,
 
 #define gl_find_unit (*callback->unit_find)
 
+/** Resolve a unit conversion once for use with unit_apply()
+	@see unit_conversion()
+ **/
+#define gl_unit_conversion (*callback->unit_conversion)
+
 #define gl_get_object (*callback->get_object)
 
 #define gl_name_object (*callback->name_object)
@@ -2061,7 +2066,7 @@ public: // read accessors
 	inline PROPERTYACCESS get_access(void) { return pstruct.prop->access; };
 	inline bool get_access(unsigned int bits, unsigned int mask=0xffff) {  return ((pstruct.prop->access&mask)|bits); };
 	inline gld_unit* get_unit(void) { return (gld_unit*)pstruct.prop->unit; };
-	inline void* get_addr(void) { return obj?((void*)((char*)(obj+1)+(unsigned int64)(pstruct.prop->addr))):pstruct.prop->addr; };
+	inline void* get_addr(void) { check_valid(); return obj?((void*)((char*)(obj+1)+(unsigned int64)(pstruct.prop->addr))):pstruct.prop->addr; };
 	inline gld_keyword* get_first_keyword(void) { return (gld_keyword*)pstruct.prop->keywords; };
 	inline const char* get_description(void) { return pstruct.prop->description; };
 	inline PROPERTYFLAGS get_flags(void) { return pstruct.prop->flags; };
@@ -2087,6 +2092,11 @@ public: // write accessors
 
 public: // special operations
 	inline bool is_valid(void) { return pstruct.prop!=NULL; }
+#ifdef _DEBUG
+	inline void check_valid(void) { if ( pstruct.prop==NULL ) throw "gld_property used before it was bound to a valid property"; };
+#else
+	inline void check_valid(void) {};
+#endif
 	inline bool has_part(void) { return pstruct.part[0]!='\0'; };
 	inline bool is_complex(void) { if(pstruct.prop->ptype == PT_complex) return true; return false;}
 	inline bool is_double(void) { switch(pstruct.prop->ptype) { case PT_double: case PT_random: case PT_enduse: case PT_loadshape: return true; default: return false;} };
@@ -2108,6 +2118,7 @@ public: // special operations
 	inline double get_double(gld_unit&to) { double rv = get_double(); return get_unit()->convert(to,rv) ? rv : QNAN; };
 	inline double get_double(char*to) { double rv = get_double(); return get_unit()->convert(to,rv) ? rv : QNAN; };
 	inline complex get_complex(void) { errno=0; if ( pstruct.prop->ptype==PT_complex ) return *(complex*)get_addr(); else return complex(QNAN,QNAN); };
+	inline dcomplex get_dcomplex(void) { errno=0; if ( pstruct.prop->ptype==PT_complex ) return *(complex*)get_addr(); else return dcomplex(QNAN,QNAN); };
 	inline int64 get_integer(void) { errno=0; switch(pstruct.prop->ptype) { case PT_int16: return (int64)*(int16*)get_addr(); case PT_int32: return (int64)*(int32*)get_addr(); case PT_int64: return *(int64*)get_addr(); default: errno=EINVAL; return 0;} };
 	inline enumeration get_enumeration(void) { if ( pstruct.prop->ptype != PT_enumeration ) exception("get_enumeration() called on a property that is not an enumeration"); return *(enumeration*)get_addr(); };
 	inline set get_set(void) { if ( pstruct.prop->ptype != PT_set ) exception("get_set() called on a property that is not a set"); return *(set*)get_addr(); };
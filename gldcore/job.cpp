@@ -5,9 +5,14 @@
 #ifdef WIN32
 #include <windows.h>
 #include <direct.h>
+#include <io.h>
+#define F_OK 0
 #else
 #include <unistd.h>
 #include <dirent.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
 #endif
 
 #include <string.h>
@@ -15,6 +20,7 @@
 #include <stdio.h>
 #include <errno.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <signal.h>
 
 #include "globals.h"
@@ -145,6 +151,7 @@ static int closedir(DIR *dirp)
 /** command line arguments that are passed to test runs */
 static char job_cmdargs[1024];
 
+#ifdef WIN32
 /** variable arg system call */
 static int vsystem(const char *fmt, ...)
 {
@@ -158,6 +165,7 @@ static int vsystem(const char *fmt, ...)
 	IN_MYCONTEXT output_debug("system('%s') returns code %x", command, rc);
 	return rc;
 }
+#endif
 
 /** routine to destroy the contents of a directory */
 bool job_destroy_dir(char *name)
@@ -222,8 +230,189 @@ bool job_copyfile(char *from, char *to)
 	return true;
 }
 
-/** routine to run a validation test */
-static bool run_job(char *file, double *elapsed_time=NULL)
+/** job runner options (set using -D <name>=<value>) */
+typedef enum {
+	JA_NONE		= 0,	///< no processor pinning
+	JA_CPU		= 1,	///< pin each job slot to one processor
+	JA_NUMA		= 2,	///< pin each job slot to the processors of one NUMA node
+} JOBAFFINITY;
+static JOBAFFINITY job_affinity = JA_NONE;
+static bool job_resume = false; // skip models already completed in the summary file
+static double job_memory = 0; // expected MB per job (0 means learn from completed jobs)
+static char job_summary[1024] = "gridlabd-job.csv"; // aggregated results and resume progress
+static FILE *summary_fp = NULL;
+static LOCKVAR summary_lock = 0;
+
+/** NUMA node processor lists */
+#define MAXNODES 64
+static char node_cpus[MAXNODES][256];
+static unsigned int n_nodes = 0;
+
+/** find the NUMA nodes and their processor lists */
+static void load_numa_nodes(void)
+{
+#ifdef __linux__
+	for ( n_nodes = 0 ; n_nodes < MAXNODES ; n_nodes++ )
+	{
+		char fname[1024];
+		sprintf(fname,"/sys/devices/system/node/node%u/cpulist",n_nodes);
+		FILE *fp = fopen(fname,"r");
+		if ( fp==NULL )
+			break;
+		if ( fgets(node_cpus[n_nodes],sizeof(node_cpus[n_nodes]),fp)==NULL )
+			strcpy(node_cpus[n_nodes],"");
+		fclose(fp);
+	}
+#endif
+	if ( n_nodes==0 )
+	{
+		IN_MYCONTEXT output_verbose("NUMA topology not available, job affinity will use processors");
+		job_affinity = JA_CPU;
+	}
+}
+
+#ifdef __linux__
+/** convert a processor list (e.g., "0-3,8-11") to a processor set */
+static void cpulist_to_set(const char *list, cpu_set_t *set)
+{
+	CPU_ZERO(set);
+	const char *p = list;
+	while ( *p!='\0' && *p!='\n' )
+	{
+		unsigned int from, to;
+		int len;
+		if ( sscanf(p,"%u-%u%n",&from,&to,&len)==2 )
+			;
+		else if ( sscanf(p,"%u%n",&from,&len)==1 )
+			to = from;
+		else
+			break;
+		for ( unsigned int cpu = from ; cpu <= to && cpu < CPU_SETSIZE ; cpu++ )
+			CPU_SET(cpu,set);
+		p += len;
+		if ( *p==',' ) p++;
+	}
+}
+#endif
+
+/** processor set and failure message for a job slot
+	These are prepared before fork() so the child only makes async-signal-safe calls.
+ **/
+typedef struct s_jobslotaffinity {
+	bool enabled;
+#ifdef __linux__
+	cpu_set_t set;
+#endif
+	char message[256];
+	size_t length;
+} JOBSLOTAFFINITY;
+
+/** find the processor set of a job slot */
+static void get_affinity(size_t slot, JOBSLOTAFFINITY *affinity)
+{
+	affinity->enabled = false;
+#ifdef __linux__
+	if ( job_affinity==JA_CPU )
+	{
+		CPU_ZERO(&affinity->set);
+		CPU_SET((int)(slot%processor_count()),&affinity->set);
+	}
+	else if ( job_affinity==JA_NUMA )
+		cpulist_to_set(node_cpus[slot%n_nodes],&affinity->set);
+	else
+		return;
+	affinity->enabled = true;
+	int len = snprintf(affinity->message,sizeof(affinity->message),"WARNING  [INIT] : unable to set processor affinity of job slot %d\n",(int)slot);
+	affinity->length = len<(int)sizeof(affinity->message) ? (size_t)len : sizeof(affinity->message)-1;
+#endif
+}
+
+/** pin the calling process to a job slot's processors - called between fork() and exec() */
+static void set_affinity(JOBSLOTAFFINITY *affinity)
+{
+#ifdef __linux__
+	// only async-signal-safe calls are allowed here
+	if ( affinity->enabled && sched_setaffinity(0,sizeof(affinity->set),&affinity->set)!=0 )
+	{
+		ssize_t len = write(2,affinity->message,affinity->length);
+		(void)len; // nothing else can be done if stderr is not writable
+	}
+#endif
+}
+
+/** available system memory in MB (0 if unknown) */
+static double available_memory(void)
+{
+#ifdef __linux__
+	FILE *fp = fopen("/proc/meminfo","r");
+	if ( fp==NULL )
+		return 0;
+	char line[256];
+	double kb = 0;
+	while ( fgets(line,sizeof(line),fp)!=NULL )
+	{
+		if ( sscanf(line,"MemAvailable: %lf kB",&kb)==1 )
+			break;
+	}
+	fclose(fp);
+	return kb/1024;
+#else
+	return 0;
+#endif
+}
+
+/** memory admission control */
+static LOCKVAR admission_lock = 0;
+static double reserved_memory = 0; // MB reserved by running jobs
+static double peak_memory = 0; // largest MB used by a completed job
+static unsigned int n_running = 0;
+
+/** wait until enough memory is available to start a job, returns the MB reserved */
+static double admit_job(void)
+{
+	for (;;)
+	{
+		wlock(&admission_lock);
+		double need = job_memory>0 ? job_memory : peak_memory;
+		double avail = available_memory();
+		if ( n_running==0 || need==0 || avail==0 || avail-reserved_memory>=need )
+		{
+			reserved_memory += need;
+			n_running++;
+			wunlock(&admission_lock);
+			return need;
+		}
+		wunlock(&admission_lock);
+		IN_MYCONTEXT output_debug("job admission waiting for %.0f MB (%.0f MB available, %.0f MB reserved)", need, avail, reserved_memory);
+#ifdef WIN32
+		Sleep(1000);
+#else
+		sleep(1);
+#endif
+	}
+}
+
+/** release the memory reserved by a completed job */
+static void release_job(double reserved, double used)
+{
+	wlock(&admission_lock);
+	reserved_memory -= reserved;
+	n_running--;
+	if ( used>peak_memory )
+		peak_memory = used;
+	wunlock(&admission_lock);
+}
+
+/** result of a job */
+typedef struct s_jobresult {
+	int code; ///< exit code
+	double wall; ///< elapsed wall time (s)
+	double cpu; ///< processor time used (s)
+	double memory; ///< memory high-water mark (MB)
+} JOBRESULT;
+
+/** routine to run a job model */
+static bool run_job(char *file, size_t slot, JOBRESULT *result)
 {
 	IN_MYCONTEXT output_debug("run_job(char *file='%s') starting", file);
 
@@ -244,27 +433,122 @@ static bool run_job(char *file, double *elapsed_time=NULL)
 		blank[len]='\0';
 		len = output_raw("%s\rProcessing %s...\r",blank,name)-len; 
 	}
-	int64 dt = my_instance->get_exec()->clock();
-	unsigned int code = vsystem("%s %s %s ", 
+	memset(result,0,sizeof(JOBRESULT));
+	double reserved = admit_job();
+	struct timeval t0, t1;
+	gettimeofday(&t0,NULL);
 #ifdef WIN32
-		_pgmptr,
+	result->code = vsystem("%s %s %s ", _pgmptr, job_cmdargs, name);
 #else
-		"gridlabd",
+	// run this binary rather than whichever gridlabd is first on the path
+	char command[2048];
+	if ( snprintf(command,sizeof(command),"exec '%s' %s %s", global_execpath, job_cmdargs, name)>=(int)sizeof(command) )
+	{
+		output_error("run_job(char *file='%s'): command line is too long", file);
+		release_job(reserved,0);
+		result->code = XC_EXFAILED;
+		return false;
+	}
+	IN_MYCONTEXT output_debug("starting '%s' in slot %d", command, (int)slot);
+	JOBSLOTAFFINITY affinity;
+	get_affinity(slot,&affinity);
+	pid_t pid = fork();
+	if ( pid==0 )
+	{
+		set_affinity(&affinity);
+		if ( chdir(global_workdir)!=0 )
+			_exit(XC_IOERR);
+		execl("/bin/sh","sh","-c",command,NULL);
+		_exit(XC_SHFAILED);
+	}
+	int status = 0;
+	struct rusage usage;
+	memset(&usage,0,sizeof(usage));
+	if ( pid<0 || wait4(pid,&status,0,&usage)<0 )
+	{
+		output_error("run_job(char *file='%s'): unable to run job (%s)", file, strerror(errno));
+		result->code = XC_EXFAILED;
+	}
+	else
+	{
+		result->code = WIFEXITED(status) ? WEXITSTATUS(status) : (XC_SIGNAL|WTERMSIG(status));
+		result->cpu = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec)/1e6;
+		result->memory = usage.ru_maxrss/1024.0;
+	}
 #endif
-		job_cmdargs, name);
-	dt = my_instance->get_exec()->clock() - dt;
-	double t = (double)dt/(double)CLOCKS_PER_SEC;
-	if ( elapsed_time!=NULL ) *elapsed_time = t;
-	if ( code!=0 )
+	gettimeofday(&t1,NULL);
+	result->wall = (t1.tv_sec-t0.tv_sec) + (t1.tv_usec-t0.tv_usec)/1e6;
+	release_job(reserved,result->memory);
+	if ( result->code!=0 )
 	{
-		output_error("exit code %d received from %s", code, name);
+		output_error("exit code %d received from %s", result->code, name);
 		return false;
 	}
-	IN_MYCONTEXT output_debug("run_test(char *file='%s') done", file);
+	IN_MYCONTEXT output_debug("run_job(char *file='%s') done", file);
 	return true;
 }
 
-/* simple stack to handle directories that need to be processed */
+/** append a job result to the summary file */
+static void write_summary(const char *name, size_t slot, JOBRESULT *result)
+{
+	if ( summary_fp==NULL )
+		return;
+	wlock(&summary_lock);
+	fprintf(summary_fp,"%s,%d,%d,%.3f,%.3f,%.1f\n", name, (int)slot, result->code, result->wall, result->cpu, result->memory);
+	fflush(summary_fp);
+	wunlock(&summary_lock);
+}
+
+/** models already completed successfully in a previous run */
+typedef struct s_donelist {
+	char name[1024];
+	struct s_donelist *next;
+} DONELIST;
+static DONELIST *donelist = NULL;
+
+/** read the summary file of a previous run to resume where it left off */
+static unsigned int load_summary(void)
+{
+	unsigned int count = 0;
+	FILE *fp = fopen(job_summary,"r");
+	if ( fp==NULL )
+		return 0;
+	char line[1200];
+	while ( fgets(line,sizeof(line),fp)!=NULL )
+	{
+		// model names may contain commas, so the five result fields are found from the end
+		char *p = line+strlen(line);
+		int fields = 0;
+		while ( p>line && fields<5 )
+		{
+			if ( *--p==',' )
+				fields++;
+		}
+		int slot, code;
+		if ( fields==5 && (size_t)(p-line)<sizeof(donelist->name) && sscanf(p,",%d,%d",&slot,&code)==2 && code==0 )
+		{
+			DONELIST *item = (DONELIST*)malloc(sizeof(DONELIST));
+			strncpy(item->name,line,p-line);
+			item->name[p-line] = '\0';
+			item->next = donelist;
+			donelist = item;
+			count++;
+		}
+	}
+	fclose(fp);
+	return count;
+}
+static bool is_done(const char *name)
+{
+	for ( DONELIST *item = donelist ; item!=NULL ; item = item->next )
+	{
+		if ( strcmp(item->name,name)==0 )
+			return true;
+	}
+	return false;
+}
+
+/* simple queue to handle jobs that need to be processed */
 typedef struct s_jobstack {
 	char name[1024];
 	struct s_jobstack *next;
@@ -276,6 +560,7 @@ static void pushjob(char *dir)
 	IN_MYCONTEXT output_debug("adding %s to job list", dir);
 	JOBLIST *item = (JOBLIST*)malloc(sizeof(JOBLIST));
 	strncpy(item->name,dir,sizeof(item->name)-1);
+	item->name[sizeof(item->name)-1] = '\0';
 	wlock(&joblock);
 	item->next = jobstack;
 	jobstack = item;
@@ -284,31 +569,55 @@ static void pushjob(char *dir)
 /* popped item must be freed after no longer needed */
 static JOBLIST *popjob(void)
 {
-	rlock(&joblock);
+	wlock(&joblock);
 	JOBLIST *item = jobstack;
 	if ( jobstack ) jobstack = jobstack->next;
-	runlock(&joblock);
-	IN_MYCONTEXT output_debug("pulling %s from job list", item->name);
+	wunlock(&joblock);
+	if ( item ) IN_MYCONTEXT output_debug("pulling %s from job list", item->name);
 	return item;
 }
+/* sort the job list by name */
+static int compare_jobs(const void *a, const void *b)
+{
+	return strcmp((*(JOBLIST**)a)->name,(*(JOBLIST**)b)->name);
+}
+static void sortjobs(unsigned int count)
+{
+	if ( count<2 ) return;
+	JOBLIST **list = new JOBLIST*[count];
+	unsigned int n = 0;
+	for ( JOBLIST *item = jobstack ; item!=NULL && n<count ; item = item->next )
+		list[n++] = item;
+	qsort(list,n,sizeof(JOBLIST*),compare_jobs);
+	for ( unsigned int i = 0 ; i < n ; i++ )
+		list[i]->next = i+1<n ? list[i+1] : NULL;
+	jobstack = list[0];
+	delete [] list;
+}
 
 static int final_result = true;
+static unsigned int n_done = 0, n_failed = 0;
 void *(run_job_proc)(void *arg)
 {
 	size_t id = (size_t)arg;
-	IN_MYCONTEXT output_debug("starting run_test_proc id %d", id);
+	IN_MYCONTEXT output_debug("starting run_job_proc id %d", id);
 	JOBLIST *item;
 	while ( (item=popjob())!=NULL )
 	{
 		IN_MYCONTEXT output_debug("process %d picked up '%s'", id, item->name);
-		double dt;
-		if ( !run_job(item->name,&dt) )
-			final_result = false;
+		JOBRESULT result;
+		bool ok = run_job(item->name,id,&result);
+		write_summary(item->name,id,&result);
+		wlock(&summary_lock);
+		if ( ok ) n_done++; else n_failed++;
+		if ( !ok ) final_result = false;
+		wunlock(&summary_lock);
+		free(item);
 	}
 	return NULL;
 }
 
-/** routine to process a directory for autotests */
+/** routine to process a directory for jobs */
 static size_t process_dir(const char *path)
 {
 	size_t count = 0;
@@ -324,6 +633,11 @@ static size_t process_dir(const char *path)
 		if ( dp->d_name[0]=='.' ) continue; // ignore anything that starts with a dot
 		if ( ext && strcmp(ext,".glm")==0 )
 		{
+			if ( job_resume && is_done(item) )
+			{
+				IN_MYCONTEXT output_verbose("skipping %s, already completed", item);
+				continue;
+			}
 			pushjob(item);
 			count++;
 		}
@@ -332,7 +646,47 @@ static size_t process_dir(const char *path)
 	return count;
 }
 
-/** main validation routine */
+/** read the job runner options */
+static bool job_options(void)
+{
+	char var[1024];
+	if ( global_getvar("clean",var,sizeof(var))!=NULL && atoi(var)!=0 ) clean = true;
+	if ( global_getvar("job_resume",var,sizeof(var))!=NULL ) job_resume = ( atoi(var)!=0 || strcmp(var,"TRUE")==0 || strcmp(var,"true")==0 );
+	if ( global_getvar("job_memory",var,sizeof(var))!=NULL ) job_memory = atof(var);
+	if ( global_getvar("job_summary",var,sizeof(var))!=NULL ) strcpy(job_summary,var);
+	if ( global_getvar("job_affinity",var,sizeof(var))!=NULL )
+	{
+		if ( strcmp(var,"none")==0 ) job_affinity = JA_NONE;
+		else if ( strcmp(var,"cpu")==0 ) job_affinity = JA_CPU;
+		else if ( strcmp(var,"numa")==0 ) job_affinity = JA_NUMA;
+		else
+		{
+			output_error("job_affinity '%s' is not valid (must be none, cpu, or numa)", var);
+			return false;
+		}
+	}
+	if ( job_affinity==JA_NUMA )
+		load_numa_nodes();
+#ifndef __linux__
+	if ( job_affinity!=JA_NONE )
+		output_warning("job_affinity is not supported on this platform");
+#endif
+	return true;
+}
+
+/** main job routine
+
+	Runs all the GLM files in the working directory, using up to \p threadcount
+	concurrent gridlabd processes.  The following globals control the job runner:
+
+	- \p job_affinity: \p none, \p cpu (pin each job slot to a processor), or \p numa
+	  (pin each job slot to the processors of a NUMA node so memory is first-touched locally)
+	- \p job_memory: MB each job is expected to need; jobs are not started until that much
+	  memory is available.  When 0 the largest memory used by a completed job is used.
+	- \p job_summary: file to which each job's exit code, wall time, processor time
+	  and memory use are appended as it completes (default \p gridlabd-job.csv)
+	- \p job_resume: skip models that completed successfully according to the summary file
+ **/
 int job(void *main, int argc, const char *argv[])
 {
 	size_t i;
@@ -348,24 +702,41 @@ int job(void *main, int argc, const char *argv[])
 		strcat(job_cmdargs," --redirect all");
 	global_suppress_repeat_messages = 0;
 	output_message("Starting job in directory '%s'", global_workdir);
-	char var[64];
-	if ( global_getvar("clean",var,sizeof(var))!=NULL && atoi(var)!=0 ) clean = true;
-
+	if ( !job_options() )
+		exit(XC_ARGERR);
 
 	char mailto[1024];
 	global_getvar("mailto",mailto,sizeof(mailto));
-	
+
+	unsigned int n_skipped = job_resume ? load_summary() : 0;
+	if ( n_skipped>0 )
+		output_message("Resuming job, %d models already completed", n_skipped);
 	unsigned int count = (int)process_dir(global_workdir);
 	if ( count==0 )
 	{
+		if ( n_skipped>0 )
+		{
+			output_message("All models already completed");
+			exit(XC_SUCCESS);
+		}
 		output_warning("no models found to process job in workdir '%s'", global_workdir);
 		exit(XC_RUNERR);
 	}
-	
+	sortjobs(count);
+
+	bool new_summary = !job_resume || access(job_summary,F_OK)!=0;
+	summary_fp = fopen(job_summary,new_summary?"w":"a");
+	if ( summary_fp==NULL )
+		output_warning("unable to open job summary file '%s' (%s)", job_summary, strerror(errno));
+	else if ( new_summary )
+		fprintf(summary_fp,"model,slot,exitcode,wall_time[s],cpu_time[s],memory[MB]\n");
+
 	unsigned int n_procs = global_threadcount;
 	if ( n_procs==0 ) n_procs = processor_count();
 	pthread_t *pid = new pthread_t[n_procs];
 	IN_MYCONTEXT output_debug("starting job with cmdargs '%s' using %d threads", job_cmdargs, n_procs);
+	struct timeval t0, t1;
+	gettimeofday(&t0,NULL);
 	for ( i=0 ; i<MIN(count,n_procs) ; i++ )
 		pthread_create(&pid[i],NULL,run_job_proc,(void*)i);
 	void *rc;
@@ -376,13 +747,17 @@ int job(void *main, int argc, const char *argv[])
 		IN_MYCONTEXT output_debug("process %d done", i);
 	}
 	delete [] pid;
+	gettimeofday(&t1,NULL);
+	bool summary_saved = ( summary_fp!=NULL );
+	if ( summary_saved )
+		fclose(summary_fp);
 
-	double dt = (double)my_instance->get_exec()->clock()/(double)CLOCKS_PER_SEC;
+	double dt = (t1.tv_sec-t0.tv_sec) + (t1.tv_usec-t0.tv_usec)/1e6;
 	output_message("Total job elapsed time: %.1f seconds", dt);
-	if ( final_result==0 )
-		exec_setexitcode(XC_SUCCESS);
-	else
-		exec_setexitcode(XC_RUNERR);
+	output_message("%d models completed, %d failed", n_done, n_failed);
+	if ( summary_saved )
+		output_message("Job summary saved to '%s'", job_summary);
+	exec_setexitcode(final_result ? XC_SUCCESS : XC_RUNERR);
 
 #ifndef WIN32
 #ifdef __APPLE__
@@ -399,5 +774,5 @@ int job(void *main, int argc, const char *argv[])
 //		output_error("Error sending notification to %s", mailto);
 #endif
 
-	exit(final_result==0 ? XC_SUCCESS : XC_TSTERR);
+	exit(final_result ? XC_SUCCESS : XC_TSTERR);
 }
@@ -6,6 +6,7 @@
 #include "load.h"
 #include "exec.h"
 #include "save.h"
+#include "find.h"
 
 static PyObject *gridlabd_exception(const char *format, ...);
 
@@ -45,6 +46,8 @@ static PyObject *gridlabd_get_schedule(PyObject *self, PyObject *args);
 
 static PyObject *gridlabd_set_global(PyObject *self, PyObject *args);
 static PyObject *gridlabd_set_value(PyObject *self, PyObject *args);
+static PyObject *gridlabd_get_view(PyObject *self, PyObject *args);
+static bool gridlabd_view_ready(PyObject *module);
 
 static PyObject *gridlabd_convert_unit(PyObject *self, PyObject *args);
 
@@ -84,6 +87,7 @@ static PyMethodDef module_methods[] = {
     // sets
     {"set_global", gridlabd_set_global, METH_VARARGS, "Set a GridLAB-D global variable"},
     {"set_value", gridlabd_set_value, METH_VARARGS, "Set a GridLAB-D object property"},
+    {"get_view", gridlabd_get_view, METH_VARARGS, "Get a buffer view of a double or complex property over a group of objects (a copy when view.zerocopy is False, see view.refresh() and view.flush())"},
     // utilities
     {"convert_unit", gridlabd_convert_unit, METH_VARARGS, "Convert units of a float, complex or string"},
 
@@ -255,6 +259,8 @@ PyMODINIT_FUNC PyInit_gridlabd(void)
     gridlabdException = PyErr_NewException("gridlabd.exception",NULL,NULL);
     Py_XINCREF(gridlabdException);
     PyModule_AddObject(this_module,"exception",gridlabdException);
+    if ( ! gridlabd_view_ready(this_module) )
+        return NULL;
 
     // adjustments for python modules
     global_glm_save_options = GSO_MINIMAL;
@@ -900,6 +906,291 @@ static PyObject *gridlabd_set_value(PyObject *self, PyObject *args)
     return Py_BuildValue("s",previous);
 }
 
+//
+// >>> view = gridlabd.get_view(group,property)
+// >>> values = numpy.asarray(view)
+//
+// A view resolves a group (e.g., "class=inverter") and a double or complex
+// property once and exposes the values through the buffer protocol, so that
+// numpy arrays read and write object memory directly instead of converting
+// each value to and from a string. When the objects are evenly spaced in
+// memory the buffer is strided over the object data itself. Otherwise the
+// buffer is a copy (view.zerocopy is False): the values are gathered into a
+// staging buffer when the first buffer is acquired and written back to the
+// objects when the last buffer is released. While an array over a copy is
+// held, it does not follow the simulation; call view.refresh() to gather the
+// current values into it and view.flush() to write its values to the objects.
+//
+// Returns: (gridlabd.view) view of the property over the objects in the group
+//
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t size; // number of objects in the view
+    PROPERTYTYPE ptype; // PT_double or PT_complex
+    OBJECT **obj; // objects in the view
+    char **addr; // address of the property in each object
+    Py_ssize_t stride; // distance between objects, or 0 if not evenly spaced
+    bool readonly; // property cannot be written by modules
+    char *staging; // gathered values when not evenly spaced
+    int exports; // number of buffers currently exported
+    bool dirty; // a writable buffer was exported from the staging area
+    Py_ssize_t shape[1];
+    Py_ssize_t strides[1];
+} GldView;
+
+static char view_format_double[] = "d";
+static char view_format_complex[] = "Zd";
+
+static Py_ssize_t view_itemsize(GldView *view)
+{
+    return view->ptype == PT_complex ? 2*sizeof(double) : sizeof(double);
+}
+
+static void gridlabd_view_dealloc(PyObject *self)
+{
+    GldView *view = (GldView*)self;
+    free(view->obj);
+    free(view->addr);
+    free(view->staging);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static Py_ssize_t gridlabd_view_length(PyObject *self)
+{
+    return ((GldView*)self)->size;
+}
+
+static int gridlabd_view_getbuffer(PyObject *self, Py_buffer *buffer, int flags)
+{
+    GldView *view = (GldView*)self;
+    Py_ssize_t itemsize = view_itemsize(view);
+    if ( view->readonly && (flags&PyBUF_WRITABLE) == PyBUF_WRITABLE )
+    {
+        PyErr_SetString(PyExc_BufferError,"view property is read-only");
+        return -1;
+    }
+    if ( view->stride != 0 )
+    {
+        if ( (flags&PyBUF_STRIDES) != PyBUF_STRIDES && view->stride != itemsize )
+        {
+            PyErr_SetString(PyExc_BufferError,"view is strided over objects");
+            return -1;
+        }
+        buffer->buf = view->addr[0];
+        view->strides[0] = view->stride;
+    }
+    else
+    {
+        if ( view->exports == 0 )
+        {
+            ReadLock lock;
+            Py_ssize_t n;
+            for ( n = 0 ; n < view->size ; n++ )
+                memcpy(view->staging+n*itemsize,view->addr[n],itemsize);
+        }
+        buffer->buf = view->staging;
+        view->strides[0] = itemsize;
+        if ( ! view->readonly )
+            view->dirty = true;
+    }
+    view->shape[0] = view->size;
+    view->exports++;
+    buffer->obj = self;
+    Py_INCREF(self);
+    buffer->len = view->size*itemsize;
+    buffer->readonly = view->readonly ? 1 : 0;
+    buffer->itemsize = itemsize;
+    buffer->format = (flags&PyBUF_FORMAT) ? (view->ptype == PT_complex ? view_format_complex : view_format_double) : NULL;
+    buffer->ndim = 1;
+    buffer->shape = (flags&PyBUF_ND) ? view->shape : NULL;
+    buffer->strides = (flags&PyBUF_STRIDES) == PyBUF_STRIDES ? view->strides : NULL;
+    buffer->suboffsets = NULL;
+    buffer->internal = NULL;
+    return 0;
+}
+
+static void gridlabd_view_releasebuffer(PyObject *self, Py_buffer *buffer)
+{
+    GldView *view = (GldView*)self;
+    if ( --view->exports > 0 || view->stride != 0 || ! view->dirty )
+        return;
+    WriteLock lock;
+    Py_ssize_t itemsize = view_itemsize(view);
+    Py_ssize_t n;
+    for ( n = 0 ; n < view->size ; n++ )
+        memcpy(view->addr[n],view->staging+n*itemsize,itemsize);
+    view->dirty = false;
+}
+
+static PyObject *gridlabd_view_names(PyObject *self, PyObject *args)
+{
+    GldView *view = (GldView*)self;
+    PyObject *data = PyList_New(0);
+    Py_ssize_t n;
+    for ( n = 0 ; n < view->size ; n++ )
+    {
+        OBJECT *obj = view->obj[n];
+        if ( obj->name )
+            PyList_Append(data,Py_BuildValue("s",obj->name));
+        else
+        {
+            char name[1024];
+            snprintf(name,sizeof(name),"%s:%d",obj->oclass->name,obj->id);
+            PyList_Append(data,Py_BuildValue("s",name));
+        }
+    }
+    return data;
+}
+
+static PyObject *gridlabd_view_refresh(PyObject *self, PyObject *args)
+{
+    GldView *view = (GldView*)self;
+    if ( view->stride == 0 )
+    {
+        ReadLock lock;
+        Py_ssize_t itemsize = view_itemsize(view);
+        Py_ssize_t n;
+        for ( n = 0 ; n < view->size ; n++ )
+            memcpy(view->staging+n*itemsize,view->addr[n],itemsize);
+        view->dirty = false;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *gridlabd_view_flush(PyObject *self, PyObject *args)
+{
+    GldView *view = (GldView*)self;
+    if ( view->stride == 0 && view->exports > 0 && ! view->readonly )
+    {
+        WriteLock lock;
+        Py_ssize_t itemsize = view_itemsize(view);
+        Py_ssize_t n;
+        for ( n = 0 ; n < view->size ; n++ )
+            memcpy(view->addr[n],view->staging+n*itemsize,itemsize);
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *gridlabd_view_zerocopy(PyObject *self, void *closure)
+{
+    return PyBool_FromLong(((GldView*)self)->stride != 0);
+}
+
+static PyMethodDef gridlabd_view_methods[] = {
+    {"names", gridlabd_view_names, METH_NOARGS, "Get the names of the objects in the view"},
+    {"refresh", gridlabd_view_refresh, METH_NOARGS, "Gather the current object values into a copied buffer (discards values not yet flushed; no effect when zerocopy)"},
+    {"flush", gridlabd_view_flush, METH_NOARGS, "Write the values of a copied buffer that is still held to the objects (no effect when zerocopy)"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyGetSetDef gridlabd_view_getset[] = {
+    {(char*)"zerocopy", gridlabd_view_zerocopy, NULL, (char*)"True if the buffer points directly at the object data, False if it is a copy that needs refresh() and flush()", NULL},
+    {NULL, NULL, NULL, NULL, NULL}
+};
+
+static PySequenceMethods gridlabd_view_sequence = {
+    gridlabd_view_length, // sq_length
+};
+
+static PyBufferProcs gridlabd_view_buffer = {
+    gridlabd_view_getbuffer, // bf_getbuffer
+    gridlabd_view_releasebuffer, // bf_releasebuffer
+};
+
+static PyTypeObject gridlabd_view_type = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    "gridlabd.view", // tp_name
+    sizeof(GldView), // tp_basicsize
+};
+
+static bool gridlabd_view_ready(PyObject *module)
+{
+    gridlabd_view_type.tp_dealloc = gridlabd_view_dealloc;
+    gridlabd_view_type.tp_as_sequence = &gridlabd_view_sequence;
+    gridlabd_view_type.tp_as_buffer = &gridlabd_view_buffer;
+    gridlabd_view_type.tp_flags = Py_TPFLAGS_DEFAULT;
+    gridlabd_view_type.tp_doc = "GridLAB-D property view; when zerocopy is False the buffer is a copy that is gathered when first acquired and written back when last released, use refresh() and flush() while it is held";
+    gridlabd_view_type.tp_methods = gridlabd_view_methods;
+    gridlabd_view_type.tp_getset = gridlabd_view_getset;
+    if ( PyType_Ready(&gridlabd_view_type) < 0 )
+        return false;
+    Py_INCREF(&gridlabd_view_type);
+    PyModule_AddObject(module,"view",(PyObject*)&gridlabd_view_type);
+    return true;
+}
+
+static PyObject *gridlabd_get_view(PyObject *self, PyObject *args)
+{
+    char *group;
+    char *property;
+    restore_environ();
+    if ( ! PyArg_ParseTuple(args, "ss", &group, &property) )
+        return NULL;
+    OBJLIST *list = objlist_search(group);
+    if ( list == NULL || list->size == 0 )
+    {
+        objlist_destroy(list);
+        return gridlabd_exception("group '%s' does not contain any objects", group);
+    }
+
+    GldView *view = PyObject_New(GldView,&gridlabd_view_type);
+    if ( view == NULL )
+    {
+        objlist_destroy(list);
+        return NULL;
+    }
+    view->size = list->size;
+    view->obj = (OBJECT**)malloc(sizeof(OBJECT*)*list->size);
+    view->addr = (char**)malloc(sizeof(char*)*list->size);
+    view->staging = NULL;
+    view->stride = 0;
+    view->readonly = false;
+    view->exports = 0;
+    view->dirty = false;
+    if ( view->obj == NULL || view->addr == NULL )
+    {
+        objlist_destroy(list);
+        Py_DECREF(view);
+        return PyErr_NoMemory();
+    }
+    size_t n;
+    for ( n = 0 ; n < list->size ; n++ )
+    {
+        OBJECT *obj = list->objlist[n];
+        PROPERTY *prop = object_get_property(obj,property,NULL);
+        if ( prop == NULL || ( prop->ptype != PT_double && prop->ptype != PT_complex ) || ( n > 0 && prop->ptype != view->ptype ) )
+        {
+            objlist_destroy(list);
+            Py_DECREF(view);
+            return gridlabd_exception("property '%s' of object '%s:%d' is not a double or complex property common to the group", property, obj->oclass->name, obj->id);
+        }
+        view->ptype = prop->ptype;
+        view->obj[n] = obj;
+        view->addr[n] = (char*)GETADDR(obj,prop);
+        if ( (prop->access&PA_W) != PA_W )
+            view->readonly = true;
+    }
+    objlist_destroy(list);
+
+    // use the object data directly when the objects are evenly spaced
+    view->stride = view->size > 1 ? view->addr[1] - view->addr[0] : view_itemsize(view);
+    for ( n = 2 ; n < (size_t)view->size && view->stride != 0 ; n++ )
+    {
+        if ( view->addr[n] - view->addr[n-1] != view->stride )
+            view->stride = 0;
+    }
+    if ( view->stride == 0 )
+    {
+        view->staging = (char*)malloc(view->size*view_itemsize(view));
+        if ( view->staging == NULL )
+        {
+            Py_DECREF(view);
+            return PyErr_NoMemory();
+        }
+    }
+    return (PyObject*)view;
+}
+
 static PROPERTY *get_first_property(OBJECT *obj)
 {
     return obj->oclass->pmap;
@@ -51,6 +51,7 @@ gridlabd = Extension('gridlabd',
 	libraries = ['ncurses', 'curl'],
 	sources = list(map(lambda x: srcdir+'/'+x,['gldcore/link/python/python.cpp',
 		'gldcore/aggregate.cpp',
+		'gldcore/benchmark.cpp',
 		'gldcore/class.cpp',
 		'gldcore/cmdarg.cpp',
 		'gldcore/compare.cpp',
@@ -92,11 +93,13 @@ gridlabd = Extension('gridlabd',
 		'gldcore/module.cpp',
 		'gldcore/object.cpp',
 		'gldcore/output.cpp',
+		'gldcore/perfcounter.cpp',
 		'gldcore/property.cpp',
 		'gldcore/random.cpp',
 		'gldcore/realtime.cpp',
 		'gldcore/sanitize.cpp',
 		'gldcore/save.cpp',
+		'gldcore/scenario.cpp',
 		'gldcore/schedule.cpp',
 		'gldcore/server.cpp',
 		'gldcore/setup.cpp',
@@ -499,6 +499,15 @@ int loadshape_initall(void)
 	return SUCCESS;
 }
 
+/** Restart each loadshape's random number generator from the global random state
+ **/
+void loadshape_reseedall(void)
+{
+	loadshape *ls;
+	for (ls=loadshape_list; ls!=NULL; ls=ls->next)
+		ls->rng_state = randwarn(NULL);
+}
+
 void loadshape_recalc(loadshape *ls)
 {
 	switch (ls->type) {
@@ -105,6 +105,7 @@ extern "C" {
 int loadshape_create(void *ptr);
 int loadshape_init(loadshape *shape);
 int loadshape_initall(void);
+void loadshape_reseedall(void);
 TIMESTAMP loadshape_sync(loadshape *m, TIMESTAMP t1);
 TIMESTAMP loadshape_syncall(TIMESTAMP t1);
 
@@ -25,6 +25,45 @@ void register_lock(const char *name, LOCKVAR *lock);
 }
 #endif
 
+/************************************************************************************** 
+   IMPORTANT NOTE: it is vital that the platform specific implementations be tested for
+   first because some compilers support __sync_bool_compare_and_swap on platforms that
+   have a native (often better) implementation of atomic operations.
+ **************************************************************************************/
+#if defined(__APPLE__) && defined(__cplusplus)
+	//#include <libkern/OSAtomic.h>
+	#include <atomic>
+	//#define atomic_compare_and_swap(thevalue, oldvalue, newvalue) OSAtomicCompareAndSwap32Barrier(oldvalue, newvalue, (volatile int32_t *) thevalue)
+	#define atomic_compare_and_swap(thevalue, oldvalue, newvalue) std::atomic_compare_exchange_strong((std::atomic<int32_t>*)thevalue,(int32_t*)&oldvalue,(int32_t)newvalue)
+	//#define atomic_increment(ptr) OSAtomicIncrement32Barrier((volatile int32_t *) ptr)
+	#define atomic_increment(ptr) std::atomic_fetch_add((std::atomic<int32_t>*)ptr,1)
+#elif defined(WIN32) && !defined __MINGW32__
+	#include <intrin.h>
+	#pragma intrinsic(_InterlockedCompareExchange)
+	#pragma intrinsic(_InterlockedIncrement)
+	#define atomic_compare_and_swap(dest, comp, xchg) (_InterlockedCompareExchange((volatile LOCKVAR *) dest, xchg, comp) == comp)
+	#define atomic_increment(ptr) _InterlockedIncrement((volatile LOCKVAR *) ptr)
+	#ifndef inline
+		#define inline __inline
+	#endif
+#elif defined HAVE___SYNC_BOOL_COMPARE_AND_SWAP
+	#define atomic_compare_and_swap __sync_bool_compare_and_swap
+	#ifdef HAVE___SYNC_ADD_AND_FETCH
+		#define atomic_increment(ptr) __sync_add_and_fetch((volatile LOCKVAR *)ptr, 1)
+	#else
+		static inline LOCKVAR atomic_increment(LOCKVAR *ptr)
+		{
+			unsigned int value;
+			do {
+				value = *(volatile LOCKVAR *)ptr;
+			} while (!__sync_bool_compare_and_swap((volatile LOCKVAR*)ptr, value, value + 1));
+			return value;
+		}
+	#endif
+#else
+	#error "Locking is not supported on this system"
+#endif
+
 #endif /* _LOCK_H */
 
 /**@}**/
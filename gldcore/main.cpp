@@ -284,6 +284,27 @@ void GldMain::set_global_browser(const char *path)
 void GldMain::set_global_execname(const char *path)
 {
 	strcpy(global_execname,path);
+
+	// resolve the binary that is actually running so child runs (jobs, benchmarks, scripts)
+	// use it rather than whichever gridlabd is first on the path
+#ifdef WIN32
+	strncpy(global_execpath,_pgmptr,sizeof(global_execpath)-1);
+#else
+	ssize_t len = -1;
+#ifdef __linux__
+	len = readlink("/proc/self/exe",global_execpath,sizeof(global_execpath)-1);
+#endif
+	char *resolved = NULL;
+	if ( len>0 )
+		global_execpath[len] = '\0';
+	else if ( strchr(path,'/')!=NULL && (resolved=realpath(path,NULL))!=NULL )
+	{
+		strncpy(global_execpath,resolved,sizeof(global_execpath)-1);
+		free(resolved);
+	}
+	else
+		strncpy(global_execpath,path,sizeof(global_execpath)-1);
+#endif
 }
 
 void GldMain::set_global_execdir(const char *path)
@@ -44,6 +44,7 @@
 #include "lock.h"
 #include "threadpool.h"
 #include "exec.h"
+#include "perfcounter.h"
 
 SET_MYCONTEXT(DMC_OBJECT)
 
@@ -1541,6 +1542,8 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 					  PASSCONFIG pass) /**< the pass configuration */
 {
 	clock_t t = (clock_t)exec_clock();
+	PERFCOUNTERSAMPLE pc;
+	if ( global_perfcounters ) perfcounter_read(&pc);
 	TIMESTAMP t2=TS_NEVER;
 	int rc = 0;
 	const char *passname[]={"NOSYNC","PRESYNC","SYNC","INVALID","POSTSYNC"};
@@ -1577,6 +1580,15 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 		default: break;
 		}
 	}
+	if ( global_perfcounters )
+	{
+		switch (pass) {
+		case PC_PRETOPDOWN: perfcounter_accumulate(obj,OPI_PRESYNC,&pc);break;
+		case PC_BOTTOMUP: perfcounter_accumulate(obj,OPI_SYNC,&pc);break;
+		case PC_POSTTOPDOWN: perfcounter_accumulate(obj,OPI_POSTSYNC,&pc);break;
+		default: break;
+		}
+	}
 	if ( global_debug_output>0 )
 	{
 		char dt1[64]="(invalid)"; if ( ts!=TS_INVALID ) convert_from_timestamp(absolute_timestamp(ts),dt1,sizeof(dt1)); else strcpy(dt1,"ERROR");
@@ -1594,8 +1606,11 @@ TIMESTAMP object_sync(OBJECT *obj, /**< the object to synchronize */
 TIMESTAMP object_heartbeat(OBJECT *obj)
 {
 	clock_t t = (clock_t)exec_clock();
+	PERFCOUNTERSAMPLE pc;
+	if ( global_perfcounters ) perfcounter_read(&pc);
 	TIMESTAMP t1 = obj->oclass->heartbeat ? obj->oclass->heartbeat(obj) : TS_NEVER;
 	object_profile(obj,OPI_HEARTBEAT,t);
+	if ( global_perfcounters ) perfcounter_accumulate(obj,OPI_HEARTBEAT,&pc);
 		if ( global_debug_output>0 )
 		{
 			char dt[64]="(invalid)"; convert_from_timestamp(absolute_timestamp(t1),dt,sizeof(dt));
@@ -1612,6 +1627,8 @@ TIMESTAMP object_heartbeat(OBJECT *obj)
 int object_init(OBJECT *obj) /**< the object to initialize */
 {
 	clock_t t = (clock_t)exec_clock();
+	PERFCOUNTERSAMPLE pc;
+	if ( global_perfcounters ) perfcounter_read(&pc);
 	int rv = 1;
 	obj->clock = global_starttime;
 	if ( obj->oclass->init != NULL )
@@ -1627,6 +1644,7 @@ int object_init(OBJECT *obj) /**< the object to initialize */
 		}
 	}
 	object_profile(obj,OPI_INIT,t);
+	if ( global_perfcounters ) perfcounter_accumulate(obj,OPI_INIT,&pc);
 	if ( global_debug_output>0 )
 	{
 		IN_MYCONTEXT output_debug("object %s:%d init -> %s", obj->oclass->name, obj->id, rv?"ok":"failed");
@@ -1646,6 +1664,8 @@ int object_init(OBJECT *obj) /**< the object to initialize */
 STATUS object_precommit(OBJECT *obj, TIMESTAMP t1)
 {
 	clock_t t = (clock_t)exec_clock();
+	PERFCOUNTERSAMPLE pc;
+	if ( global_perfcounters ) perfcounter_read(&pc);
 	STATUS rv = SUCCESS;
 	if ( (global_validto_context&VTC_PRECOMMIT) == VTC_PRECOMMIT )
 	{
@@ -1671,6 +1691,7 @@ STATUS object_precommit(OBJECT *obj, TIMESTAMP t1)
 		}
 	}
 	object_profile(obj,OPI_PRECOMMIT,t);
+	if ( global_perfcounters ) perfcounter_accumulate(obj,OPI_PRECOMMIT,&pc);
 	if ( global_debug_output>0 )
 	{
 		IN_MYCONTEXT output_debug("object %s:%d precommit -> %s", obj->oclass->name, obj->id, rv?"ok":"failed");
@@ -1681,6 +1702,8 @@ STATUS object_precommit(OBJECT *obj, TIMESTAMP t1)
 TIMESTAMP object_commit(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2)
 {
 	clock_t t = (clock_t)exec_clock();
+	PERFCOUNTERSAMPLE pc;
+	if ( global_perfcounters ) perfcounter_read(&pc);
 	TIMESTAMP rv = 1;
 	if ( (global_validto_context&VTC_COMMIT) == VTC_COMMIT )
 	{
@@ -1705,6 +1728,7 @@ TIMESTAMP object_commit(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2)
 		}
 	}
 	object_profile(obj,OPI_COMMIT,t);
+	if ( global_perfcounters ) perfcounter_accumulate(obj,OPI_COMMIT,&pc);
 	if ( global_debug_output > 0 )
 	{
 		char dt[64]="(invalid)"; if ( rv!=TS_INVALID ) convert_from_timestamp(absolute_timestamp(rv),dt,sizeof(dt)); else strcpy(dt,"ERROR");
@@ -1722,6 +1746,8 @@ TIMESTAMP object_commit(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2)
 STATUS object_finalize(OBJECT *obj)
 {
 	clock_t t = (clock_t)exec_clock();
+	PERFCOUNTERSAMPLE pc;
+	if ( global_perfcounters ) perfcounter_read(&pc);
 	STATUS rv = SUCCESS;
 	if(obj->oclass->finalize != NULL){
 		rv = (STATUS)(*(obj->oclass->finalize))(obj);
@@ -1739,6 +1765,7 @@ STATUS object_finalize(OBJECT *obj)
 		}
 	}
 	object_profile(obj,OPI_FINALIZE,t);
+	if ( global_perfcounters ) perfcounter_accumulate(obj,OPI_FINALIZE,&pc);
 	if ( global_debug_output>0 )
 	{
 		IN_MYCONTEXT output_debug("object %s:%d finalize -> %s", obj->oclass->name, obj->id, rv?"ok":"failed");
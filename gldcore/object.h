@@ -344,6 +344,7 @@ typedef struct s_callbacks {
 		unsigned int (*build)(void);
 		const char * (*branch)(void);
 	} version;
+	int (*unit_conversion)(UNIT *pFrom, UNIT *pTo, UNITCONVERSION *pConv);
 	long unsigned int magic; /* used to check structure alignment */
 } CALLBACKS; /**< core callback function table */
 
@@ -0,0 +1,307 @@
+/* perfcounter.cpp
+ * This module collects hardware performance counters (cycles, instructions, cache misses
+ * and branch misses) for each object pass and accumulates them by class and pass.
+ * Counters are only available on Linux via perf_event_open(2).  When they cannot be
+ * opened (unsupported platform, perf_event_paranoid, virtualized PMU) the profiler
+ * warns once and the run continues without counter data; calls are still counted.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "perfcounter.h"
+#include "class.h"
+#include "output.h"
+#include "globals.h"
+#include "lock.h"
+
+SET_MYCONTEXT(DMC_OBJECT)
+
+static const char *eventname[_PCE_NUMITEMS] = {"cycles","instructions","cache_misses","branch_misses"};
+static const char *passname[_OPI_NUMITEMS] = {"presync","sync","postsync","init","heartbeat","precommit","commit","finalize"};
+
+/* per-class accumulators, indexed by class id */
+typedef struct s_perfcounterclass {
+	LOCKVAR lock;
+	unsigned long long count[_OPI_NUMITEMS];
+	unsigned long long total[_OPI_NUMITEMS][_PCE_NUMITEMS];
+} PERFCOUNTERCLASS;
+static PERFCOUNTERCLASS *classdata = NULL;
+static unsigned int n_classes = 0;
+static bool unavailable_warned = false;
+
+#ifdef __linux__
+
+/* per-thread counter group; the group leader is -2 until the thread first reads */
+static __thread int group_fd = -2;
+static __thread int event_fd[_PCE_NUMITEMS];
+static __thread int event_slot[_PCE_NUMITEMS]; /* position in group read, -1 if not counting */
+static __thread int n_slots = 0;
+static __thread unsigned int thread_generation = 0;
+
+/* counter groups opened by all threads, so term can close every thread's descriptors */
+typedef struct s_perfcounterthread {
+	int fd[_PCE_NUMITEMS];
+	struct s_perfcounterthread *next;
+} PERFCOUNTERTHREAD;
+static PERFCOUNTERTHREAD *thread_list = NULL;
+static LOCKVAR thread_lock = 0;
+static unsigned int generation = 1; /* advanced by term so every thread reopens its counters */
+
+static void register_thread_counters(void)
+{
+	PERFCOUNTERTHREAD *item = (PERFCOUNTERTHREAD*)malloc(sizeof(PERFCOUNTERTHREAD));
+	if ( item==NULL )
+	{
+		output_warning("perfcounter: unable to record thread counters, they will not be released until exit");
+		return;
+	}
+	memcpy(item->fd,event_fd,sizeof(item->fd));
+	wlock(&thread_lock);
+	item->next = thread_list;
+	thread_list = item;
+	wunlock(&thread_lock);
+}
+
+/* forget counters opened before the last term */
+static void check_thread_generation(void)
+{
+	if ( thread_generation!=generation )
+	{
+		group_fd = -2;
+		thread_generation = generation;
+	}
+}
+
+static int open_event(unsigned long long config, int leader)
+{
+	struct perf_event_attr attr;
+	memset(&attr,0,sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = config;
+	attr.disabled = (leader==-1) ? 1 : 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP;
+	return (int)syscall(__NR_perf_event_open,&attr,0,-1,leader,0);
+}
+
+static bool open_thread_counters(void)
+{
+	static const unsigned long long config[_PCE_NUMITEMS] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_MISSES,
+		PERF_COUNT_HW_BRANCH_MISSES,
+	};
+	int i;
+	n_slots = 0;
+	for ( i = 0 ; i < _PCE_NUMITEMS ; i++ )
+	{
+		event_fd[i] = open_event(config[i], i==0 ? -1 : group_fd);
+		if ( i==0 )
+		{
+			if ( event_fd[0] < 0 )
+			{
+				group_fd = -1;
+				if ( !unavailable_warned )
+				{
+					output_warning("perfcounter: hardware counters are not available (%s), counter data will not be collected", strerror(errno));
+					unavailable_warned = true;
+				}
+				return false;
+			}
+			group_fd = event_fd[0];
+		}
+		if ( event_fd[i] < 0 )
+		{
+			IN_MYCONTEXT output_verbose("perfcounter: %s counter is not available on this system", eventname[i]);
+			event_slot[i] = -1;
+		}
+		else
+			event_slot[i] = n_slots++;
+	}
+	register_thread_counters();
+	ioctl(group_fd,PERF_EVENT_IOC_RESET,PERF_IOC_FLAG_GROUP);
+	ioctl(group_fd,PERF_EVENT_IOC_ENABLE,PERF_IOC_FLAG_GROUP);
+	return true;
+}
+
+#endif
+
+/** Prepare the performance counter profiler
+	@return true if counters are available on the calling thread
+ **/
+bool perfcounter_init(void)
+{
+	n_classes = class_get_count();
+	classdata = (PERFCOUNTERCLASS*)calloc(n_classes,sizeof(PERFCOUNTERCLASS));
+	if ( classdata==NULL )
+	{
+		output_error("perfcounter_init(): unable to allocate class counter table");
+		n_classes = 0;
+		return false;
+	}
+#ifdef __linux__
+	check_thread_generation();
+	if ( group_fd==-2 )
+		open_thread_counters();
+	return group_fd >= 0;
+#else
+	output_warning("perfcounter: hardware counters are not supported on this platform, counter data will not be collected");
+	unavailable_warned = true;
+	return false;
+#endif
+}
+
+/** Take a snapshot of the calling thread's counters
+ **/
+void perfcounter_read(PERFCOUNTERSAMPLE *sample)
+{
+	sample->valid = false;
+	if ( classdata==NULL )
+		return;
+#ifdef __linux__
+	check_thread_generation();
+	if ( group_fd==-2 )
+		open_thread_counters();
+	if ( group_fd>=0 )
+	{
+		unsigned long long buffer[1+_PCE_NUMITEMS];
+		int i;
+		if ( read(group_fd,buffer,sizeof(buffer)) < (ssize_t)(sizeof(buffer[0])*(1+n_slots)) )
+			return;
+		for ( i = 0 ; i < _PCE_NUMITEMS ; i++ )
+			sample->value[i] = event_slot[i]>=0 ? buffer[1+event_slot[i]] : 0;
+		sample->valid = true;
+	}
+#endif
+}
+
+/** Add the counter delta since \p start to the object's class and pass
+	Calls are counted even when counters are not available.
+ **/
+void perfcounter_accumulate(OBJECT *obj, OBJECTPROFILEITEM pass, PERFCOUNTERSAMPLE *start)
+{
+	PERFCOUNTERSAMPLE stop;
+	PERFCOUNTERCLASS *data;
+	int i;
+	if ( classdata==NULL || obj->oclass->id<0 || (unsigned int)obj->oclass->id>=n_classes )
+		return;
+	stop.valid = false;
+	if ( start->valid )
+		perfcounter_read(&stop);
+	data = &classdata[obj->oclass->id];
+	wlock(&data->lock);
+	data->count[pass]++;
+	if ( stop.valid )
+	{
+		for ( i = 0 ; i < _PCE_NUMITEMS ; i++ )
+			data->total[pass][i] += stop.value[i] - start->value[i];
+	}
+	wunlock(&data->lock);
+}
+
+/** Write the counter profile by class and pass, and summarize it by pass
+ **/
+void perfcounter_dump(const char *filename)
+{
+	const char *fname = filename?filename:"perfcounter_profile.txt";
+	unsigned long long pass_total[_OPI_NUMITEMS][_PCE_NUMITEMS];
+	FILE *fp;
+	CLASS *oclass;
+	int pass, i;
+
+	if ( classdata==NULL )
+		return;
+	fp = fopen(fname,"wt");
+	if ( fp == NULL )
+	{
+		output_warning("unable to access perfcounter profile dumpfile '%s'", fname);
+		return;
+	}
+	fprintf(fp,"%s","class,pass,calls");
+	for ( i = 0 ; i < _PCE_NUMITEMS ; i++ )
+		fprintf(fp,",%s",eventname[i]);
+	fprintf(fp,"%s",",ipc,cache_misses_per_call,branch_misses_per_call\n");
+	memset(pass_total,0,sizeof(pass_total));
+	for ( oclass = class_get_first_class() ; oclass != NULL ; oclass = oclass->next )
+	{
+		PERFCOUNTERCLASS *data;
+		if ( oclass->id<0 || (unsigned int)oclass->id>=n_classes )
+			continue;
+		data = &classdata[oclass->id];
+		for ( pass = 0 ; pass < _OPI_NUMITEMS ; pass++ )
+		{
+			unsigned long long *value = data->total[pass];
+			if ( data->count[pass]==0 )
+				continue;
+			fprintf(fp,"%s,%s,%llu",oclass->name,passname[pass],data->count[pass]);
+			for ( i = 0 ; i < _PCE_NUMITEMS ; i++ )
+			{
+				fprintf(fp,",%llu",value[i]);
+				pass_total[pass][i] += value[i];
+			}
+			fprintf(fp,",%.3f,%.1f,%.1f\n",
+				value[PCE_CYCLES]>0 ? (double)value[PCE_INSTRUCTIONS]/(double)value[PCE_CYCLES] : 0.0,
+				(double)value[PCE_CACHEMISSES]/(double)data->count[pass],
+				(double)value[PCE_BRANCHMISSES]/(double)data->count[pass]);
+		}
+	}
+	fclose(fp);
+
+	output_profile("Hardware counter profile (details in '%s')", fname);
+	output_profile("==========================================\n");
+	if ( unavailable_warned )
+	{
+		output_profile("Hardware counters were not available\n");
+		return;
+	}
+	output_profile("Pass        Mcycles   Minstr    IPC  Kcache-miss Kbranch-miss");
+	output_profile("--------- --------- -------- ------ ------------ ------------");
+	for ( pass = 0 ; pass < _OPI_NUMITEMS ; pass++ )
+	{
+		unsigned long long *value = pass_total[pass];
+		if ( value[PCE_CYCLES]==0 && value[PCE_INSTRUCTIONS]==0 )
+			continue;
+		output_profile("%-9.9s %9.1f %8.1f %6.3f %12.1f %12.1f", passname[pass],
+			value[PCE_CYCLES]/1e6, value[PCE_INSTRUCTIONS]/1e6,
+			value[PCE_CYCLES]>0 ? (double)value[PCE_INSTRUCTIONS]/(double)value[PCE_CYCLES] : 0.0,
+			value[PCE_CACHEMISSES]/1e3, value[PCE_BRANCHMISSES]/1e3);
+	}
+	output_profile("\n");
+}
+
+/** Release the counters opened by every thread and the class table
+ **/
+void perfcounter_term(void)
+{
+#ifdef __linux__
+	int i;
+	wlock(&thread_lock);
+	while ( thread_list!=NULL )
+	{
+		PERFCOUNTERTHREAD *next = thread_list->next;
+		for ( i = _PCE_NUMITEMS-1 ; i >= 0 ; i-- )
+			if ( thread_list->fd[i]>=0 )
+				close(thread_list->fd[i]);
+		free(thread_list);
+		thread_list = next;
+	}
+	generation++;
+	wunlock(&thread_lock);
+	group_fd = -2;
+#endif
+	free(classdata);
+	classdata = NULL;
+	n_classes = 0;
+}
@@ -0,0 +1,41 @@
+/* perfcounter.h
+ * Hardware performance counter profiling by class and pass
+ */
+
+#ifndef _PERFCOUNTER_H
+#define _PERFCOUNTER_H
+
+#include "platform.h"
+#include "object.h"
+
+/** Hardware events collected by the performance counter profiler */
+typedef enum {
+	PCE_CYCLES,
+	PCE_INSTRUCTIONS,
+	PCE_CACHEMISSES,
+	PCE_BRANCHMISSES,
+	/* add counter events here */
+	_PCE_NUMITEMS,
+} PERFCOUNTEREVENT;
+
+/** Snapshot of the calling thread's hardware counters */
+typedef struct s_perfcountersample {
+	bool valid; /**< flag indicating the counters could be read */
+	unsigned long long value[_PCE_NUMITEMS]; /**< raw counter values */
+} PERFCOUNTERSAMPLE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool perfcounter_init(void);
+void perfcounter_read(PERFCOUNTERSAMPLE *sample);
+void perfcounter_accumulate(OBJECT *obj, OBJECTPROFILEITEM pass, PERFCOUNTERSAMPLE *start);
+void perfcounter_dump(const char *filename);
+void perfcounter_term(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
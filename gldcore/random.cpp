@@ -32,6 +32,7 @@
 #include "lock.h"
 #include "platform.h"
 #include "exec.h"
+#include "loadshape.h"
 
 SET_MYCONTEXT(DMC_RANDOM)
 
@@ -1330,6 +1331,25 @@ TIMESTAMP randomvar_sync(randomvar *var, TIMESTAMP t1)
 	return var->update_rate<=0 ? TS_NEVER : ((t1/var->update_rate)+1)*var->update_rate;
 }
 
+/** Restart the random number generators from the current seed
+	so that processes forked from the same model draw different streams.
+	This covers the random variables, each object's generator and each loadshape's generator.
+ **/
+int random_reseed(void)
+{
+	randomvar *var;
+	OBJECT *obj;
+	if ( global_randomseed==0 )
+		global_randomseed = entropy_source();
+	global_randomstate = global_randomseed;
+	for ( var=randomvar_list ; var!=NULL ; var=var->next )
+		var->state = randwarn(NULL);
+	for ( obj=object_get_first() ; obj!=NULL ; obj=object_get_next(obj) )
+		obj->rng_state = randwarn(NULL);
+	loadshape_reseedall();
+	return 1;
+}
+
 randomvar *randomvar_getnext(randomvar*var)
 {
 	return var ? randomvar_list : var->next;
@@ -34,6 +34,7 @@ typedef enum {
 extern "C" {
 #endif
 	int random_init(void);
+	int random_reseed(void);
 	int random_test(void);
 	int randwarn(unsigned int *state);
 	void random_key(unsigned long long *ptr, size_t len);
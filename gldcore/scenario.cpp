@@ -0,0 +1,366 @@
+/* scenario.cpp
+ * This module forks scenarios from a model that has already been loaded and initialized.
+ * The scenario file is a CSV file whose header names the scenario column followed by the
+ * globals (e.g., "randomseed", "powerflow::maximum_voltage_error") and object properties
+ * (e.g., "load1.constant_power_A") that are overridden, and whose rows give each scenario's
+ * name and values.  Comment lines start with '#'.
+ *
+ * Each scenario runs in its own process forked after init, so the loaded model and the
+ * initialized object data are shared copy-on-write instead of being reloaded.  The scenario
+ * process changes to a directory named after the scenario so that recorders and output
+ * streams are written separately, and the original working directory is placed at the front
+ * of GLPATH so that players still find their input files.  Files that objects already opened
+ * during init are shared by all scenarios.
+ *
+ * The master waits for the scenarios, at most scenario_limit at a time, and writes their exit
+ * codes, wall time, cpu time and peak memory to the scenario_summary file.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <ctype.h>
+#include <sys/stat.h>
+
+#ifndef WIN32
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif
+
+#include "scenario.h"
+#include "globals.h"
+#include "output.h"
+#include "object.h"
+#include "random.h"
+#include "threadpool.h"
+
+SET_MYCONTEXT(DMC_EXEC)
+
+#define MAXCOLUMNS 256
+
+typedef struct s_scenario {
+	char *name;
+	char **value;
+	int pid;
+	int exitcode;
+	bool done;
+	double started;
+	double wall_time;
+	double cpu_time;
+	double memory;
+	struct s_scenario *next;
+} SCENARIO;
+
+static char *trim(char *str)
+{
+	char *end;
+	while ( isspace(*str) ) str++;
+	end = str+strlen(str);
+	while ( end>str && isspace(end[-1]) ) *--end = '\0';
+	return str;
+}
+
+/* split a line into at most MAXCOLUMNS fields, returning the number of fields */
+static int split(char *line, char *field[])
+{
+	int n = 0;
+	char *next = line;
+	while ( next!=NULL && n<MAXCOLUMNS )
+	{
+		char *comma = strchr(next,',');
+		if ( comma ) *comma = '\0';
+		field[n++] = trim(next);
+		next = comma ? comma+1 : NULL;
+	}
+	return next==NULL ? n : -1;
+}
+
+/* find the object and property named by a column "object.property", if any */
+static bool find_property(const char *column, OBJECT **obj, char *property, size_t len)
+{
+	char objname[1024];
+	const char *dot = strrchr(column,'.');
+	if ( dot==NULL || (size_t)(dot-column)>=sizeof(objname) || strlen(dot+1)>=len )
+		return false;
+	strncpy(objname,column,dot-column);
+	objname[dot-column] = '\0';
+	strcpy(property,dot+1);
+	*obj = object_find_name(objname);
+	return *obj!=NULL && object_get_property(*obj,property,NULL)!=NULL;
+}
+
+static void free_scenarios(SCENARIO *list, char **column, int n_columns)
+{
+	int i;
+	while ( list!=NULL )
+	{
+		SCENARIO *next = list->next;
+		for ( i = 0 ; i < n_columns ; i++ )
+			free(list->value[i]);
+		free(list->value);
+		free(list->name);
+		free(list);
+		list = next;
+	}
+	for ( i = 0 ; i < n_columns ; i++ )
+		free(column[i]);
+}
+
+/* read the scenario file, returning the number of scenarios or -1 on error */
+static int load_scenarios(const char *filename, SCENARIO **list, char *column[], int *n_columns)
+{
+	char line[65536];
+	char *field[MAXCOLUMNS];
+	SCENARIO *last = NULL;
+	int lineno = 0, count = 0, i;
+	FILE *fp = fopen(filename,"r");
+	*list = NULL;
+	*n_columns = -1;
+	if ( fp==NULL )
+	{
+		output_error("scenario file '%s' could not be opened: %s", filename, strerror(errno));
+		return -1;
+	}
+	while ( fgets(line,sizeof(line),fp)!=NULL )
+	{
+		char *text = trim(line);
+		int n;
+		lineno++;
+		if ( text[0]=='\0' || text[0]=='#' )
+			continue;
+		n = split(text,field);
+		if ( n<0 )
+		{
+			output_error("%s(%d): too many columns (limit is %d)", filename, lineno, MAXCOLUMNS);
+			goto Error;
+		}
+		if ( *n_columns<0 )
+		{
+			/* header: first column names the scenarios, the rest name the overrides */
+			*n_columns = n-1;
+			for ( i = 1 ; i < n ; i++ )
+			{
+				OBJECT *obj;
+				char property[256];
+				column[i-1] = strdup(field[i]);
+				if ( global_find(field[i])==NULL && !find_property(field[i],&obj,property,sizeof(property)) )
+				{
+					*n_columns = i;
+					output_error("%s(%d): '%s' is neither a global variable nor an object property", filename, lineno, field[i]);
+					goto Error;
+				}
+			}
+		}
+		else
+		{
+			SCENARIO *item;
+			if ( n-1!=*n_columns )
+			{
+				output_error("%s(%d): scenario has %d values but the header names %d", filename, lineno, n-1, *n_columns);
+				goto Error;
+			}
+			if ( field[0][0]=='\0' || strcmp(field[0],".")==0 || strcmp(field[0],"..")==0 || strpbrk(field[0],"/\\:")!=NULL )
+			{
+				output_error("%s(%d): '%s' is not a valid scenario name", filename, lineno, field[0]);
+				goto Error;
+			}
+			item = (SCENARIO*)calloc(1,sizeof(SCENARIO));
+			item->name = strdup(field[0]);
+			item->value = (char**)calloc(*n_columns>0?*n_columns:1,sizeof(char*));
+			for ( i = 0 ; i < *n_columns ; i++ )
+				item->value[i] = strdup(field[i+1]);
+			item->exitcode = -1;
+			if ( last ) last->next = item; else *list = item;
+			last = item;
+			count++;
+		}
+	}
+	fclose(fp);
+	if ( count==0 )
+	{
+		output_error("scenario file '%s' does not define any scenarios", filename);
+		return -1;
+	}
+	return count;
+Error:
+	fclose(fp);
+	free_scenarios(*list,column,*n_columns>0?*n_columns:0);
+	*list = NULL;
+	return -1;
+}
+
+#ifndef WIN32
+
+static double now(void)
+{
+	struct timeval tv;
+	gettimeofday(&tv,NULL);
+	return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+/* called in the scenario process to move into its directory and apply its overrides */
+static bool start_scenario(SCENARIO *item, char *column[], int n_columns, const char *basedir)
+{
+	char glpath[4096];
+	const char *oldpath = getenv("GLPATH");
+	bool reseed = false;
+	int i;
+
+	if ( mkdir(item->name,0775)!=0 && errno!=EEXIST )
+	{
+		output_error("scenario '%s' directory could not be created: %s", item->name, strerror(errno));
+		return false;
+	}
+	if ( chdir(item->name)!=0 || getcwd(global_workdir,sizeof(global_workdir))==NULL )
+	{
+		output_error("scenario '%s' directory could not be used: %s", item->name, strerror(errno));
+		return false;
+	}
+	snprintf(glpath,sizeof(glpath),"%s%s%s",basedir,oldpath?":":"",oldpath?oldpath:"");
+	setenv("GLPATH",glpath,1);
+
+	output_redirect("output",NULL);
+	output_redirect("error",NULL);
+	output_redirect("warning",NULL);
+	output_redirect("profile",NULL);
+
+	for ( i = 0 ; i < n_columns ; i++ )
+	{
+		OBJECT *obj;
+		char property[256];
+		if ( global_find(column[i])!=NULL )
+		{
+			if ( global_setvar(column[i],item->value[i])!=SUCCESS )
+				return false;
+			if ( strcmp(column[i],"randomseed")==0 )
+				reseed = true;
+		}
+		else if ( !find_property(column[i],&obj,property,sizeof(property)) || object_set_value_by_name(obj,property,item->value[i])==0 )
+		{
+			output_error("scenario '%s' could not set %s to '%s'", item->name, column[i], item->value[i]);
+			return false;
+		}
+	}
+	if ( reseed )
+		random_reseed();
+	IN_MYCONTEXT output_verbose("scenario '%s' started in '%s'", item->name, global_workdir);
+	return true;
+}
+
+static void write_summary(SCENARIO *list)
+{
+	FILE *fp = fopen(global_scenario_summary,"w");
+	if ( fp==NULL )
+	{
+		output_warning("scenario summary file '%s' could not be opened: %s", global_scenario_summary, strerror(errno));
+		return;
+	}
+	fprintf(fp,"scenario,pid,exitcode,wall_time[s],cpu_time[s],memory[MB]\n");
+	for ( ; list!=NULL ; list=list->next )
+		fprintf(fp,"%s,%d,%d,%.3f,%.3f,%.1f\n",list->name,list->pid,list->exitcode,list->wall_time,list->cpu_time,list->memory);
+	fclose(fp);
+}
+
+#endif
+
+/** Fork the scenarios listed in \p filename from the initialized model
+	@return SCR_CHILD in each scenario process, which continues with the simulation,
+	and SCR_SUCCESS or SCR_FAILED in the master once all scenarios have completed
+ **/
+SCENARIORESULT scenario_fork(const char *filename)
+{
+	SCENARIO *list, *item, *next;
+	char *column[MAXCOLUMNS];
+	int n_columns, n_scenarios, limit, running = 0, failed = 0;
+	char basedir[1024];
+
+	n_scenarios = load_scenarios(filename,&list,column,&n_columns);
+	if ( n_scenarios<0 )
+		return SCR_FAILED;
+
+#ifdef WIN32
+	output_error("scenario forking is not supported on this platform");
+	free_scenarios(list,column,n_columns);
+	return SCR_FAILED;
+#else
+	if ( getcwd(basedir,sizeof(basedir))==NULL )
+	{
+		output_error("unable to get working directory: %s", strerror(errno));
+		free_scenarios(list,column,n_columns);
+		return SCR_FAILED;
+	}
+	limit = global_scenario_limit>0 ? global_scenario_limit : processor_count();
+	if ( limit<1 )
+		limit = 1;
+	IN_MYCONTEXT output_verbose("forking %d scenarios from '%s', %d at a time", n_scenarios, filename, limit);
+
+	next = list;
+	while ( next!=NULL || running>0 )
+	{
+		/* start as many scenarios as the limit allows */
+		while ( next!=NULL && running<limit )
+		{
+			item = next;
+			next = next->next;
+			fflush(stdout);
+			fflush(stderr);
+			item->started = now();
+			item->pid = fork();
+			if ( item->pid==0 )
+			{
+				global_scenario_file[0] = '\0';
+				if ( !start_scenario(item,column,n_columns,basedir) )
+					_exit(XC_ARGERR);
+				return SCR_CHILD;
+			}
+			else if ( item->pid<0 )
+			{
+				output_error("scenario '%s' could not be started: %s", item->name, strerror(errno));
+				item->pid = 0;
+				failed++;
+				continue;
+			}
+			IN_MYCONTEXT output_verbose("scenario '%s' started as pid %d", item->name, item->pid);
+			running++;
+		}
+
+		/* collect the next scenario to finish */
+		if ( running>0 )
+		{
+			int status;
+			struct rusage usage;
+			int pid = wait4(-1,&status,0,&usage);
+			if ( pid<0 )
+			{
+				if ( errno==EINTR )
+					continue;
+				output_error("unable to wait for scenarios: %s", strerror(errno));
+				break;
+			}
+			for ( item = list ; item!=NULL && (item->pid!=pid || item->done) ; item = item->next ) {}
+			if ( item==NULL )
+				continue;
+			running--;
+			item->done = true;
+			item->wall_time = now() - item->started;
+			item->cpu_time = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec*1e-6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec*1e-6;
+			item->memory = usage.ru_maxrss/1024.0;
+			item->exitcode = WIFEXITED(status) ? WEXITSTATUS(status) : (WIFSIGNALED(status) ? XC_SIGNAL+WTERMSIG(status) : XC_EXFAILED);
+			if ( item->exitcode!=XC_SUCCESS )
+			{
+				output_error("scenario '%s' failed with exit code %d", item->name, item->exitcode);
+				failed++;
+			}
+			else
+				IN_MYCONTEXT output_verbose("scenario '%s' completed in %.1f seconds", item->name, item->wall_time);
+		}
+	}
+
+	write_summary(list);
+	output_message("%d of %d scenarios completed successfully (see '%s')", n_scenarios-failed, n_scenarios, global_scenario_summary);
+	free_scenarios(list,column,n_columns);
+	return failed==0 && running==0 ? SCR_SUCCESS : SCR_FAILED;
+#endif
+}
@@ -0,0 +1,27 @@
+/* scenario.h
+ * Copy-on-write scenario forks of an initialized model
+ */
+
+#ifndef _SCENARIO_H
+#define _SCENARIO_H
+
+#include "platform.h"
+
+/** Result of forking scenarios from the initialized model */
+typedef enum {
+	SCR_CHILD,		///< the caller is a scenario process and should run the simulation
+	SCR_SUCCESS,	///< the caller is the master and all scenarios completed successfully
+	SCR_FAILED,		///< the scenarios could not be started, or at least one of them failed
+} SCENARIORESULT;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SCENARIORESULT scenario_fork(const char *filename);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -161,16 +161,18 @@ EXPORT int etp_solve(ETPDATA *etp)
 		return 1;
 	}
 
-	// solve using Newton's method
+	// solve using Newton's method (f and dfdt share the same exponentials)
 	unsigned int iter = max_iterations;
-	if (t!=0) // initial t changed to inflexion point
-		f = EVAL(t,a,n,b,m,c);
-	double dfdt = EVAL(t,a*n,n,b*m,m,0); 
+	double ent = exp(n*t), emt = exp(m*t);
+	f = a*ent + b*emt + c;
+	double dfdt = a*n*ent + b*m*emt;
 	while ( fabs(f)>p && isfinite(t) && iter-->0)
 	{
 		t -= f/dfdt;
-		f = EVAL(t,a,n,b,m,c);
-		dfdt = EVAL(t,a*n,n,b*m,m,0);
+		ent = exp(n*t);
+		emt = exp(m*t);
+		f = a*ent + b*emt + c;
+		dfdt = a*n*ent + b*m*emt;
 	}
 	if (iter==0)
 	{
@@ -111,18 +111,80 @@ struct s_unitscalar {
 };
 UNITSCALAR *scalar_list = NULL;
 
+/* units are also indexed by name in an open-addressed hash table so that lookups
+	made while converting values during the simulation do not scan the unit list.
+	the index always refers to the most recent definition of a name, which is the
+	one the list scan would have found first.
+*/
+static UNIT **unit_index = NULL;
+static size_t unit_index_size = 0; /* always a power of 2 */
+static size_t unit_index_count = 0;
+static LOCKVAR unit_index_lock = 0;
+
+static size_t unit_hash(const char *name)
+{
+	size_t hash = 2166136261u;
+	while ( *name!='\0' )
+		hash = (hash ^ (unsigned char)*name++) * 16777619u;
+	return hash;
+}
+
+/* must be called with the index write-locked */
+static void unit_index_put(UNIT *unit)
+{
+	size_t i;
+	if ( 2*(unit_index_count+1) > unit_index_size )
+	{
+		UNIT **old = unit_index;
+		size_t old_size = unit_index_size;
+		unit_index_size = old_size ? 2*old_size : 256;
+		unit_index = (UNIT**)calloc(unit_index_size,sizeof(UNIT*));
+		if ( unit_index==NULL )
+			throw_exception("unit index allocation failed");
+			/* TROUBLESHOOT
+				The unit system was unable to allocate memory for its name index.
+				Try freeing up system memory and try again.
+			 */
+		unit_index_count = 0;
+		for ( i=0 ; i<old_size ; i++ )
+		{
+			if ( old[i]!=NULL )
+				unit_index_put(old[i]);
+		}
+		free(old);
+	}
+	for ( i=unit_hash(unit->name)&(unit_index_size-1) ; unit_index[i]!=NULL ; i=(i+1)&(unit_index_size-1) )
+	{
+		if ( strcmp(unit_index[i]->name,unit->name)==0 )
+		{
+			unit_index[i] = unit;
+			return;
+		}
+	}
+	unit_index[i] = unit;
+	unit_index_count++;
+}
+
 /* unit_find_raw is both used to detect the presence and absence of units in the list.
 	not finding a given unit is normal behavior, and this function should run silently.
 */
 UNIT *unit_find_raw(const char *unit){
-	UNIT *p;
-	/* scan list for existing entry */
-	for (p = unit_list; p != NULL; p = p->next){
-		if (strcmp(p->name,unit) == 0){
-			return p;
+	UNIT *p = NULL;
+	size_t i;
+	rlock(&unit_index_lock);
+	if ( unit_index_size>0 )
+	{
+		for ( i=unit_hash(unit)&(unit_index_size-1) ; unit_index[i]!=NULL ; i=(i+1)&(unit_index_size-1) )
+		{
+			if ( strcmp(unit_index[i]->name,unit)==0 )
+			{
+				p = unit_index[i];
+				break;
+			}
 		}
 	}
-	return NULL;
+	runlock(&unit_index_lock);
+	return p;
 }
 UNIT *unit_primary(const char *name,double c,double e,double h,double k,double m,double s,double a,double b,int prec);
 
@@ -265,7 +327,10 @@ UNIT *unit_primary(const char *name, double c, double e, double h, double k, dou
 	p->b = b;
 	p->prec = prec;
 	p->next = unit_list;
+	wlock(&unit_index_lock);
+	unit_index_put(p);
 	unit_list = p;
+	wunlock(&unit_index_lock);
 	return p;
 }
 
@@ -669,6 +734,33 @@ int unit_convert_ex(UNIT *pFrom, UNIT *pTo, double *pValue)
 	}
 }
 
+/** Resolve the conversion from one unit to another so that it can be applied
+	to any number of values with unit_apply() without looking up the units again
+	@return 1 if successful, 0 if failed
+ **/
+int unit_conversion(UNIT *pFrom, UNIT *pTo, UNITCONVERSION *pConv)
+{
+	if(pFrom == NULL || pTo == NULL || pConv == NULL){
+		output_error("could not run unit_conversion due to null arguement");
+		/*	TROUBLESHOOT
+			An error occured earlier in processing that caused a null pointer to be used as an arguement.  Review
+			other error messages for details, but either a property was not found, or a unit definition was not
+			found.
+		*/
+		return 0;
+	}
+	if (pTo->c == pFrom->c && pTo->e == pFrom->e && pTo->h == pFrom->h && pTo->k == pFrom->k && pTo->m == pFrom->m && pTo->s == pFrom->s)
+	{
+		pConv->from_offset = pFrom->b;
+		pConv->scale = pFrom->a / pTo->a;
+		pConv->to_offset = pTo->b;
+		return 1;
+	} else {
+		output_error("could not convert units from %s to %s, mismatched constant values", pFrom->name, pTo->name);
+		return 0;
+	}
+}
+
 /** Convert a complex value from one unit to another
 	@return 1 if successful, 0 if failed
  **/
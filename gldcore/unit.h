@@ -18,6 +18,18 @@ typedef struct s_unit {
 	struct s_unit *next; /**< the next unit is the unit list */
 } UNIT; /**< the UNIT structure */
 
+typedef struct s_unitconversion {
+	double from_offset;	/**< the offset removed from the value in the original unit */
+	double scale;		/**< the ratio of the original unit to the target unit */
+	double to_offset;	/**< the offset added to the value in the target unit */
+} UNITCONVERSION; /**< a conversion resolved by unit_conversion() */
+
+/** Apply a resolved conversion to a value */
+static inline double unit_apply(const UNITCONVERSION *conv, double value)
+{
+	return (value - conv->from_offset) * conv->scale + conv->to_offset;
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -25,6 +37,7 @@ extern "C" {
 int unit_convert(const char *from, const char *to, double *pValue);
 int unit_convert_ex(UNIT *from, UNIT *to, double *pValue);
 int unit_convert_complex(UNIT *from, UNIT *to, complex *pValue);
+int unit_conversion(UNIT *from, UNIT *to, UNITCONVERSION *conv);
 UNIT *unit_find(const char *);
 int unit_test(void);
 
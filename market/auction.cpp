@@ -11,6 +11,8 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <errno.h>
+#include <vector>
+#include <algorithm>
 
 #include "gridlabd.h"
 #include "auction.h"
@@ -258,6 +260,12 @@ int auction::init(OBJECT *parent)
 		}
 	}
 
+	/* with more than one thread, bids are staged per thread and merged in key order when the market clears */
+	char threads[32];
+	staged = gl_global_getvar("threadcount",threads,sizeof(threads))!=NULL && atoi(threads)!=1;
+	stages = NULL;
+	stage_seq = 0;
+
 	if(trans_log[0] != 0){
 		time_t now = time(NULL);
 		trans_file = fopen(trans_log, "w");
@@ -358,6 +366,17 @@ int auction::init(OBJECT *parent)
 			if(capacity_reference_object->rank >= obj->rank){
 				obj->rank = capacity_reference_object->rank + 1;
 			}
+			/* resolve the unit conversion once instead of parsing the unit names at every clearing */
+			if(capacity_reference_property->unit != 0 && strcmp(unit, "") != 0){
+				UNIT *market_unit = gl_find_unit(unit.get_string());
+				if(market_unit == NULL || gl_unit_conversion(capacity_reference_property->unit, market_unit, &capacity_reference_conversion) == 0){
+					gl_error("%s (auction:%d) capacity_reference_property %s uses units of %s and is incompatible with auction units (%s)", obj->name?obj->name:"anonymous", obj->id, capacity_reference_propname.get_string(), capacity_reference_property->unit->name, unit.get_string());
+					/* TROUBLESHOOT
+						If capacity_reference_property has units specified, the units must be convertable to the units used by its auction object.
+						*/
+					return 0;
+				}
+			}
 		} else {
 			gl_error("%s (auction:%d) capacity_reference_object specified without a reference property", obj->name?obj->name:"anonymous", obj->id);
 			/* TROUBLESHOOT
@@ -428,6 +447,28 @@ int auction::init(OBJECT *parent)
 		return 0;
 	}
 	STATISTIC *stat;
+	// statistics over the same span of clearings share one running window
+	window_count = 0;
+	if(statistic_count > 0){
+		unsigned int n = 0, w = 0;
+		windows = (STATWINDOW *)malloc(sizeof(STATWINDOW) * statistic_count);
+		stat_window = (unsigned int *)malloc(sizeof(unsigned int) * statistic_count);
+		for(stat = stats; stat != NULL; stat = stat->next, ++n){
+			uint32 sample_need = (uint32)(stat->interval / this->period);
+			for(w = 0; w < window_count; ++w){
+				if(windows[w].sample_need == sample_need && windows[w].stat_mode == stat->stat_mode){
+					break;
+				}
+			}
+			if(w == window_count){
+				memset(windows + w, 0, sizeof(STATWINDOW));
+				windows[w].sample_need = sample_need;
+				windows[w].stat_mode = stat->stat_mode;
+				++window_count;
+			}
+			stat_window[n] = w;
+		}
+	}
 	for(stat = stats; stat != NULL; stat = stat->next){
 		double check = 0.0;
 		if(stat->stat_type == SY_STDEV){
@@ -531,16 +572,89 @@ int auction::init_statistics()
 	return 1;
 }
 
+/* true if the clearing at history index idx is left out of the statistics */
+bool auction::skip_statistic(unsigned int idx) const
+{
+	if( (ignore_pricecap == IP_TRUE) && ((new_prices[idx] == pricecap) || (new_prices[idx] == -pricecap))){
+		return true;
+	} else if( (ignore_failedmarket == IFM_TRUE) && (new_market_failures[idx] == CT_FAILURE) )  {
+		return true;
+	}
+	return false;
+}
+
+/* Move a statistic window to the latest clearing.  When the market advanced by one clearing the oldest
+   price is dropped and the newest added to the running mean and squared deviation, otherwise (and once
+   every history_count updates, so rounding does not accumulate) the window is summed again. */
+void auction::update_window(STATWINDOW *window)
+{
+	unsigned int stop = 0;
+	unsigned int start = 0;
+	unsigned int i = 0;
+	unsigned int idx = 0;
+	double x = 0.0;
+	if(window->stat_mode == ST_CURR){
+		stop = price_index;
+	} else if(window->stat_mode == ST_PAST){
+		stop = price_index - 1;
+	}
+	start = (unsigned int)((history_count + stop - window->sample_need) % history_count); // one off for initial period delay
+	if(window->valid && start == window->start){
+		return;
+	}
+	if(window->valid && window->steps < history_count && start == (window->start + 1) % history_count){
+		idx = window->start;
+		if(!skip_statistic(idx)){
+			if(window->count > 1){
+				x = new_prices[idx] - window->mean;
+				--window->count;
+				window->mean -= x / window->count;
+				window->m2 -= x * (new_prices[idx] - window->mean);
+			} else {
+				window->count = 0;
+				window->mean = window->m2 = 0.0;
+			}
+		}
+		idx = (window->start + window->sample_need) % history_count;
+		if(!skip_statistic(idx)){
+			x = new_prices[idx] - window->mean;
+			++window->count;
+			window->mean += x / window->count;
+			window->m2 += x * (new_prices[idx] - window->mean);
+		}
+		++window->steps;
+	} else {
+		window->count = 0;
+		window->mean = window->m2 = 0.0;
+		for(i = 0; i < window->sample_need; ++i){
+			idx = (start + i) % history_count;
+			if(!skip_statistic(idx)){
+				window->mean += new_prices[idx];
+				++window->count;
+			}
+		}
+		if(window->count > 0){
+			window->mean /= window->count;
+		}
+		for(i = 0; i < window->sample_need; ++i){
+			idx = (start + i) % history_count;
+			if(!skip_statistic(idx)){
+				x = new_prices[idx] - window->mean;
+				window->m2 += x * x;
+			}
+		}
+		window->steps = 0;
+	}
+	window->start = start;
+	window->valid = true;
+}
+
 int auction::update_statistics(){
 	OBJECT *obj = OBJECTHDR(this);
 	STATISTIC *current = 0;
-	uint32 sample_need = 0;
-	unsigned int start = 0, stop = 0;
-	unsigned int i = 0;
-	unsigned int idx = 0;
-	unsigned int skipped = 0;
+	STATWINDOW *window = 0;
+	unsigned int n = 0;
 	double mean = 0.0;
-	double stdev = 0.0;
 	if(statistic_count < 1){
 		return 1; // no statistics
 	}
@@ -553,27 +667,13 @@ int auction::update_statistics(){
 	if(stats == 0){
 		return 1; // should've been caught with statistic_count < 1
 	}
-	for(current = stats; current != 0; current = current->next){
-		mean = 0.0;
-		sample_need = (uint32)(current->interval / this->period);
-		if(current->stat_mode == ST_CURR){
-			stop = price_index;
-		} else if(current->stat_mode == ST_PAST){
-			stop = price_index - 1;
-		}
-		start = (unsigned int)((history_count + stop - sample_need) % history_count); // one off for initial period delay
-		for(i = 0; i < sample_need; ++i){
-			idx = (start + i + history_count) % history_count;
-			if( (ignore_pricecap == IP_TRUE) && ((new_prices[idx] == pricecap) || (new_prices[idx] == -pricecap))){
-				++skipped;
-			} else if( (ignore_failedmarket == IFM_TRUE) && (new_market_failures[idx] == CT_FAILURE) )  {
-				++skipped;
-			} else {
-				mean += new_prices[idx];
-			}
-		}
-		if(skipped != sample_need){
-			mean /= (sample_need - skipped);
+	for(n = 0; n < window_count; ++n){
+		update_window(windows + n);
+	}
+	for(current = stats, n = 0; current != 0; current = current->next, ++n){
+		window = windows + stat_window[n];
+		if(window->count > 0){
+			mean = window->mean;
 		} else {
 			mean = 0; // problem!
 			gl_warning("All values in auction statistic calculations were skipped. Setting mean to zero.");
@@ -589,31 +689,16 @@ int auction::update_statistics(){
 		if(current->stat_type == SY_MEAN){
 			current->value = mean;
 		} else if(current->stat_type == SY_STDEV){
-			double x = 0.0;
-			if(sample_need + (current->stat_mode == ST_PAST ? 1 : 0) > total_samples){ // extra sample for 'past' values
+			if(window->sample_need + (current->stat_mode == ST_PAST ? 1 : 0) > total_samples){ // extra sample for 'past' values
 				//	still in initial period, use init_stdev
 				current->value = init_stdev;
+			} else if(window->count > 0){
+				// deviation about the reported mean, which differs from the window mean only for future_mean_price
+				double x = window->mean - mean;
+				double var = window->m2 / window->count + x * x;
+				current->value = sqrt(var > 0.0 ? var : 0.0);
 			} else {
-				stdev = 0.0;
-				for(i = 0; i < sample_need; ++i){
-					idx = (start + i + history_count) % history_count;
-					if( (ignore_pricecap == IP_TRUE) && ((new_prices[idx] == pricecap) || (new_prices[idx] == -pricecap))){
-						// Ignore the value
-					}
-					else if( (ignore_failedmarket == IFM_TRUE) && (new_market_failures[idx] == CT_FAILURE) ) {
-						// Ignore the value
-					}
-					else {
-						x = new_prices[idx] - mean;
-						stdev += x * x;
-					}
-				}
-				if(skipped != sample_need){
-					stdev /= (sample_need - skipped);
-				} else {
-					stdev = 0; // problem!
-				}
-				current->value = sqrt(stdev);
+				current->value = 0; // problem!
 			}
 		}
 		if(statistic_mode == ST_ON){
@@ -788,6 +873,7 @@ TIMESTAMP auction::presync(TIMESTAMP t0, TIMESTAMP t1)
 
 		/* clear market */
 		thishr = dt.hour;
+		if (staged) merge_bids();
 		clear_market();
 
 		// advance market_id
@@ -897,14 +983,8 @@ void auction::clear_market(void)
 
 		if(strcmp(unit, "") != 0){
 			if(capacity_reference_property->unit != 0){
-				if(gl_convert(capacity_reference_property->unit->name,unit.get_string(),&refload) == 0){
-					char msg[256];
-					sprintf(msg, "capacity_reference_property %s uses units of %s and is incompatible with auction units (%s)", gl_name(linkref,name,sizeof(name)), capacity_reference_property->unit->name, unit.get_string());
-					throw msg;
-					/* TROUBLESHOOT
-						If capacity_reference_property has units specified, the units must be convertable to the units used by its auction object.
-						*/
-				} else if (verbose){
+				refload = unit_apply(&capacity_reference_conversion, refload);
+				if (verbose){
 					gl_output("capacity_reference_property converted %.3f %s to %.3f %s", *pRefload, capacity_reference_property->unit->name, refload, unit.get_string());
 				}
 			} // else assume same units
@@ -930,7 +1010,7 @@ void auction::clear_market(void)
 		}
 		else if (unresponsive.quantity > 0.001)
 		{
-			submit_nolock(unresponsive.from, -unresponsive.quantity, unresponsive.price, unresponsive.bid_id, BS_ON, false, market_id);
+			submit_nolock(unresponsive.from, -unresponsive.quantity, unresponsive.price, unresponsive.bid_id, BS_ON, false, market_id, gl_globalclock);
 			gl_verbose("capacity_reference_property %s has %.3f unresponsive load", gl_name(linkref,name,sizeof(name)), -unresponsive.quantity);
 		}
 	}
@@ -948,14 +1028,9 @@ void auction::clear_market(void)
 		caprefq = *pCaprefq;
 		if(strcmp(unit, "") != 0) {
 			if (capacity_reference_property->unit != 0) {
-				if(gl_convert(capacity_reference_property->unit->name,unit.get_string(),&caprefq) == 0) {
-					char msg[256];
-					sprintf(msg, "capacity_reference_property %s uses units of %s and is incompatible with auction units (%s)", capacity_reference_property->name, capacity_reference_property->unit->name, unit.get_string());
-					throw msg;
-				} else {
-					submit_nolock((const char *)OBJECTHDR(this)->name, max_capacity_reference_bid_quantity, capacity_reference_bid_price, (int64)OBJECTHDR(this)->id, BS_ON, false, market_id);
-					if (verbose) gl_output("Capacity reference object: %s bids %.2f at %.2f", capacity_reference_object->name, max_capacity_reference_bid_quantity, capacity_reference_bid_price);
-				}
+				caprefq = unit_apply(&capacity_reference_conversion, caprefq);
+				submit_nolock((const char *)OBJECTHDR(this)->name, max_capacity_reference_bid_quantity, capacity_reference_bid_price, (int64)OBJECTHDR(this)->id, BS_ON, false, market_id, gl_globalclock);
+				if (verbose) gl_output("Capacity reference object: %s bids %.2f at %.2f", capacity_reference_object->name, max_capacity_reference_bid_quantity, capacity_reference_bid_price);
 			}
 		}
 	}
@@ -1451,7 +1526,7 @@ void auction::clear_market(void)
 	}
 }
 
-void auction::record_bid(const char *from, double quantity, double real_price, BIDDERSTATE state)
+void auction::record_bid(const char *from, double quantity, double real_price, BIDDERSTATE state, TIMESTAMP submit_time)
 {
 	const char *unkState = "unknown";
 	const char *offState = "off";
@@ -1462,7 +1537,6 @@ void auction::record_bid(const char *from, double quantity, double real_price, B
 	const char *pState = NULL;
 	const char *tStr;
 	DATETIME dt;
-	TIMESTAMP submit_time = gl_globalclock;
 	if(trans_file){ // copied from version below
 		if((this->trans_log_max <= 0) || (trans_log_count > 0)){
 			gl_localtime(submit_time,&dt);
@@ -1489,15 +1563,93 @@ void auction::record_bid(const char *from, double quantity, double real_price, B
 	}
 }
 
-int auction::submit(const char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id)
+int auction::submit(const char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id, bool *accepted)
 {
+	if (staged && mkt_id == market_id)
+	{
+		/* bids into the open market wait in this thread's stage until the market clears */
+		BIDSTAGE *stage = get_stage();
+		::wlock(&stage->lock);
+		if (stage->n == stage->size)
+		{
+			stage->size = stage->size ? stage->size*2 : 64;
+			stage->bid = (STAGEDBID*)realloc(stage->bid,sizeof(STAGEDBID)*stage->size);
+		}
+		STAGEDBID *item = stage->bid + stage->n++;
+		strncpy(item->from,from?from:"",sizeof(item->from)-1);
+		item->from[sizeof(item->from)-1] = '\0';
+		item->quantity = quantity;
+		item->price = real_price;
+		item->key = key;
+		item->state = state;
+		item->rebid = rebid;
+		item->market_id = mkt_id;
+		item->submit_time = gl_globalclock;
+		item->seq = (unsigned int64)atomic_increment(&stage_seq);
+		item->accepted = accepted;
+		::wunlock(&stage->lock);
+		return 1;
+	}
 	gld_wlock lock(my());
-	return submit_nolock(from,quantity,real_price,key,state, rebid, mkt_id);
+	return submit_nolock(from,quantity,real_price,key,state, rebid, mkt_id, gl_globalclock);
 }
-int auction::submit_nolock(const char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id)
+
+/* find the calling thread's stage, adding one the first time the thread bids into this auction */
+BIDSTAGE *auction::get_stage(void)
+{
+	static thread_local std::vector<BIDSTAGE*> mine;
+	for (std::vector<BIDSTAGE*>::iterator i = mine.begin(); i != mine.end(); i++)
+	{
+		if ((*i)->owner == this)
+			return *i;
+	}
+	BIDSTAGE *stage = new BIDSTAGE;
+	stage->owner = this;
+	stage->lock = 0;
+	stage->bid = NULL;
+	stage->n = stage->size = 0;
+	{
+		gld_wlock lock(my());
+		stage->next = stages;
+		stages = stage;
+	}
+	mine.push_back(stage);
+	return stage;
+}
+
+static bool staged_order(const STAGEDBID &a, const STAGEDBID &b)
+{
+	return a.key < b.key || (a.key == b.key && a.seq < b.seq);
+}
+
+/* submit the staged bids ordered by bidder key, so the curves do not depend on thread scheduling */
+void auction::merge_bids(void)
+{
+	/* take each stage's bids under its lock, since bidders in the same rank may still be adding to it */
+	std::vector<STAGEDBID> list;
+	for (BIDSTAGE *stage = stages; stage != NULL; stage = stage->next)
+	{
+		::wlock(&stage->lock);
+		list.insert(list.end(), stage->bid, stage->bid + stage->n);
+		stage->n = 0;
+		::wunlock(&stage->lock);
+	}
+	std::sort(list.begin(), list.end(), staged_order);
+	for (std::vector<STAGEDBID>::iterator item = list.begin(); item != list.end(); item++)
+	{
+		if (submit_nolock(item->from,item->quantity,item->price,item->key,item->state,item->rebid,item->market_id,item->submit_time) == 0)
+		{
+			/* the bidder reads this on its next pass, as it would have right after an unstaged submit */
+			if (item->accepted != NULL)
+				*(item->accepted) = false;
+			warning("rejected the bid from %s for market %d", item->from, (int32)item->market_id);
+		}
+	}
+}
+
+int auction::submit_nolock(const char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id, TIMESTAMP submit_time)
 {
 	char myname[64];
-	TIMESTAMP submit_time = gl_globalclock;
 	DATETIME dt;
 	double price;
 	gl_localtime(submit_time,&dt);
@@ -1571,7 +1723,7 @@ int auction::submit_nolock(const char *from, double quantity, double real_price,
 			return 0;
 		}
 
-		record_bid(from, quantity, real_price, state);
+		record_bid(from, quantity, real_price, state, submit_time);
 		return 1;
 	} 
 	else if (mkt_id == market_id && rebid == false)
@@ -1597,7 +1749,7 @@ int auction::submit_nolock(const char *from, double quantity, double real_price,
 		biddef.bid_type = (quantity > 0 ? BID_SELL : BID_BUY);
 		write_bid(out, biddef.market, biddef.bid, biddef.bid_type);
 		// interject transaction log file writing here
-		record_bid(from, quantity, real_price, state);
+		record_bid(from, quantity, real_price, state, submit_time);
 		biddef.raw = out;
 		return 1;
 	} else { // key between cleared market and 'market_id' ~ points to an old market
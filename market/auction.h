@@ -26,6 +26,18 @@ typedef struct s_statistic {
 	struct s_statistic *next;
 } STATISTIC;
 
+/** running clearing price window shared by the statistics with the same span */
+typedef struct s_statwindow {
+	uint32 sample_need;	/**< number of clearings in the window */
+	STATMODE stat_mode;
+	bool valid;
+	unsigned int start;	/**< history index of the oldest clearing in the window */
+	unsigned int steps;	/**< incremental updates since the window was last summed */
+	uint32 count;		/**< clearings in the window that are not skipped */
+	double mean;
+	double m2;			/**< sum of squared deviations from mean */
+} STATWINDOW;
+
 typedef struct s_market_frame{
 	int64 market_id;
 	TIMESTAMP start_time;
@@ -45,6 +57,29 @@ typedef struct s_market_frame{
 	double *statistics;
 } MARKETFRAME;
 
+/** bid held by a sync thread until the auction next clears */
+typedef struct s_stagedbid {
+	char from[64];
+	double quantity;
+	double price;
+	KEY key;
+	BIDDERSTATE state;
+	bool rebid;
+	int64 market_id;
+	TIMESTAMP submit_time;
+	unsigned int64 seq;	/**< submission order, only compared between bids with the same key */
+	bool *accepted;	/**< bidder's acceptance flag, cleared if the auction rejects the bid when it merges */
+} STAGEDBID;
+
+/** bids staged by one thread for one auction */
+typedef struct s_bidstage {
+	class auction *owner;
+	LOCKVAR lock;	/**< held while the owning thread appends and while the auction takes the bids */
+	STAGEDBID *bid;
+	unsigned int n, size;
+	struct s_bidstage *next;
+} BIDSTAGE;
+
 typedef enum {
 	AM_NONE=0,
 	AM_DENY=1,
@@ -69,10 +104,12 @@ private:
 	// functions
 	int init_statistics();
 	int update_statistics();
+	bool skip_statistic(unsigned int idx) const;
+	void update_window(STATWINDOW *window);
 	int push_market_frame(TIMESTAMP t1);
 	int check_next_market(TIMESTAMP t1);
 	TIMESTAMP pop_market_frame(TIMESTAMP t1);
-	void record_bid(const char *from, double quantity, double real_price, BIDDERSTATE state);
+	void record_bid(const char *from, double quantity, double real_price, BIDDERSTATE state, TIMESTAMP submit_time);
 	void record_curve(double, double);
 	// variables
 	curve asks;			/**< demand curve */ 
@@ -110,6 +147,7 @@ public:
 	OBJECT *capacity_reference_object;
 	char32 capacity_reference_propname;
 	PROPERTY *capacity_reference_property;
+	UNITCONVERSION capacity_reference_conversion; // capacity reference unit to market unit, resolved in init
 	double capacity_reference_bid_price; // the bid price the capacity reference bids
 	double max_capacity_reference_bid_quantity; // the maximum bid quantity
 	double capacity_reference_bid_quantity; // the bid quantity the capacity reference bids
@@ -121,6 +159,9 @@ public:
 	double *new_prices;
 	double *new_market_failures; //0 indicates it did NOT fail, 1 indicates failure
 	double *statdata;
+	STATWINDOW *windows;
+	unsigned int window_count;
+	unsigned int *stat_window;	/**< window used by each statistic */
 	unsigned int price_index;
 	unsigned int64 price_count;
 	uint32 history_count;
@@ -154,9 +195,15 @@ private:
 	FILE *curve_file;
 	int64 curve_log_count;
 public:
-	int submit(const char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id);
+	int submit(const char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id, bool *accepted=NULL);
 private:
-	int submit_nolock(const char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id);
+	int submit_nolock(const char *from, double quantity, double real_price, KEY key, BIDDERSTATE state, bool rebid, int64 mkt_id, TIMESTAMP submit_time);
+	// bids from parallel sync passes
+	bool staged;		/**< stage bids per thread instead of locking the auction */
+	BIDSTAGE *stages;
+	LOCKVAR stage_seq;
+	BIDSTAGE *get_stage(void);
+	void merge_bids(void);
 public:
 	TIMESTAMP nextclear() const;
 private:
@@ -17,11 +17,23 @@ EXPORT void submit_bid_state(const char *from, const char *to, const char *funct
 	int rv;
 	OBJECT *obj = NULL;
 	BIDINFO *bidding_info = (BIDINFO *)bidding_buffer;
+	// bidders submit to the same market every time, so keep the last market found on this thread
+	static thread_local char last_to[64] = "";
+	static thread_local OBJECT *last_obj = NULL;
 	if( strncmp(function_name, "submit_bid_state", 16)== 0){
-		obj = gl_get_object(to);
+		if ( last_obj != NULL && strcmp(to,last_to) == 0 )
+			obj = last_obj;
+		else {
+			obj = gl_get_object(to);
+			if ( obj != NULL && strlen(to) < sizeof(last_to) ) {
+				strcpy(last_to,to);
+				last_obj = obj;
+			}
+		}
 		if( obj == NULL){
 			gl_error("bid::submit_bid_state: No market object exists with given name %s.", to);
 			bidding_info->bid_accepted = false;
+			return;
 		}
 
 		if (obj->oclass==auction::oclass)
@@ -29,11 +41,11 @@ EXPORT void submit_bid_state(const char *from, const char *to, const char *funct
 			if(bidding_info->state == BS_UNKNOWN) {// not a stateful bid
 				gl_verbose("%s submits stateless bid for Q:%.2f at P:%.4f", from,bidding_info->quantity,bidding_info->price);
 				auction *mkt = OBJECTDATA(obj,auction);
-				rv = mkt->submit(from,bidding_info->quantity,bidding_info->price,bidding_info->bid_id,bidding_info->state,bidding_info->rebid, bidding_info->market_id);
+				rv = mkt->submit(from,bidding_info->quantity,bidding_info->price,bidding_info->bid_id,bidding_info->state,bidding_info->rebid, bidding_info->market_id, &bidding_info->bid_accepted);
 			} else {
 				gl_verbose("%s submits stateful (%s) bid for Q:%.2f at P:%.4f", from,bidding_info->state,bidding_info->quantity,bidding_info->price);
 				auction *mkt = OBJECTDATA(obj,auction);
-				rv = mkt->submit(from,bidding_info->quantity,bidding_info->price,bidding_info->bid_id,bidding_info->state,bidding_info->rebid, bidding_info->market_id);
+				rv = mkt->submit(from,bidding_info->quantity,bidding_info->price,bidding_info->bid_id,bidding_info->state,bidding_info->rebid, bidding_info->market_id, &bidding_info->bid_accepted);
 			}
 			if(rv == 0) {
 				bidding_info->bid_accepted = false;
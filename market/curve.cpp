@@ -10,6 +10,9 @@ curve::curve(void)
 	bids = NULL;
 	keys = NULL;
 	bid_ids = NULL;
+	work = NULL;
+	index = NULL;
+	index_len = 0;
 	n_bids = 0;
 	total = 0;
 }
@@ -19,6 +22,8 @@ curve::~curve(void)
 	delete [] bids;
 	delete [] keys;
 	delete [] bid_ids;
+	delete [] work;
+	delete [] index;
 }
 
 void curve::clear(void)
@@ -27,6 +32,10 @@ void curve::clear(void)
 	total = 0;
 	total_on = 0;
 	total_off = 0;
+	if ( index != NULL )
+	{
+		memset(index,0,sizeof(BIDINDEX)*index_len);
+	}
 }
 
 BID *curve::getbid(KEY n)
@@ -34,35 +43,91 @@ BID *curve::getbid(KEY n)
 	return bids+keys[n];
 }
 
-KEY curve::submit(BID *bid)
+/* grow the bid list, keeping the bid id table at least twice as long as the list */
+void curve::grow(void)
 {
-	if (len==0) // create the bid list
-	{
-		len = 8;
-		bids = new BID[len];
-		keys = new KEY[len];
-		bid_ids = new KEY[len];
-	}
-	else if (n_bids==len) // grow the bid list
+	int newlen = ( len == 0 ? 8 : len*2 );
+	BID *newbids = new BID[newlen];
+	KEY *newkeys = new KEY[newlen];
+	KEY *newbid_ids = new KEY[newlen];
+	if ( len > 0 )
 	{
-		BID *newbids = new BID[len*2];
-		KEY *newkeys = new KEY[len*2];
-		KEY *newbid_ids = new KEY[len*2];
 		memcpy(newbids,bids,len*sizeof(BID));
 		memcpy(newkeys,keys,len*sizeof(KEY));
 		memcpy(newbid_ids,bid_ids,len*sizeof(KEY));
-		delete[] bids;
-		delete[] keys;
-		delete[] bid_ids;
-		bids = newbids;
-		keys = newkeys;
-		bid_ids = newbid_ids;
-		len*=2;
+	}
+	delete[] bids;
+	delete[] keys;
+	delete[] bid_ids;
+	delete[] work;
+	delete[] index;
+	bids = newbids;
+	keys = newkeys;
+	bid_ids = newbid_ids;
+	work = new KEY[newlen];
+	len = newlen;
+	index_len = len*2;
+	index = new BIDINDEX[index_len];
+	memset(index,0,sizeof(BIDINDEX)*index_len);
+	for ( int i = 0 ; i < n_bids ; i++ )
+	{
+		index_bid(i);
+	}
+}
+
+static inline int hash_bid(KEY bid_id, int index_len)
+{
+	// index_len is a power of 2
+	return (int)((((uint64)bid_id)*0x9E3779B97F4A7C15ULL)>>32) & (index_len-1);
+}
+
+/* add the bid at position n to the bid id table */
+void curve::index_bid(int n)
+{
+	int h = hash_bid(bid_ids[n],index_len);
+	while ( index[h].n != 0 )
+	{
+		if ( index[h].bid_id == bid_ids[n] )
+		{
+			index[h].n = -1;
+			return;
+		}
+		h = (h+1) & (index_len-1);
+	}
+	index[h].bid_id = bid_ids[n];
+	index[h].n = n+1;
+}
+
+/* find the position of a bid id, or -1 if it is not in the curve, or -2 if more than one bid has that id */
+int curve::find_bid(KEY bid_id)
+{
+	if ( index == NULL )
+	{
+		return -1;
+	}
+	int h = hash_bid(bid_id,index_len);
+	while ( index[h].n != 0 )
+	{
+		if ( index[h].bid_id == bid_id )
+		{
+			return index[h].n < 0 ? -2 : index[h].n-1;
+		}
+		h = (h+1) & (index_len-1);
+	}
+	return -1;
+}
+
+KEY curve::append(BID *bid)
+{
+	if ( n_bids == len )
+	{
+		grow();
 	}
 	keys[n_bids] = n_bids;
 	bid_ids[n_bids] = bid->bid_id;
 	BID *next = bids + n_bids;
 	*next = *bid;
+	index_bid(n_bids);
 
 	/* handle bid state */
 	switch (bid->state) 
@@ -81,74 +146,25 @@ KEY curve::submit(BID *bid)
 	return n_bids++;
 }
 
+KEY curve::submit(BID *bid)
+{
+	return append(bid);
+}
+
 KEY curve::resubmit(BID *bid)
 {
-	int i = 0;
-	int bid_index = 0;
-	int bid_hitcount = 0;
-	for ( i = 0; i < n_bids; i++) 
+	int bid_index = find_bid(bid->bid_id);
+	if ( bid_index == -2 ) 
 	{
-		if ( bid_ids[i] == bid->bid_id ) 
-		{
-			if ( bid_hitcount == 1 ) 
-			{
-				gl_error("curve::resubmit - There is more than one bid with the same bid id in the bid curve.");
-				return -1;
-			}
-			bid_index = i;
-			bid_hitcount++;
-		}
+		gl_error("curve::resubmit - There is more than one bid with the same bid id in the bid curve.");
+		return -1;
 	}
-	if ( bid_hitcount == 0 ) 
+	else if ( bid_index == -1 ) 
 	{
 		gl_warning("The bid was flagged as a rebid but there is no bid in the bid curve with the bid id provided. Submitting the bid.");
-		if ( len == 0 ) 
-		{
-			// create the bid list
-			len = 8;
-			bids = new BID[len];
-			keys = new KEY[len];
-			bid_ids = new KEY[len];
-		}
-		else if ( n_bids == len ) 
-		{
-			// grow the bid list
-			BID *newbids = new BID[len*2];
-			KEY *newkeys = new KEY[len*2];
-			KEY *newbid_ids = new KEY[len*2];
-			memcpy(newbids,bids,len*sizeof(BID));
-			memcpy(newkeys,keys,len*sizeof(KEY));
-			memcpy(newbid_ids,bid_ids,len*sizeof(KEY));
-			delete[] bids;
-			delete[] keys;
-			delete[] bid_ids;
-			bids = newbids;
-			keys = newkeys;
-			bid_ids = newbid_ids;
-			len*=2;
-		}
-		keys[n_bids] = n_bids;
-		bid_ids[n_bids] = bid->bid_id;
-		BID *next = bids + n_bids;
-		*next = *bid;
-
-		/* handle bid state */
-		switch (bid->state) 
-		{
-		case BS_OFF:
-			total_off += bid->quantity;
-			break;
-		case BS_ON:
-			total_on += bid->quantity;
-			break;
-		default:
-			break;
-		}
-		total += bid->quantity;
-
-		return n_bids++;
+		return append(bid);
 	} 
-	else if ( bid_index < n_bids ) 
+	else
 	{
 		/* undo effect of old state */
 		BID *old = &(bids[keys[bid_index]]);
@@ -183,32 +199,18 @@ KEY curve::resubmit(BID *bid)
 		total += bid->quantity;
 		return bid_index;
 	} 
-	else 
-	{
-		gl_error("curve::resubmit - the bid failed to be captured in the curve.");
-		return -1;
-	}
 }
 //This function is for removing a from a curve if the rebid places the bidder in the opposite curve.(i.e. switching from a seller to a buyer or vice versa)
 int curve::remove_bid(KEY bid_id)
 {
-	int i = 0;
-	int bid_index = 0;
-	int bid_hitcount = 0;
-	for ( i = 0 ; i < n_bids ; i++ ) 
+	int i = 0, j = 0;
+	int bid_index = find_bid(bid_id);
+	if ( bid_index == -2 ) 
 	{
-		if ( bid_ids[i] == bid_id ) 
-		{
-			if ( bid_hitcount == 1 ) 
-			{
-				gl_error("curve::resubmit - There is more than one bid with the same bid id in the bid curve.");
-				return -1;
-			}
-			bid_index = i;
-			bid_hitcount++;
-		}
+		gl_error("curve::resubmit - There is more than one bid with the same bid id in the bid curve.");
+		return -1;
 	}
-	if ( bid_index < n_bids && bid_hitcount == 1 ) 
+	else if ( bid_index >= 0 ) 
 	{
 		/* undo effect of old state */
 		BID *old = &(bids[keys[bid_index]]);
@@ -225,32 +227,25 @@ int curve::remove_bid(KEY bid_id)
 		}
 		total -= old->quantity;
 
-		/* copy all other bids into new curve */
-		BID *newbids = new BID[len];
-		KEY *newkeys = new KEY[len];
-		KEY *newbid_ids = new KEY[len];
-		for ( i = 0 ; i <= len ; i++ )
+		/* close the gap left by the bid and renumber the keys that follow it */
+		KEY removed = keys[bid_index];
+		memmove(bids+removed,bids+removed+1,(n_bids-removed-1)*sizeof(BID));
+		memmove(bid_ids+bid_index,bid_ids+bid_index+1,(n_bids-bid_index-1)*sizeof(KEY));
+		for ( i = 0 ; i < n_bids ; i++ )
 		{
-			if ( i < bid_index )
-			{
-				newkeys[i] = keys[i];
-				newbids[i] = bids[i];
-				newbid_ids[i] = bid_ids[i];
-			} 
-			else if ( i > bid_index )
+			if ( keys[i] != removed )
 			{
-				newkeys[i-1] = keys[i];
-				newbids[i-1] = bids[i];
-				newbid_ids[i-1] = bid_ids[i];
+				keys[j++] = ( keys[i] > removed ? keys[i]-1 : keys[i] );
 			}
 		}
-		delete[] bids;
-		delete[] keys;
-		delete[] bid_ids;
-		bids = newbids;
-		keys = newkeys;
-		bid_ids = newbid_ids;
 		n_bids--;
+
+		/* rebuild the bid id table */
+		memset(index,0,sizeof(BIDINDEX)*index_len);
+		for ( i = 0 ; i < n_bids ; i++ )
+		{
+			index_bid(i);
+		}
 		return n_bids;
 	} 
 	else 
@@ -260,20 +255,19 @@ int curve::remove_bid(KEY bid_id)
 }
 void curve::sort(bool reverse)
 {
-	sort(bids, keys, n_bids, reverse);
+	sort(bids, keys, work, n_bids, reverse);
 }
 
-void curve::sort(BID *list, KEY *key, const int len, const bool reverse)
+void curve::sort(BID *list, KEY *key, KEY *work, const int len, const bool reverse)
 {
 	//merge sort
 	if (len>1)
 	{
 		int split = len/2;
 		KEY *a = key, *b = key+split;
-		if (split>1) sort(list,a,split,reverse);
-		if (len-split>1) sort(list,b,len-split,reverse);
-		KEY *res = new KEY[len];
-		KEY *p = res;
+		if (split>1) sort(list,a,work,split,reverse);
+		if (len-split>1) sort(list,b,work,len-split,reverse);
+		KEY *p = work;
 		do {
 			bool altb = list[*a].price < list[*b].price;
 			if ((reverse && !altb) || (!reverse && altb))
@@ -293,8 +287,7 @@ void curve::sort(BID *list, KEY *key, const int len, const bool reverse)
 		{
 			*p++ = *b++;
 		}
-		memcpy(key,res,sizeof(KEY)*len);
-		delete[] res;
+		memcpy(key,work,sizeof(KEY)*len);
 	}
 }
 
@@ -5,6 +5,12 @@
 #ifndef _curve_h_
 #define _curve_h_
 
+/** Position of a bid id in a curve */
+typedef struct s_bidindex {
+	KEY bid_id;
+	int n; ///< position+1 of the bid (0 is empty, -1 is a duplicate bid id)
+} BIDINDEX;
+
 /** Supply/Demand curve */
 class curve {
 private:
@@ -13,11 +19,18 @@ private:
 	BID *bids;
 	KEY *keys;
 	KEY *bid_ids;
+	KEY *work; ///< merge buffer used by sort
+	BIDINDEX *index; ///< open addressed table of bid positions by bid id
+	int index_len;
 	double total;
 	double total_on;
 	double total_off;
 private:
-	static void sort(BID *list, KEY *keys, const int len, const bool reverse);
+	static void sort(BID *list, KEY *keys, KEY *work, const int len, const bool reverse);
+	void grow(void);
+	void index_bid(int n);
+	int find_bid(KEY bid_id);
+	KEY append(BID *bid);
 public:
 	curve(void);
 	~curve(void);
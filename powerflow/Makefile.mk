@@ -45,6 +45,7 @@ powerflow_powerflow_la_SOURCES += powerflow/load.h
 powerflow_powerflow_la_SOURCES += powerflow/load_tracker.cpp
 powerflow_powerflow_la_SOURCES += powerflow/load_tracker.h
 powerflow_powerflow_la_SOURCES += powerflow/main.cpp
+powerflow_powerflow_la_SOURCES += powerflow/matrix_kernel.h
 powerflow_powerflow_la_SOURCES += powerflow/meter.cpp
 powerflow_powerflow_la_SOURCES += powerflow/meter.h
 powerflow_powerflow_la_SOURCES += powerflow/meter_test.h
@@ -82,6 +83,10 @@ powerflow_powerflow_la_SOURCES += powerflow/sectionalizer.cpp
 powerflow_powerflow_la_SOURCES += powerflow/sectionalizer.h
 powerflow_powerflow_la_SOURCES += powerflow/series_reactor.cpp
 powerflow_powerflow_la_SOURCES += powerflow/series_reactor.h
+powerflow_powerflow_la_SOURCES += powerflow/snapshotdump.cpp
+powerflow_powerflow_la_SOURCES += powerflow/snapshotdump.h
+powerflow_powerflow_la_SOURCES += powerflow/solver_fbs.cpp
+powerflow_powerflow_la_SOURCES += powerflow/solver_fbs.h
 powerflow_powerflow_la_SOURCES += powerflow/solver_nr.cpp
 powerflow_powerflow_la_SOURCES += powerflow/solver_nr.h
 powerflow_powerflow_la_SOURCES += powerflow/substation.cpp
@@ -119,3 +124,5 @@ powerflow_powerflow_la_SOURCES += powerflow/voltdump.cpp
 powerflow_powerflow_la_SOURCES += powerflow/voltdump.h
 powerflow_powerflow_la_SOURCES += powerflow/volt_var_control.cpp
 powerflow_powerflow_la_SOURCES += powerflow/volt_var_control.h
+
+dist_pkgdata_DATA += powerflow/snapshotdump.py
@@ -0,0 +1,25 @@
+#!/bin/bash
+# Runs test_NR_predictor.glm with the predictor on and off, then checks that both runs record
+# the same voltages and that only the predictor run reports steps in its solver profile.
+# The binary to run is the first argument, gridlabd when none is given.
+gridlabd=${1:-gridlabd}
+for predictor in true false ; do
+	"$gridlabd" -D PREDICTOR=$predictor ../test_NR_predictor.glm || exit 1
+done
+
+# same timesteps, voltages within 0.01 V
+paste -d, NR_predictor_true_voltage.csv NR_predictor_false_voltage.csv | awk -F, '
+	/^#/ { next }
+	{
+		rows++
+		n = NF/2
+		if ( $1 != $(n+1) ) { print "timestep " $1 " does not match " $(n+1); bad=1; exit }
+		for ( i=2 ; i<=n ; i++ )
+			if ( $i-$(n+i) > 0.01 || $(n+i)-$i > 0.01 ) { print $1 ": column " i " differs, " $i " and " $(n+i); bad=1; exit }
+	}
+	END { if ( bad ) exit 1; if ( rows < 30 ) { print "only " rows " timesteps recorded"; exit 1 } }' || exit 1
+
+# predictor[pu] is the last column of the solver profile
+[ "$(head -1 NR_predictor_true_profile.csv | awk -F, '{print $NF}')" = "predictor[pu]" ] || { echo "solver profile has no predictor[pu] column"; exit 1; }
+awk -F, 'NR>1 && $NF>0 { n++ } END { exit (n>0) ? 0 : 1 }' NR_predictor_true_profile.csv || { echo "predictor run reports no predictor steps"; exit 1; }
+awk -F, 'NR>1 && $NF!=0 { n++ } END { exit (n==0) ? 0 : 1 }' NR_predictor_false_profile.csv || { echo "run without the predictor reports predictor steps"; exit 1; }
@@ -0,0 +1,19 @@
+#!/bin/bash
+# Reads back the snapshots test_snapshotdump.glm wrote and checks the record layout, the
+# admittance matrix and that the delta records rebuild the voltages the voltdumps hold.
+reader="python3 ../../snapshotdump.py"
+
+# one full record with the admittance matrix, then delta records that skip the swing bus
+$reader snapshotdump.snp > snapshotdump_summary.csv || exit 1
+awk -F, '
+	NR==1 { start=$1; if ( $2!=2 || $3!=4 || $4!=3 || $5!=24 || $6==0 ) { print "first record is " $0; bad=1 } next }
+	{ if ( $2!=1 || $3!=3 || $5!=0 ) { print "record " NR " is " $0; bad=1 } }
+	NR==3 && $1-start!=240 { print "record 3 is not at 4 minutes"; bad=1 }
+	END { if ( NR!=5 ) { print NR " records written"; bad=1 } if ( $1-start!=480 ) { print "last record is not at 8 minutes"; bad=1 } exit bad }' snapshotdump_summary.csv || exit 1
+
+# voltages rebuilt from the delta records match the voltdumps
+for dump in 4min:2 8min:4 ; do
+	sed 1,2d snapshotdump_volt_${dump%:*}.csv | sort > volt_${dump%:*}.txt
+	$reader --voltages --record ${dump#*:} snapshotdump.snp | sort > snap_${dump%:*}.txt || exit 1
+	cmp volt_${dump%:*}.txt snap_${dump%:*}.txt || exit 1
+done
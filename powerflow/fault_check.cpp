@@ -71,6 +71,12 @@ int fault_check::create(void)
 
 	associated_grid = NULL;	//Null the array
 
+	island_link_phases = NULL;	//Island forests are built on the first check
+	island_flags = NULL;
+	island_mode = 0;
+
+	alteration_stack = NULL;	//Allocated on the first radial alteration
+
 	grid_association_mode = false;	//By default, we go to normal "Highlander" grid (there can be only one!)
 
 	return result;
@@ -343,249 +349,251 @@ TIMESTAMP fault_check::sync(TIMESTAMP t0)
 }
 
 
-void fault_check::search_links(int node_int)
+//Forest bit for each island forest - phases A, B and C, then grid association
+static const unsigned char island_bits[4] = {0x04, 0x02, 0x01, 0x08};
+
+//Determine which island forests a link currently joins its two ends in
+unsigned char fault_check::island_link_mask(int branch_idx, unsigned char search_mode)
 {
-	unsigned int index, indexb;
-	bool both_handled, from_val, proceed_in;
-	int branch_val = 0;
-	BRANCHDATA temp_branch;
-	unsigned char work_phases;
+	unsigned char link_phases, from_phases, to_phases;
 
-	//Loop through the connectivity and populate appropriately
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)	//parse through our connected link
+	if (search_mode == FC_ISLAND_RADIAL)	//Strictly radial - only the in-service phases carry support
 	{
-		temp_branch = NR_branchdata[NR_busdata[node_int].Link_Table[index]];	//Get connecting link information
+		return (NR_branchdata[branch_idx].phases & 0x07);
+	}
 
-		proceed_in = false;			//Flag that we need to go the next link in
+	//Mesh - switching devices only pass their original phases when closed
+	link_phases = NR_branchdata[branch_idx].phases;
 
-		//Check for no phase condition
-		if ((temp_branch.phases & 0x07) != 0x00)
+	if ((NR_branchdata[branch_idx].lnk_type == 2) || (NR_branchdata[branch_idx].lnk_type == 5) || (NR_branchdata[branch_idx].lnk_type == 6))
+	{
+		if (*NR_branchdata[branch_idx].status == 1)
 		{
-			for (indexb=0; indexb<3; indexb++)	//Handle phases
-			{
-				work_phases = 0x04 >> indexb;	//Pull off the phase reference
-
-				if ((temp_branch.phases & work_phases) == work_phases)	//We are of the proper phase
-				{
-					both_handled = false;	//Reset flag
-
-					//See which end we are, and if the other end has been handled
-					if (temp_branch.from == node_int)	//We're the from
-					{
-						from_val = true;	//Flag us as the from end (so we don't have to check it again later)
-					}
-					else	//Must be the to
-					{
-						from_val = false;	//Flag us as the to end (so we don't have to check it again later)
-					}
-
-					//See if both sides of this link are already set - if so, don't bother going back in
-					if ((Supported_Nodes[temp_branch.to][indexb]==1) && (Supported_Nodes[temp_branch.from][indexb]==1))
-						both_handled=true;
-
-					//If not handled, proceed with logic-ness
-					if (both_handled==false)
-					{
-						//Figure out the indexing so we can tell what we are
-						if (from_val)	//From end
-						{
-							branch_val = temp_branch.to;
-
-							//See if our FROM end is properly supported (paranoia check)
-							if (Supported_Nodes[temp_branch.from][indexb] == 1)
-							{
-								proceed_in = true;		//Flag to progress when done
-							}
-							else
-							{
-								continue;		//Somehow is checking, but neither of our ends are set - skip us for now
-							}
-						}
-						else	//To end
-						{
-							branch_val = temp_branch.from;
+			link_phases |= NR_branchdata[branch_idx].origphases;
+		}
+	}
+	else
+	{
+		link_phases |= NR_branchdata[branch_idx].origphases;
+	}
 
-							//See if our TO end is properly supported (paranoia check)
-							if (Supported_Nodes[temp_branch.to][indexb] == 1)
-							{
-								proceed_in = true;		//Flag to progress when done
-							}
-							else
-							{
-								continue;		//Somehow is checking, but neither of our ends are set - skip us for now
-							}
-						}
+	link_phases &= 0x07;
 
-						//Flag us as connected
-						Supported_Nodes[branch_val][indexb] = 1;
+	//Grid association crosses a link from any node that shares an in-service phase with it, so
+	//the link joins its ends when either one does - a node with no phases left still takes the
+	//grid of the node feeding it
+	if (grid_association_mode == true)
+	{
+		from_phases = NR_busdata[NR_branchdata[branch_idx].from].phases & NR_branchdata[branch_idx].phases & 0x07;
+		to_phases = NR_busdata[NR_branchdata[branch_idx].to].phases & NR_branchdata[branch_idx].phases & 0x07;
 
-					}//End both not handled (work to be done)
-				}//End are a proper phase
-			}//End phase testloop
+		if ((from_phases != 0x00) || (to_phases != 0x00))
+		{
+			link_phases |= 0x08;
+		}
+	}
 
-			if (proceed_in)
-			{
-				//Recursion!!
-				search_links(branch_val);
-			}
-		}//End has phases test loop
-	}//End link table loop
+	return link_phases;
 }
 
-//Mesh searching function -- checks to see how something was removed
-void fault_check::search_links_mesh(int node_int)
+//Bring the island forests up to date - closing links merges islands directly, while a link
+//dropping out of a forest rebuilds just that forest
+void fault_check::update_islands(unsigned char search_mode)
 {
-	unsigned int index, device_value, node_value;
-	unsigned char temp_phases, temp_compare_phases;
+	unsigned int index;
+	int forest;
+	unsigned char removed_bits, new_bits, add_bits;
 
-	//Check our entry mode -- if grid association mode, do this as a recursion
-	if (grid_association_mode == false)	//Nope, do "normally"
+	//Allocate the forests the first time through
+	if (island_link_phases == NULL)
 	{
-		//Loop through our connected nodes
-		for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+		for (forest=0; forest<4; forest++)
 		{
-			//Pull link index -- just for readabiiity
-			device_value = NR_busdata[node_int].Link_Table[index];
+			island_parent[forest] = (unsigned int *)gl_malloc(NR_bus_count*sizeof(unsigned int));
+			island_rank[forest] = (unsigned char *)gl_malloc(NR_bus_count*sizeof(unsigned char));
 
-			//Get our opposite end reference
-			if (node_int == NR_branchdata[device_value].from)
+			if ((island_parent[forest] == NULL) || (island_rank[forest] == NULL))
 			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].to;
-			}
-			else	//Must be the TO side, so check from
-			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].from;
+				GL_THROW("fault_check: failed to allocate the island tracking arrays");
+				/*  TROUBLESHOOT
+				While attempting to allocate the arrays used to track which nodes are connected to each other,
+				an error occurred.  Please try again.  If the error persists, please submit your code and a bug
+				report via the ticketing system.
+				*/
 			}
+		}
 
-			//Get initial phasing information - the ones that are available
-			temp_phases = NR_branchdata[device_value].phases;
+		island_link_phases = (unsigned char *)gl_malloc(NR_branch_count*sizeof(unsigned char));
+		island_flags = (unsigned char *)gl_malloc(NR_bus_count*sizeof(unsigned char));
 
-			//See if either end has any valid phases
-			if ((valid_phases[node_int] != 0x00) || (valid_phases[node_value] != 0x00))
-			{
-				//Are we a switch
-				if ((NR_branchdata[device_value].lnk_type == 2) || (NR_branchdata[device_value].lnk_type == 5) || (NR_branchdata[device_value].lnk_type == 6))
-				{
-					if (*NR_branchdata[device_value].status == 1)
-					{
-						temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-					}
-				}
-				else
-				{
-					temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-				}
-			}
+		if ((island_link_phases == NULL) || (island_flags == NULL))
+		{
+			GL_THROW("fault_check: failed to allocate the island tracking arrays");
+			//Defined above
+		}
 
-			//Populate the phase information
-			valid_phases[node_value] |= (valid_phases[node_int] & temp_phases);
-		}//End of node link table traversion
-	}//End not grid association mode
-	else	//Grid association mode
+		island_mode = 0;	//Force a full build below
+	}
+
+	//See which forests lost a link since the last update
+	if (island_mode != search_mode)	//New mode (or first build) - everything starts over
 	{
-		//Loop through our connected nodes
-		for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+		removed_bits = 0x0F;
+
+		for (index=0; index<NR_branch_count; index++)
 		{
-			//Pull link index -- just for readabiiity
-			device_value = NR_busdata[node_int].Link_Table[index];
+			island_link_phases[index] = 0x00;
+		}
+	}
+	else
+	{
+		removed_bits = 0x00;
 
-			//Get our opposite end reference
-			if (node_int == NR_branchdata[device_value].from)
-			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].to;
-			}
-			else	//Must be the TO side, so check from
+		for (index=0; index<NR_branch_count; index++)
+		{
+			removed_bits |= (island_link_phases[index] & ~island_link_mask(index,search_mode));
+		}
+	}
+
+	//Union-find cannot split an island, so any forest that lost a link is rebuilt from scratch
+	for (forest=0; forest<4; forest++)
+	{
+		if ((removed_bits & island_bits[forest]) != 0x00)
+		{
+			for (index=0; index<NR_bus_count; index++)
 			{
-				//Extract our index
-				node_value = NR_branchdata[device_value].from;
+				island_parent[forest][index] = index;
+				island_rank[forest][index] = 0;
 			}
+		}
+	}
 
-			//Get initial phasing information - the ones that are available
-			temp_phases = NR_branchdata[device_value].phases;
+	//Merge in every link not already represented in its forests
+	for (index=0; index<NR_branch_count; index++)
+	{
+		new_bits = island_link_mask(index,search_mode);
+		add_bits = new_bits & (~island_link_phases[index] | removed_bits);
 
-			//See if either end has any valid phases
-			if ((valid_phases[node_int] != 0x00) || (valid_phases[node_value] != 0x00))
+		if (add_bits != 0x00)
+		{
+			for (forest=0; forest<4; forest++)
 			{
-				//Are we a switch
-				if ((NR_branchdata[device_value].lnk_type == 2) || (NR_branchdata[device_value].lnk_type == 5) || (NR_branchdata[device_value].lnk_type == 6))
-				{
-					if (*NR_branchdata[device_value].status == 1)
-					{
-						temp_phases |= NR_branchdata[device_value].origphases & 0x07;
-					}
-				}
-				else
+				if ((add_bits & island_bits[forest]) != 0x00)
 				{
-					temp_phases |= NR_branchdata[device_value].origphases & 0x07;
+					island_union(forest,NR_branchdata[index].from,NR_branchdata[index].to);
 				}
 			}
+		}
 
-			//Check our "contributions" against the other end - use this to determine recursion
-			temp_compare_phases = (valid_phases[node_value] | (valid_phases[node_int] & temp_phases));
+		island_link_phases[index] = new_bits;
+	}
 
-			//See if it is the same
-			if (valid_phases[node_value] != temp_compare_phases)
-			{
-				//Populate the phase information - store what we just did (no point doing twice)
-				valid_phases[node_value] = temp_compare_phases;
+	island_mode = search_mode;
+}
 
-				//Recurse in, do this node now
-				search_links_mesh(node_value);
-			}
-			//Default else -- they match, so don't bother
-		}//End of node link table traversion
-	}//End grid association mode
+//Find the root of a node's island, halving the path as we go
+unsigned int fault_check::island_find(int forest, unsigned int node_int)
+{
+	unsigned int *parent = island_parent[forest];
+
+	while (parent[node_int] != node_int)
+	{
+		parent[node_int] = parent[parent[node_int]];
+		node_int = parent[node_int];
+	}
+
+	return node_int;
+}
+
+//Merge the islands of two nodes - lower rank root goes under the higher one
+void fault_check::island_union(int forest, unsigned int node_a, unsigned int node_b)
+{
+	unsigned int root_a, root_b;
+
+	root_a = island_find(forest,node_a);
+	root_b = island_find(forest,node_b);
+
+	if (root_a == root_b)
+		return;
+
+	if (island_rank[forest][root_a] < island_rank[forest][root_b])
+	{
+		island_parent[forest][root_a] = root_b;
+	}
+	else
+	{
+		island_parent[forest][root_b] = root_a;
+
+		if (island_rank[forest][root_a] == island_rank[forest][root_b])
+			island_rank[forest][root_a]++;
+	}
+}
+
+//Flag the islands a source node supports, one phase at a time
+void fault_check::flag_sourced_island(unsigned int node_int)
+{
+	int forest;
+
+	for (forest=0; forest<3; forest++)
+	{
+		if ((NR_busdata[node_int].phases & island_bits[forest]) == island_bits[forest])
+		{
+			island_flags[island_find(forest,node_int)] |= island_bits[forest];
+		}
+	}
 }
 
 void fault_check::support_check(int swing_node_int)
 {
-	unsigned int index;
+	unsigned int index, indexb, swing_root;
 	unsigned char phase_vals;
 
 	//Reset the node status list
 	reset_support_check();
 
-	//Swing node has support - if the phase exists (changed for complete faults)
-	for (index=0; index<3; index++)
+	//Make sure the islands reflect the current link phases
+	update_islands(FC_ISLAND_RADIAL);
+
+	//A phase is supported everywhere in the swing node's island for that phase - if the swing has it (changed for complete faults)
+	for (indexb=0; indexb<3; indexb++)
 	{
-		phase_vals = 0x04 >> index;	//Set up phase value
+		phase_vals = 0x04 >> indexb;	//Set up phase value
 
 		if ((NR_busdata[swing_node_int].phases & phase_vals) == phase_vals)	//Has this phase
-			Supported_Nodes[swing_node_int][index] = 1;	//Flag it as supported
-	}
+		{
+			swing_root = island_find(indexb,swing_node_int);
 
-	//Call the node link-erator (node support check) - call it on the swing, the details are handled inside
-	search_links(swing_node_int);
+			for (index=0; index<NR_bus_count; index++)
+			{
+				if (island_find(indexb,index) == swing_root)
+					Supported_Nodes[index][indexb] = 1;	//Flag it as supported
+			}
+		}
+	}
 }
 
 //Mesh-capable version of support check -- by default, it doesn't support restoration object
 void fault_check::support_check_mesh(int swing_node_int)
 {
-	unsigned int indexa, indexb;
+	unsigned int indexa;
+	int forest;
 
 	//Reset the node status list
 	reset_support_check();
 
-	if (grid_association_mode == false)	//Not needing to do grid association, use normal, inefficient method
+	//Make sure the islands reflect the current switch states
+	update_islands(FC_ISLAND_MESH);
+
+	for (indexa=0; indexa<NR_bus_count; indexa++)
 	{
-		//Swing node has support - if the phase exists (changed for complete faults)
-		valid_phases[swing_node_int] = NR_busdata[swing_node_int].phases & 0x07;
+		island_flags[indexa] = 0x00;
+	}
 
-		//Call the node link-erator (node support check) - call it on the swing, the details are handled inside
-		//Supports possibly meshed topology - brute force method
-		for (indexa=0; indexa<NR_bus_count; indexa++)
-		{
-			for (indexb=0; indexb<NR_bus_count; indexb++)
-			{
-				//Call the search link on individual nodes
-				search_links_mesh(indexb);
-			}
-		}
+	if (grid_association_mode == false)	//Not needing to do grid association, just the master swing
+	{
+		flag_sourced_island(swing_node_int);
 	}
-	else	//Grid association mode, do slightly different
+	else	//Grid association mode, any source supports its own islands
 	{
 		//Traverse the whole bus list, just in case (since may be altered in the future)
 		for (indexa=0; indexa<NR_bus_count; indexa++)
@@ -593,20 +601,20 @@ void fault_check::support_check_mesh(int swing_node_int)
 			//See if we're a SWING node
 			if ((NR_busdata[indexa].type == 2) || ((NR_busdata[indexa].type == 3) && (NR_busdata[indexa].swing_functions_enabled == true)) || ((*NR_busdata[indexa].busflag & NF_ISSOURCE) == NF_ISSOURCE))	//SWING node, of some form
 			{
-				//Check and see if we've apparently been "sourced" before
-				if ((NR_busdata[indexa].phases & 0x07) != valid_phases[indexa])	//We don't match, so something came to us, but not the other way
-				{
-					//Extract our phases
-					valid_phases[indexa] |= (NR_busdata[indexa].phases & 0x07);
-
-					//Call the support check
-					search_links_mesh(indexa);
-				}
-				//Default else -- we were already handled
+				flag_sourced_island(indexa);
 			}
 			//Default else -- not a swing
 		}
 	}
+
+	//Each node picks up the phases its islands are supported on
+	for (indexa=0; indexa<NR_bus_count; indexa++)
+	{
+		for (forest=0; forest<3; forest++)
+		{
+			valid_phases[indexa] |= (island_flags[island_find(forest,indexa)] & island_bits[forest]);
+		}
+	}
 }
 
 void fault_check::reset_support_check(void)
@@ -985,7 +993,7 @@ void fault_check::support_check_alterations(int baselink_int, bool rest_mode)
 
 			if ((NR_busdata[base_bus_val].phases & 0x07) != 0x00)	//We have phase, means OK above us
 			{
-				//Recurse our way in - adjusted version of original search_links function above (but no storage, because we don't care now)
+				//Walk our way in - radial search from the base node (but no storage, because we don't care now)
 				support_search_links(base_bus_val, base_bus_val, rest_mode);
 			}
 			else
@@ -995,7 +1003,7 @@ void fault_check::support_check_alterations(int baselink_int, bool rest_mode)
 		{
 			gl_verbose("Alterations support check called removal on bus %s",NR_busdata[base_bus_val].name);
 
-			//Recurse our way in - adjusted version of original search_links function above (but no storage, because we don't care now)
+			//Walk our way in - radial search from the base node (but no storage, because we don't care now)
 			support_search_links(base_bus_val, base_bus_val, rest_mode);
 		}
 	}
@@ -1429,19 +1437,55 @@ void fault_check::special_object_alteration_handle(int branch_idx)
 	}//End "normal" reliability operations
 }
 
-//Recursive function to traverse powerflow and alter phases as necessary
-//Based on search_links code from above
+//Depth-first function to traverse powerflow and alter phases as necessary
+//Walks with an explicit stack (a node is only entered once), so deep feeders can't overflow the call stack
 void fault_check::support_search_links(int node_int, int node_start, bool impact_mode)
 {
-	unsigned int index;
+	unsigned int index, depth;
 	bool both_handled, from_val;
 	int branch_val;
 	BRANCHDATA temp_branch;
 	unsigned char work_phases, phase_restrictions;
 
+	//Allocate the stack the first time through - every node enters at most once, plus the start
+	if (alteration_stack == NULL)
+	{
+		alteration_stack = (FC_SEARCH_FRAME *)gl_malloc((NR_bus_count+1)*sizeof(FC_SEARCH_FRAME));
+
+		if (alteration_stack == NULL)
+		{
+			GL_THROW("fault_check: failed to allocate the alteration search stack");
+			/*  TROUBLESHOOT
+			While attempting to allocate the stack used to walk the system during a reliability alteration,
+			an error occurred.  Please try again.  If the error persists, please submit your code and a bug
+			report via the ticketing system.
+			*/
+		}
+	}
+
+	//Start on the base node
+	depth = 0;
+	alteration_stack[0].node = node_int;
+	alteration_stack[0].link = 0;
+
 	//Loop through the connectivity and populate appropriately
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)	//parse through our connected link
+	while (true)
 	{
+		//Pull the next link of the node on top of the stack
+		node_int = alteration_stack[depth].node;
+		index = alteration_stack[depth].link;
+
+		if (index >= NR_busdata[node_int].Link_Table_Size)	//This node is done, back up to its parent
+		{
+			if (depth == 0)
+				break;
+
+			depth--;
+			continue;
+		}
+
+		alteration_stack[depth].link++;
+
 		temp_branch = NR_branchdata[NR_busdata[node_int].Link_Table[index]];	//Get connecting link information
 
 		both_handled = false;	//Reset flag
@@ -1673,8 +1717,10 @@ void fault_check::support_search_links(int node_int, int node_start, bool impact
 			//Flag us as handled
 			Alteration_Nodes[branch_val] = 1;
 
-			//Recursion!!
-			support_search_links(branch_val,node_start,impact_mode);
+			//Descend into the far end
+			depth++;
+			alteration_stack[depth].node = branch_val;
+			alteration_stack[depth].link = 0;
 		}//End both not handled (work to be done)
 	}//End link table loop
 }
@@ -1904,27 +1950,31 @@ void fault_check::reset_associated_grid(void)
 //Multiple grid checking items - search for SWING nodes as the search entry points, then populate
 void fault_check::associate_grids(void)
 {
-	unsigned int indexval;
+	unsigned int indexval, root_val;
 	int grid_counter;
 
 	//Call the reset/allocation routine
 	reset_associated_grid();
 
+	//Make sure the islands reflect the current phases -- grid association uses its own forest
+	update_islands(FC_ISLAND_MESH);
+
 	//Set the counter
 	grid_counter = 0;
 
-	//Parse the busdata list to find these - enter as we go
+	//Parse the busdata list to find these - grids are tracked on the island roots until the end
 	//Do a full traverse, since this may swap to "just has a source" later
 	for (indexval=0; indexval<NR_bus_count; indexval++)
 	{
 		//See if we're a SWING node
 		if (NR_busdata[indexval].type == 2)	//SWING bus
 		{
-			//See if we're already flagged
-			if (associated_grid[indexval] == -1)	//We're still unparsed
+			root_val = island_find(3,indexval);
+
+			//See if our island is already flagged
+			if (associated_grid[root_val] == -1)	//We're still unparsed
 			{
-				//Call the associater routine
-				search_associated_grids(indexval,grid_counter);
+				associated_grid[root_val] = grid_counter;
 
 				//Increment the counter, when we're done
 				grid_counter++;
@@ -1935,20 +1985,20 @@ void fault_check::associate_grids(void)
 	}
 
 	//Second loop - SWING_PQ check
-	//********* TODO: Better/more efficient way to do this!?!? **********/
 	for (indexval=0; indexval<NR_bus_count; indexval++)
 	{
 		//See if we're a SWING_PQ node
 		if (NR_busdata[indexval].type == 3)	//SWING_PQ bus
 		{
-			//See if we're already flagged
-			if (associated_grid[indexval] == -1)	//We're still unparsed
+			root_val = island_find(3,indexval);
+
+			//See if our island is already flagged
+			if (associated_grid[root_val] == -1)	//We're still unparsed
 			{
 				//Flag us as a swing - to be safe
 				NR_busdata[indexval].swing_functions_enabled = true;
 
-				//Call the associater routine
-				search_associated_grids(indexval,grid_counter);
+				associated_grid[root_val] = grid_counter;
 
 				//Increment the counter, when we're done
 				grid_counter++;
@@ -1957,7 +2007,6 @@ void fault_check::associate_grids(void)
 			{
 				NR_busdata[indexval].swing_functions_enabled = false;
 			}
-			//Default else, we've already been hit, skip out
 		}
 		//Default else, keep going to look for one
 	}
@@ -1968,11 +2017,12 @@ void fault_check::associate_grids(void)
 		//See if we're a source-flagged node
 		if ((*NR_busdata[indexval].busflag & NF_ISSOURCE) == NF_ISSOURCE)	//Source flagged
 		{
-			//See if we're already flagged
-			if (associated_grid[indexval] == -1)	//We're still unparsed
+			root_val = island_find(3,indexval);
+
+			//See if our island is already flagged
+			if (associated_grid[root_val] == -1)	//We're still unparsed
 			{
-				//Call the associater routine
-				search_associated_grids(indexval,grid_counter);
+				associated_grid[root_val] = grid_counter;
 
 				//Increment the counter, when we're done
 				grid_counter++;
@@ -1982,56 +2032,10 @@ void fault_check::associate_grids(void)
 		//Default else, keep going to look for one
 	}
 
-	//Another loop for just "NF_ISSOURCE" flags??
-}
-
-//Multiple grid checking items - the actual crawler
-//This is recursively called
-void fault_check::search_associated_grids(unsigned int node_int, int grid_counter)
-{
-	unsigned int index;
-	int node_ref;
-
-	//Loop through the connection table for this node
-	for (index=0; index<NR_busdata[node_int].Link_Table_Size; index++)
+	//Every node takes the grid of its island root
+	for (indexval=0; indexval<NR_bus_count; indexval++)
 	{
-		//See which end of the link we are
-		if (NR_branchdata[NR_busdata[node_int].Link_Table[index]].from == (int)node_int)	//From end
-		{
-			//Set the node-ref - must be other end
-			node_ref = NR_branchdata[NR_busdata[node_int].Link_Table[index]].to;
-		}
-		else	//Must be the to-end
-		{
-			//Set the node-ref, it must be us
-			node_ref = NR_branchdata[NR_busdata[node_int].Link_Table[index]].from;
-		}
-
-		//We're theoretically coming from a "powered node", so see if it has any phase alignment to proceed
-		//Only do "in service" items, so go on current phases, not original phases
-		if (((NR_busdata[node_int].phases & 0x07) & (NR_branchdata[NR_busdata[node_int].Link_Table[index]].phases & 0x07)) != 0x00)
-		{
-			//See if the other side has been handled
-			if (associated_grid[node_ref] == -1)
-			{
-				//Set the appropriate side
-				associated_grid[node_ref] = grid_counter;
-
-				//Recurse in
-				search_associated_grids(node_ref,grid_counter);
-			}
-			else if (associated_grid[node_ref] != grid_counter)
-			{
-				GL_THROW("fault_check: duplicate grid assignment on node %s!",NR_busdata[node_ref].name);
-				/*  TROUBLESHOOT
-				While mapping the associated grid/swing node for a system, a condition was encountered where
-				a node tried to belong to two different systems.  This should not have occurred.  Please submit
-				your code and a bug report via the ticketing system.
-				*/
-			}
-			//Default else -- already handled as this grid
-		}
-		//Default else, not a match, so next
+		associated_grid[indexval] = associated_grid[island_find(3,indexval)];
 	}
 }
 
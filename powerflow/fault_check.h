@@ -6,6 +6,14 @@
 
 #include "powerflow.h"
 
+#define FC_ISLAND_RADIAL 1	//Island forests follow the in-service phases of each link
+#define FC_ISLAND_MESH 2	//Island forests follow switch status and original phases (plus grid association)
+
+typedef struct {
+	unsigned int node;		//Node being expanded
+	unsigned int link;		//Next entry of its link table to visit
+} FC_SEARCH_FRAME;
+
 class fault_check : public powerflow_object
 {
 public:
@@ -37,8 +45,11 @@ public:
 	int create(void);
 	int init(OBJECT *parent=NULL);
 	int isa(char *classname);
-	void search_links(int node_int);							//Function to check connectivity and support of nodes
-	void search_links_mesh(int node_int);						//Function to check connectivity and support of nodes, but more in the "mesh" sense
+	unsigned char island_link_mask(int branch_idx, unsigned char search_mode);	//Function to determine which island forests a link joins
+	void update_islands(unsigned char search_mode);				//Function to bring the island forests up to date with the current link states
+	unsigned int island_find(int forest, unsigned int node_int);	//Function to find the island (forest root) a node belongs to
+	void island_union(int forest, unsigned int node_a, unsigned int node_b);	//Function to merge the islands of two nodes
+	void flag_sourced_island(unsigned int node_int);			//Function to flag the per-phase islands a source node supports
 	void support_check(int swing_node_int);						//Function that performs the connectivity check - this way so can be easily externally accessed
 	void support_check_mesh(int swing_node_int);				//Function that performs the connectivity check for not-so-radial systems
 	void reset_support_check(void);								//Function to re-init the support matrix
@@ -56,7 +67,6 @@ public:
 
 	void reset_associated_grid(void);										//Function to reset/allocate "grid association" array
 	void associate_grids(void);												//Function to look for the various swing nodes in the system, then associate the grids
-	void search_associated_grids(unsigned int node_int, int grid_counter);	//Function to perform the "grid association" and populate the array
 
 	TIMESTAMP sync(TIMESTAMP t0);
 
@@ -64,6 +74,12 @@ private:
 	TIMESTAMP prev_time;	//Previous timestamp - mainly for intialization
 	FUNCTIONADDR restoration_fxn;	// Function address for restoration object reconfiguration call
 	int *associated_grid;	//Array for assignment of nodes to different "main connection" points
+	unsigned int *island_parent[4];	//Union-find forests over the buses - one per phase (A, B, C), plus one for grid association
+	unsigned char *island_rank[4];	//Rank of the forest roots - keeps the trees shallow
+	unsigned char *island_link_phases;	//Forests each link currently joins (phase bits, 0x08 for grid association)
+	unsigned char *island_flags;	//Per-bus scratch flags for marking sourced islands
+	unsigned char island_mode;		//Search mode the forests were built for
+	FC_SEARCH_FRAME *alteration_stack;	//Explicit stack for the radial alteration walk
 };
 
 EXPORT int powerflow_alterations(OBJECT *thisobj, int baselink,bool rest_mode);
@@ -41,6 +41,7 @@
 #include "vfd.h"
 #include "pole.h"
 #include "pole_configuration.h"
+#include "snapshotdump.h"
 
 EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 {
@@ -84,6 +85,10 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	gl_global_create("powerflow::NR_iteration_limit",PT_int64,&NR_iteration_limit,NULL);
 	gl_global_create("powerflow::NR_deltamode_iteration_limit",PT_int64,&NR_delta_iteration_limit,NULL);
 	gl_global_create("powerflow::NR_superLU_procs",PT_int32,&NR_superLU_procs,NULL);
+	gl_global_create("powerflow::NR_load_threads",PT_int32,&NR_load_threads,PT_DESCRIPTION,"Number of threads for the NR load calculations on large systems, 0 uses the core thread count",NULL);
+	gl_global_create("powerflow::NR_predictor",PT_bool,&NR_predictor,PT_DESCRIPTION,"Flag to extrapolate the first NR voltage guess of each timestep from the last two solutions",NULL);
+	gl_global_create("powerflow::FBS_level_sweep",PT_bool,&FBS_level_sweep,PT_DESCRIPTION,"Flag to solve radial FBS networks with the level-ordered sweep instead of the object passes",NULL);
+	gl_global_create("powerflow::FBS_sweep_threads",PT_int32,&FBS_sweep_threads,PT_DESCRIPTION,"Number of threads for wide levels of the FBS level sweep, 0 uses the core thread count",NULL);
 	gl_global_create("powerflow::default_maximum_voltage_error",PT_double,&default_maximum_voltage_error,NULL);
 	gl_global_create("powerflow::default_maximum_power_error",PT_double,&default_maximum_power_error,NULL);
 	gl_global_create("powerflow::NR_admit_change",PT_bool,&NR_admit_change,NULL);
@@ -157,6 +162,7 @@ EXPORT CLASS *init(CALLBACKS *fntable, MODULE *module, int argc, char *argv[])
 	new vfd(module);
 	new pole(module);
 	new pole_configuration(module);
+	new snapshotdump(module);
 
 	/* always return the first class registered */
 	return node::oclass;
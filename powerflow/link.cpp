@@ -99,6 +99,7 @@
 #include "regulator.h"
 #include "triplex_meter.h"
 #include "switch_object.h"
+#include "matrix_kernel.h"
 
 
 CLASS* link_object::oclass = NULL;
@@ -213,6 +214,7 @@ int link_object::create(void)
 	voltage_ratio = 1.0;
 	SpecialLnk = NORMAL;
 	prev_LTime=0;
+	FBS_sweep_tree = -1;
 	NR_branch_reference=-1;
 	If_in[0] = If_in[1] = If_in[2] = complex(0,0);
 	If_out[0] = If_out[1] = If_out[2] = complex(0,0);
@@ -341,6 +343,9 @@ int link_object::init(OBJECT *parent)
 				if(gl_set_parent(to, obj) < 0)
 					throw "error when setting 'to' parent";
 					//Defined above
+
+				//The to-node may already have initialized and cached its old parent's class
+				OBJECTDATA(to,node)->update_parent_class();
 			} 
 			else 
 				throw "link to reference not a node";
@@ -2704,7 +2709,7 @@ TIMESTAMP link_object::sync(TIMESTAMP t0)
 
 	if (is_closed())
 	{
-		if (solver_method==SM_FBS)
+		if ((solver_method==SM_FBS) && (FBS_sweep_tree<0))	//Level-swept links get their current from the sweep
 		{
 			node *f = OBJECTDATA(from,node);
 			node *t = OBJECTDATA(to,node);
@@ -3066,7 +3071,7 @@ TIMESTAMP link_object::postsync(TIMESTAMP t0)
 		else
 			read_I_out[2] = tc[2];
 		
-		if (!is_open())
+		if (!is_open() && (FBS_sweep_tree<0))	//Level-swept links already updated the to-node voltage
 		{
 			/* compute and update voltages */
 			complex v0 = 
@@ -13362,6 +13367,17 @@ void link_object::lmatrix_add(complex *matrix_in_A, complex *matrix_in_B, comple
 		*/
 	}
 
+	//Fixed-size kernels for the sizes the links use
+	switch (matsize)
+	{
+		case 2: matrix_add<2>(matrix_in_A,matrix_in_B,matrix_out); return;
+		case 3: matrix_add<3>(matrix_in_A,matrix_in_B,matrix_out); return;
+		case 4: matrix_add<4>(matrix_in_A,matrix_in_B,matrix_out); return;
+		case 6: matrix_add<6>(matrix_in_A,matrix_in_B,matrix_out); return;
+		case 8: matrix_add<8>(matrix_in_A,matrix_in_B,matrix_out); return;
+		default: break;
+	}
+
 	//Loop and do the add - simple
 	for (jindex=0; jindex<matsize; jindex++)
 	{
@@ -13398,6 +13414,17 @@ void link_object::lmatrix_mult(complex *matrix_in_A, complex *matrix_in_B, compl
 		*/
 	}
 
+	//Fixed-size kernels for the sizes the links use
+	switch (matsize)
+	{
+		case 2: matrix_mult<2>(matrix_in_A,matrix_in_B,matrix_out); return;
+		case 3: matrix_mult<3>(matrix_in_A,matrix_in_B,matrix_out); return;
+		case 4: matrix_mult<4>(matrix_in_A,matrix_in_B,matrix_out); return;
+		case 6: matrix_mult<6>(matrix_in_A,matrix_in_B,matrix_out); return;
+		case 8: matrix_mult<8>(matrix_in_A,matrix_in_B,matrix_out); return;
+		default: break;
+	}
+
 	//Perform the matrix mulitplication
 	for (jindex=0; jindex<matsize; jindex++)
 	{
@@ -13437,6 +13464,17 @@ void link_object::lmatrix_vmult(complex *matrix_in, complex *vector_in, complex
 		//Define elsewhere
 	}
 
+	//Fixed-size kernels for the sizes the links use
+	switch (matsize)
+	{
+		case 2: matrix_vmult<2>(matrix_in,vector_in,vector_out); return;
+		case 3: matrix_vmult<3>(matrix_in,vector_in,vector_out); return;
+		case 4: matrix_vmult<4>(matrix_in,vector_in,vector_out); return;
+		case 6: matrix_vmult<6>(matrix_in,vector_in,vector_out); return;
+		case 8: matrix_vmult<8>(matrix_in,vector_in,vector_out); return;
+		default: break;
+	}
+
 	//Perform the matrix mulitplication
 	for (jindex=0; jindex<matsize; jindex++)
 	{
@@ -13477,38 +13515,22 @@ void inverse(complex in[3][3], complex out[3][3])
 
 void multiply(double a, complex b[3][3], complex c[3][3])
 {
-	#define MUL(i, j) c[i][j] = b[i][j] * a
-	MUL(0, 0); MUL(0, 1); MUL(0, 2);
-	MUL(1, 0); MUL(1, 1); MUL(1, 2);
-	MUL(2, 0); MUL(2, 1); MUL(2, 2);
-	#undef MUL
+	matrix_scale<3>(&b[0][0],a,&c[0][0]);
 }
 
 void multiply(complex a[3][3], complex b[3][3], complex c[3][3])
 {
-	#define MUL(i, j) c[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j]
-	MUL(0, 0); MUL(0, 1); MUL(0, 2);
-	MUL(1, 0); MUL(1, 1); MUL(1, 2);
-	MUL(2, 0); MUL(2, 1); MUL(2, 2);
-	#undef MUL
+	matrix_mult<3>(&a[0][0],&b[0][0],&c[0][0]);
 }
 
 void subtract(complex a[3][3], complex b[3][3], complex c[3][3])
 {
-	#define SUB(i, j) c[i][j] = a[i][j] - b[i][j]
-	SUB(0, 0); SUB(0, 1); SUB(0, 2);
-	SUB(1, 0); SUB(1, 1); SUB(1, 2);
-	SUB(2, 0); SUB(2, 1); SUB(2, 2);
-	#undef SUB
+	matrix_sub<3>(&a[0][0],&b[0][0],&c[0][0]);
 }
 
 void addition(complex a[3][3], complex b[3][3], complex c[3][3])
 {
-	#define ADD(i, j) c[i][j] = a[i][j] + b[i][j]
-	ADD(0, 0); ADD(0, 1); ADD(0, 2);
-	ADD(1, 0); ADD(1, 1); ADD(1, 2);
-	ADD(2, 0); ADD(2, 1); ADD(2, 2);
-	#undef ADD
+	matrix_add<3>(&a[0][0],&b[0][0],&c[0][0]);
 }
 
 void equalm(complex a[3][3], complex b[3][3])
@@ -13595,6 +13617,17 @@ void lu_matrix_inverse(complex *input_mat, complex *output_mat, int size_val)
 	complex *l_mat, *u_mat, *b_vec, *z_vec, *x_vec;
 	int sq_size,loop_val_x, loop_val_y;
 
+	//Fixed-size kernels for the sizes the links use - no heap scratch
+	switch (size_val)
+	{
+		case 2: matrix_lu_inverse<2>(input_mat,output_mat); return;
+		case 3: matrix_lu_inverse<3>(input_mat,output_mat); return;
+		case 4: matrix_lu_inverse<4>(input_mat,output_mat); return;
+		case 6: matrix_lu_inverse<6>(input_mat,output_mat); return;
+		case 8: matrix_lu_inverse<8>(input_mat,output_mat); return;
+		default: break;
+	}
+
 	//Get overall size (save a multiply, save something)
 	sq_size = size_val*size_val;
 
@@ -72,6 +72,7 @@ public:
 
 	bool current_accumulated;	///< Flag to indicate if NR current has been "handled" yet
 	bool check_link_limits;	///< Flag to see if this particular link needs limits checked
+	int FBS_sweep_tree;		///< Tree of the FBS level sweep this link is solved in, -1 if it is solved by the object passes
 	OBJECT *from;			///< from_node - source node
 	OBJECT *to;				///< to_node - load node
 	complex current_in[3];		///< current flow to link (w.r.t from node)
@@ -0,0 +1,126 @@
+/* $Id
+ * Fixed-size complex matrix kernels for the link objects
+ *
+ * The link, transformer and line models work on small dense complex
+ * matrices (3x3 phase matrices, 4x4 and 6x6 fault/history systems and
+ * the 8x8 transformer winding matrices).  These templates are sized at
+ * compile time so the loops unroll, the scratch lives on the stack and
+ * the arithmetic runs on dcomplex, which the compiler can keep in vector
+ * registers.  The operation order matches the generic loops in link.cpp,
+ * so a fixed-size kernel gives the same result as the loop it replaces.
+ */
+
+#ifndef _MATRIX_KERNEL_H
+#define _MATRIX_KERNEL_H
+
+#include "complex.h"
+
+/// out = A + B for NxN row-major matrices
+template <int N> inline void matrix_add(const complex *A, const complex *B, complex *out)
+{
+	for (int n=0; n<N*N; n++)
+		out[n] = dcomplex(A[n]) + dcomplex(B[n]);
+}
+
+/// out = A - B for NxN row-major matrices
+template <int N> inline void matrix_sub(const complex *A, const complex *B, complex *out)
+{
+	for (int n=0; n<N*N; n++)
+		out[n] = dcomplex(A[n]) - dcomplex(B[n]);
+}
+
+/// out = A * s for an NxN row-major matrix and a real scale
+template <int N> inline void matrix_scale(const complex *A, double s, complex *out)
+{
+	for (int n=0; n<N*N; n++)
+		out[n] = dcomplex(A[n]) * s;
+}
+
+/// out = A * B for NxN row-major matrices - out must not alias A or B
+template <int N> inline void matrix_mult(const complex *A, const complex *B, complex *out)
+{
+	for (int j=0; j<N; j++)
+	{
+		for (int k=0; k<N; k++)
+		{
+			dcomplex sum = dcomplex(A[j*N]) * dcomplex(B[k]);
+			for (int l=1; l<N; l++)
+				sum += dcomplex(A[j*N+l]) * dcomplex(B[l*N+k]);
+			out[j*N+k] = sum;
+		}
+	}
+}
+
+/// out = A * x for an NxN row-major matrix - out must not alias x
+template <int N> inline void matrix_vmult(const complex *A, const complex *x, complex *out)
+{
+	for (int j=0; j<N; j++)
+	{
+		dcomplex sum = dcomplex(A[j*N]) * dcomplex(x[0]);
+		for (int k=1; k<N; k++)
+			sum += dcomplex(A[j*N+k]) * dcomplex(x[k]);
+		out[j] = sum;
+	}
+}
+
+/// out = inv(A) for an NxN row-major matrix, by Doolittle LU decomposition without pivoting
+/// (the same factorization lu_matrix_inverse uses)
+template <int N> inline void matrix_lu_inverse(const complex *A, complex *out)
+{
+	dcomplex L[N][N], U[N][N], z[N], x[N];
+	int j, k, m, s;
+
+	//Decompose - unit lower L, upper U
+	for (k=0; k<N; k++)
+	{
+		for (m=k; m<N; m++)
+		{
+			if (k==0)
+				U[k][m] = A[k*N+m];
+			else
+			{
+				dcomplex sum = L[k][0]*U[0][m];
+				for (s=1; s<k; s++)
+					sum += L[k][s]*U[s][m];
+				U[k][m] = dcomplex(A[k*N+m]) - sum;
+			}
+		}
+		for (j=k+1; j<N; j++)
+		{
+			if (k==0)
+				L[j][k] = dcomplex(A[j*N+k])/U[k][k];
+			else
+			{
+				dcomplex sum = L[j][0]*U[0][k];
+				for (s=1; s<k; s++)
+					sum += L[j][s]*U[s][k];
+				L[j][k] = (dcomplex(A[j*N+k]) - sum)/U[k][k];
+			}
+		}
+	}
+
+	//Solve one identity column at a time
+	for (k=0; k<N; k++)
+	{
+		//Forward substitution - L has a unit diagonal
+		for (j=0; j<N; j++)
+		{
+			z[j] = dcomplex(j==k ? 1.0 : 0.0);
+			for (m=0; m<j; m++)
+				z[j] -= L[j][m]*z[m];
+		}
+
+		//Backward substitution
+		for (j=N-1; j>=0; j--)
+		{
+			for (m=j+1; m<N; m++)
+				z[j] -= U[j][m]*x[m];
+			x[j] = z[j]/U[j][j];
+		}
+
+		for (j=0; j<N; j++)
+			out[j*N+k] = x[j];
+	}
+}
+
+#endif
@@ -53,6 +53,7 @@
 #include <math.h>
 
 #include "solver_nr.h"
+#include "solver_fbs.h"
 #include "node.h"
 #include "link.h"
 
@@ -253,6 +254,9 @@ int node::create(void)
 	prev_NTime = 0;
 	SubNode = NONE;
 	SubNodeParent = NULL;
+	parent_is_node = parent_is_load = parent_is_triplex_line = false;
+	FBS_sweep_tree = -1;
+	FBS_sweep_root = false;
 	TopologicalParent = NULL;
 	NR_subnode_reference = NULL;
 	Extra_Data=NULL;
@@ -1224,9 +1228,32 @@ int node::init(OBJECT *parent)
 		freq_omega_ref = 2.0 * PI * nominal_frequency;
 	}
 
+	//Resolve the parent's class once, rather than testing the class names every pass
+	update_parent_class();
+
 	return result;
 }
 
+//Caches the class of the current parent - FBS links reparent their to-node in link::init,
+//which may run after this node has initialized, so they call this again when they do
+void node::update_parent_class(void)
+{
+	OBJECT *obj = OBJECTHDR(this);
+
+	if (obj->parent!=NULL)
+	{
+		parent_is_node = (gl_object_isa(obj->parent,"node","powerflow") != 0);
+		parent_is_load = (gl_object_isa(obj->parent,"load","powerflow") != 0);
+		parent_is_triplex_line = (gl_object_isa(obj->parent,"triplex_line","powerflow") != 0);
+	}
+	else
+	{
+		parent_is_node = false;
+		parent_is_load = false;
+		parent_is_triplex_line = false;
+	}
+}
+
 //Functionalized presync pass routines for NR solver
 //Put in place so deltamode can call it and properly udpate
 TIMESTAMP node::NR_node_presync_fxn(TIMESTAMP t0_val)
@@ -1458,6 +1485,12 @@ TIMESTAMP node::presync(TIMESTAMP t0)
 			//Deflag us
 			FBS_swing_set=true;
 		}
+
+		//Flatten the radial trees for the level sweep - only the first caller does any work
+		if ((solver_method==SM_FBS) && (FBS_level_sweep==true))
+		{
+			solver_fbs_init();
+		}
 	}
 
 	if (solver_method==SM_NR)
@@ -1941,6 +1974,249 @@ TIMESTAMP node::presync(TIMESTAMP t0)
 	return t1;
 }
 
+//Functionalized sync pass routines for FBS solver
+//Adds this node's own load current to current_inj - anything downstream must already be in there,
+//since the triplex neutral is computed from the accumulated phase currents
+void node::FBS_node_sync_fxn(OBJECT *obj)
+{
+	complex delta_current[3];
+	complex power_current[3];
+	complex delta_shunt[3];
+	complex delta_shunt_curr[3];
+	complex dy_curr_accum[3];
+	complex temp_current_val[3];
+
+	if (phases&PHASE_S)
+	{	// Split phase
+		complex temp_inj[2];
+		complex adjusted_curr[3];
+		complex temp_curr_val[3];
+
+		if (house_present)
+		{
+			//Update phase adjustments
+			adjusted_curr[0].SetPolar(1.0,voltage[0].Arg());	//Pull phase of V1
+			adjusted_curr[1].SetPolar(1.0,voltage[1].Arg());	//Pull phase of V2
+			adjusted_curr[2].SetPolar(1.0,voltaged[0].Arg());	//Pull phase of V12
+
+			//Update these current contributions
+			temp_curr_val[0] = nom_res_curr[0]/(~adjusted_curr[0]);		//Just denominator conjugated to keep math right (rest was conjugated in house)
+			temp_curr_val[1] = nom_res_curr[1]/(~adjusted_curr[1]);
+			temp_curr_val[2] = nom_res_curr[2]/(~adjusted_curr[2]);
+		}
+		else
+		{
+			temp_curr_val[0] = temp_curr_val[1] = temp_curr_val[2] = 0.0;	//No house present, just zero em
+		}
+
+#ifdef SUPPORT_OUTAGES
+		if (voltage[0]!=0.0)
+		{
+#endif
+		complex d1 = (voltage1.IsZero() || (power1.IsZero() && shunt1.IsZero())) ? (current1 + temp_curr_val[0]) : (current1 + ~(power1/voltage1) + voltage1*shunt1 + temp_curr_val[0]);
+		complex d2 = ((voltage1+voltage2).IsZero() || (power12.IsZero() && shunt12.IsZero())) ? (current12 + temp_curr_val[2]) : (current12 + ~(power12/(voltage1+voltage2)) + (voltage1+voltage2)*shunt12 + temp_curr_val[2]);
+		
+		current_inj[0] += d1;
+		temp_inj[0] = current_inj[0];
+		current_inj[0] += d2;
+
+#ifdef SUPPORT_OUTAGES
+		}
+		else
+		{
+			temp_inj[0] = 0.0;
+			//WRITELOCK_OBJECT(obj);
+			current_inj[0]=0.0;
+			//UNLOCK_OBJECT(obj);
+		}
+
+		if (voltage[1]!=0)
+		{
+#endif
+		d1 = (voltage2.IsZero() || (power2.IsZero() && shunt2.IsZero())) ? (-current2 - temp_curr_val[1]) : (-current2 - ~(power2/voltage2) - voltage2*shunt2 - temp_curr_val[1]);
+		d2 = ((voltage1+voltage2).IsZero() || (power12.IsZero() && shunt12.IsZero())) ? (-current12 - temp_curr_val[2]) : (-current12 - ~(power12/(voltage1+voltage2)) - (voltage1+voltage2)*shunt12 - temp_curr_val[2]);
+
+		current_inj[1] += d1;
+		temp_inj[1] = current_inj[1];
+		current_inj[1] += d2;
+		
+#ifdef SUPPORT_OUTAGES
+		}
+		else
+		{
+			temp_inj[0] = 0.0;
+			//WRITELOCK_OBJECT(obj);
+			current_inj[1] = 0.0;
+			//UNLOCK_OBJECT(obj);
+		}
+#endif
+
+		if (parent_is_triplex_line) {
+			link_object *plink = OBJECTDATA(obj->parent,link_object);
+			complex d = plink->tn[0]*current_inj[0] + plink->tn[1]*current_inj[1];
+			current_inj[2] += d;
+		}
+		else {
+			complex d = ((voltage1.IsZero() || (power1.IsZero() && shunt1.IsZero())) ||
+							   (voltage2.IsZero() || (power2.IsZero() && shunt2.IsZero()))) 
+								? currentN : -(temp_inj[0] + temp_inj[1]);
+			current_inj[2] += d;
+		}
+	}
+	else if (has_phase(PHASE_D)) 
+	{   // 'Delta' connected load
+		
+		//Convert delta connected power to appropriate line current
+		delta_current[0]= (voltaged[0].IsZero()) ? 0 : ~(power[0]/voltaged[0]);
+		delta_current[1]= (voltaged[1].IsZero()) ? 0 : ~(power[1]/voltaged[1]);
+		delta_current[2]= (voltaged[2].IsZero()) ? 0 : ~(power[2]/voltaged[2]);
+
+		power_current[0]=delta_current[0]-delta_current[2];
+		power_current[1]=delta_current[1]-delta_current[0];
+		power_current[2]=delta_current[2]-delta_current[1];
+
+		//Convert delta connected load to appropriate line current
+		delta_shunt[0] = voltaged[0]*shunt[0];
+		delta_shunt[1] = voltaged[1]*shunt[1];
+		delta_shunt[2] = voltaged[2]*shunt[2];
+
+		delta_shunt_curr[0] = delta_shunt[0]-delta_shunt[2];
+		delta_shunt_curr[1] = delta_shunt[1]-delta_shunt[0];
+		delta_shunt_curr[2] = delta_shunt[2]-delta_shunt[1];
+
+		//Convert delta-current into a phase current - reuse temp variable
+		delta_current[0]=current[0]-current[2];
+		delta_current[1]=current[1]-current[0];
+		delta_current[2]=current[2]-current[1];
+
+#ifdef SUPPORT_OUTAGES
+		for (char kphase=0;kphase<3;kphase++)
+		{
+			if (voltaged[kphase]==0.0)
+			{
+				//WRITELOCK_OBJECT(obj);
+				current_inj[kphase] = 0.0;
+				//UNLOCK_OBJECT(obj);
+			}
+			else
+			{
+				//WRITELOCK_OBJECT(obj);
+				current_inj[kphase] += delta_current[kphase] + power_current[kphase] + delta_shunt_curr[kphase];
+				//UNLOCK_OBJECT(obj);
+			}
+		}
+#else
+		temp_current_val[0] = delta_current[0] + power_current[0] + delta_shunt_curr[0];
+		temp_current_val[1] = delta_current[1] + power_current[1] + delta_shunt_curr[1];
+		temp_current_val[2] = delta_current[2] + power_current[2] + delta_shunt_curr[2];
+
+		current_inj[0] += temp_current_val[0];
+		current_inj[1] += temp_current_val[1];
+		current_inj[2] += temp_current_val[2];
+#endif
+	}
+	else 
+	{	// 'WYE' connected load
+
+#ifdef SUPPORT_OUTAGES
+		for (char kphase=0;kphase<3;kphase++)
+		{
+			if (voltage[kphase]==0.0)
+			{
+				//WRITELOCK_OBJECT(obj);
+				current_inj[kphase] = 0.0;
+				//UNLOCK_OBJECT(obj);
+			}
+			else
+			{
+				complex d = ((voltage[kphase]==0.0) || ((power[kphase] == 0) && shunt[kphase].IsZero())) ? current[kphase] : current[kphase] + ~(power[kphase]/voltage[kphase]) + voltage[kphase]*shunt[kphase];
+				//WRITELOCK_OBJECT(obj);
+				current_inj[kphase] += d;
+				//UNLOCK_OBJECT(obj);
+			}
+		}
+#else
+
+		temp_current_val[0] = (voltage[0].IsZero() || (power[0].IsZero() && shunt[0].IsZero())) ? current[0] : current[0] + ~(power[0]/voltage[0]) + voltage[0]*shunt[0];
+		temp_current_val[1] = (voltage[1].IsZero() || (power[1].IsZero() && shunt[1].IsZero())) ? current[1] : current[1] + ~(power[1]/voltage[1]) + voltage[1]*shunt[1];
+		temp_current_val[2] = (voltage[2].IsZero() || (power[2].IsZero() && shunt[2].IsZero())) ? current[2] : current[2] + ~(power[2]/voltage[2]) + voltage[2]*shunt[2];
+
+		current_inj[0] += temp_current_val[0];
+		current_inj[1] += temp_current_val[1];
+		current_inj[2] += temp_current_val[2];
+#endif
+	}
+
+	//Handle explicit delta-wye connections now -- no triplex
+	if (!(has_phase(PHASE_S)))
+	{
+		//Convert delta connected power to appropriate line current
+		delta_current[0]= (voltageAB.IsZero()) ? 0 : ~(power_dy[0]/voltageAB);
+		delta_current[1]= (voltageBC.IsZero()) ? 0 : ~(power_dy[1]/voltageBC);
+		delta_current[2]= (voltageCA.IsZero()) ? 0 : ~(power_dy[2]/voltageCA);
+
+		power_current[0]=delta_current[0]-delta_current[2];
+		power_current[1]=delta_current[1]-delta_current[0];
+		power_current[2]=delta_current[2]-delta_current[1];
+
+		//Convert delta connected load to appropriate line current
+		delta_shunt[0] = voltageAB*shunt_dy[0];
+		delta_shunt[1] = voltageBC*shunt_dy[1];
+		delta_shunt[2] = voltageCA*shunt_dy[2];
+
+		delta_shunt_curr[0] = delta_shunt[0]-delta_shunt[2];
+		delta_shunt_curr[1] = delta_shunt[1]-delta_shunt[0];
+		delta_shunt_curr[2] = delta_shunt[2]-delta_shunt[1];
+
+		//Convert delta-current into a phase current - reuse temp variable
+		delta_current[0]=current_dy[0]-current_dy[2];
+		delta_current[1]=current_dy[1]-current_dy[0];
+		delta_current[2]=current_dy[2]-current_dy[1];
+
+		//Accumulate
+		dy_curr_accum[0] = delta_current[0] + power_current[0] + delta_shunt_curr[0];
+		dy_curr_accum[1] = delta_current[1] + power_current[1] + delta_shunt_curr[1];
+		dy_curr_accum[2] = delta_current[2] + power_current[2] + delta_shunt_curr[2];
+
+		//Wye-connected portions
+		dy_curr_accum[0] += (voltageA.IsZero() || (power_dy[3].IsZero() && shunt_dy[3].IsZero())) ? current_dy[3] : current_dy[3] + ~(power_dy[3]/voltageA) + voltageA*shunt_dy[3];
+		dy_curr_accum[1] += (voltageB.IsZero() || (power_dy[4].IsZero() && shunt_dy[4].IsZero())) ? current_dy[4] : current_dy[4] + ~(power_dy[4]/voltageB) + voltageB*shunt_dy[4];
+		dy_curr_accum[2] += (voltageC.IsZero() || (power_dy[5].IsZero() && shunt_dy[5].IsZero())) ? current_dy[5] : current_dy[5] + ~(power_dy[5]/voltageC) + voltageC*shunt_dy[5];
+			
+		//Accumulate in to final portion
+		current_inj[0] += dy_curr_accum[0];
+		current_inj[1] += dy_curr_accum[1];
+		current_inj[2] += dy_curr_accum[2];
+
+	}//End delta/wye explicit
+
+#ifdef SUPPORT_OUTAGES
+if (is_open_any())
+	throw "unable to handle node open phase condition";
+
+if (is_contact_any())
+{
+	/* phase-phase contact */
+	if (is_contact(PHASE_A|PHASE_B|PHASE_C))
+		voltageA = voltageB = voltageC = (voltageA + voltageB + voltageC)/3;
+	else if (is_contact(PHASE_A|PHASE_B))
+		voltageA = voltageB = (voltageA + voltageB)/2;
+	else if (is_contact(PHASE_B|PHASE_C))
+		voltageB = voltageC = (voltageB + voltageC)/2;
+	else if (is_contact(PHASE_A|PHASE_C))
+		voltageA = voltageC = (voltageA + voltageC)/2;
+
+	/* phase-neutral/ground contact */
+	if (is_contact(PHASE_A|PHASE_N) || is_contact(PHASE_A|GROUND))
+		voltageA /= 2;
+	if (is_contact(PHASE_B|PHASE_N) || is_contact(PHASE_B|GROUND))
+		voltageB /= 2;
+	if (is_contact(PHASE_C|PHASE_N) || is_contact(PHASE_C|GROUND))
+		voltageC /= 2;
+}
+#endif
+}
+
 //Functionalized sync pass routines for NR solver
 //Put in place so deltamode can call it and properly udpate
 void node::NR_node_sync_fxn(OBJECT *obj)
@@ -2093,7 +2369,7 @@ void node::NR_node_sync_fxn(OBJECT *obj)
 			//Post our loads up to our parent
 			node *ParToLoad = OBJECTDATA(SubNodeParent,node);
 
-			if (gl_object_isa(SubNodeParent,"load","powerflow"))	//Load gets cleared at every presync, so reaggregate :(
+			if (parent_is_load)	//Load gets cleared at every presync, so reaggregate :(
 			{
 				//Lock the parent for accumulation
 				LOCK_OBJECT(SubNodeParent);
@@ -2127,7 +2403,7 @@ void node::NR_node_sync_fxn(OBJECT *obj)
 				//All done, unlock
 				UNLOCK_OBJECT(SubNodeParent);
 			}
-			else if (gl_object_isa(SubNodeParent,"node","powerflow"))	//"parented" node - update values - This has to go to the bottom
+			else if (parent_is_node)	//"parented" node - update values - This has to go to the bottom
 			{												//since load/meter share with node (and load handles power in presync)
 				//Lock the parent for accumulation
 				LOCK_OBJECT(SubNodeParent);
@@ -2284,16 +2560,17 @@ void node::NR_node_sync_fxn(OBJECT *obj)
 	}//end not uninitialized
 }
 
+//Checks whether FBS_node_sync_fxn can run on a level sweep worker thread - VFD updates call out to
+//the VFD object and child accumulation can GL_THROW, both of which have to stay on the sync thread
+bool node::FBS_node_sync_threadsafe(void)
+{
+	return ((VFD_attached == false) && (SubNode == NONE));
+}
+
 TIMESTAMP node::sync(TIMESTAMP t0)
 {
 	TIMESTAMP t1 = powerflow_object::sync(t0);
 	OBJECT *obj = OBJECTHDR(this);
-	complex delta_current[3];
-	complex power_current[3];
-	complex delta_shunt[3];
-	complex delta_shunt_curr[3];
-	complex dy_curr_accum[3];
-	complex temp_current_val[3];
 	
 	//Generic time keeping variable - used for phase checks (GS does this explicitly below)
 	if (t0!=prev_NTime)
@@ -2306,243 +2583,24 @@ TIMESTAMP node::sync(TIMESTAMP t0)
 	{
 	case SM_FBS:
 		{
-		if (phases&PHASE_S)
-		{	// Split phase
-			complex temp_inj[2];
-			complex adjusted_curr[3];
-			complex temp_curr_val[3];
-
-			if (house_present)
-			{
-				//Update phase adjustments
-				adjusted_curr[0].SetPolar(1.0,voltage[0].Arg());	//Pull phase of V1
-				adjusted_curr[1].SetPolar(1.0,voltage[1].Arg());	//Pull phase of V2
-				adjusted_curr[2].SetPolar(1.0,voltaged[0].Arg());	//Pull phase of V12
-
-				//Update these current contributions
-				temp_curr_val[0] = nom_res_curr[0]/(~adjusted_curr[0]);		//Just denominator conjugated to keep math right (rest was conjugated in house)
-				temp_curr_val[1] = nom_res_curr[1]/(~adjusted_curr[1]);
-				temp_curr_val[2] = nom_res_curr[2]/(~adjusted_curr[2]);
-			}
-			else
-			{
-				temp_curr_val[0] = temp_curr_val[1] = temp_curr_val[2] = 0.0;	//No house present, just zero em
-			}
-
-#ifdef SUPPORT_OUTAGES
-			if (voltage[0]!=0.0)
-			{
-#endif
-			complex d1 = (voltage1.IsZero() || (power1.IsZero() && shunt1.IsZero())) ? (current1 + temp_curr_val[0]) : (current1 + ~(power1/voltage1) + voltage1*shunt1 + temp_curr_val[0]);
-			complex d2 = ((voltage1+voltage2).IsZero() || (power12.IsZero() && shunt12.IsZero())) ? (current12 + temp_curr_val[2]) : (current12 + ~(power12/(voltage1+voltage2)) + (voltage1+voltage2)*shunt12 + temp_curr_val[2]);
-			
-			current_inj[0] += d1;
-			temp_inj[0] = current_inj[0];
-			current_inj[0] += d2;
-
-#ifdef SUPPORT_OUTAGES
-			}
-			else
-			{
-				temp_inj[0] = 0.0;
-				//WRITELOCK_OBJECT(obj);
-				current_inj[0]=0.0;
-				//UNLOCK_OBJECT(obj);
-			}
-
-			if (voltage[1]!=0)
-			{
-#endif
-			d1 = (voltage2.IsZero() || (power2.IsZero() && shunt2.IsZero())) ? (-current2 - temp_curr_val[1]) : (-current2 - ~(power2/voltage2) - voltage2*shunt2 - temp_curr_val[1]);
-			d2 = ((voltage1+voltage2).IsZero() || (power12.IsZero() && shunt12.IsZero())) ? (-current12 - temp_curr_val[2]) : (-current12 - ~(power12/(voltage1+voltage2)) - (voltage1+voltage2)*shunt12 - temp_curr_val[2]);
-
-			current_inj[1] += d1;
-			temp_inj[1] = current_inj[1];
-			current_inj[1] += d2;
-			
-#ifdef SUPPORT_OUTAGES
-			}
-			else
-			{
-				temp_inj[0] = 0.0;
-				//WRITELOCK_OBJECT(obj);
-				current_inj[1] = 0.0;
-				//UNLOCK_OBJECT(obj);
-			}
-#endif
-
-			if (obj->parent!=NULL && gl_object_isa(obj->parent,"triplex_line","powerflow")) {
-				link_object *plink = OBJECTDATA(obj->parent,link_object);
-				complex d = plink->tn[0]*current_inj[0] + plink->tn[1]*current_inj[1];
-				current_inj[2] += d;
-			}
-			else {
-				complex d = ((voltage1.IsZero() || (power1.IsZero() && shunt1.IsZero())) ||
-								   (voltage2.IsZero() || (power2.IsZero() && shunt2.IsZero()))) 
-									? currentN : -(temp_inj[0] + temp_inj[1]);
-				current_inj[2] += d;
-			}
-		}
-		else if (has_phase(PHASE_D)) 
-		{   // 'Delta' connected load
-			
-			//Convert delta connected power to appropriate line current
-			delta_current[0]= (voltaged[0].IsZero()) ? 0 : ~(power[0]/voltaged[0]);
-			delta_current[1]= (voltaged[1].IsZero()) ? 0 : ~(power[1]/voltaged[1]);
-			delta_current[2]= (voltaged[2].IsZero()) ? 0 : ~(power[2]/voltaged[2]);
-
-			power_current[0]=delta_current[0]-delta_current[2];
-			power_current[1]=delta_current[1]-delta_current[0];
-			power_current[2]=delta_current[2]-delta_current[1];
-
-			//Convert delta connected load to appropriate line current
-			delta_shunt[0] = voltaged[0]*shunt[0];
-			delta_shunt[1] = voltaged[1]*shunt[1];
-			delta_shunt[2] = voltaged[2]*shunt[2];
-
-			delta_shunt_curr[0] = delta_shunt[0]-delta_shunt[2];
-			delta_shunt_curr[1] = delta_shunt[1]-delta_shunt[0];
-			delta_shunt_curr[2] = delta_shunt[2]-delta_shunt[1];
-
-			//Convert delta-current into a phase current - reuse temp variable
-			delta_current[0]=current[0]-current[2];
-			delta_current[1]=current[1]-current[0];
-			delta_current[2]=current[2]-current[1];
-
-#ifdef SUPPORT_OUTAGES
-			for (char kphase=0;kphase<3;kphase++)
-			{
-				if (voltaged[kphase]==0.0)
-				{
-					//WRITELOCK_OBJECT(obj);
-					current_inj[kphase] = 0.0;
-					//UNLOCK_OBJECT(obj);
-				}
-				else
-				{
-					//WRITELOCK_OBJECT(obj);
-					current_inj[kphase] += delta_current[kphase] + power_current[kphase] + delta_shunt_curr[kphase];
-					//UNLOCK_OBJECT(obj);
-				}
-			}
-#else
-			temp_current_val[0] = delta_current[0] + power_current[0] + delta_shunt_curr[0];
-			temp_current_val[1] = delta_current[1] + power_current[1] + delta_shunt_curr[1];
-			temp_current_val[2] = delta_current[2] + power_current[2] + delta_shunt_curr[2];
-
-			current_inj[0] += temp_current_val[0];
-			current_inj[1] += temp_current_val[1];
-			current_inj[2] += temp_current_val[2];
-#endif
-		}
-		else 
-		{	// 'WYE' connected load
-
-#ifdef SUPPORT_OUTAGES
-			for (char kphase=0;kphase<3;kphase++)
-			{
-				if (voltage[kphase]==0.0)
-				{
-					//WRITELOCK_OBJECT(obj);
-					current_inj[kphase] = 0.0;
-					//UNLOCK_OBJECT(obj);
-				}
-				else
-				{
-					complex d = ((voltage[kphase]==0.0) || ((power[kphase] == 0) && shunt[kphase].IsZero())) ? current[kphase] : current[kphase] + ~(power[kphase]/voltage[kphase]) + voltage[kphase]*shunt[kphase];
-					//WRITELOCK_OBJECT(obj);
-					current_inj[kphase] += d;
-					//UNLOCK_OBJECT(obj);
-				}
-			}
-#else
-
-			temp_current_val[0] = (voltage[0].IsZero() || (power[0].IsZero() && shunt[0].IsZero())) ? current[0] : current[0] + ~(power[0]/voltage[0]) + voltage[0]*shunt[0];
-			temp_current_val[1] = (voltage[1].IsZero() || (power[1].IsZero() && shunt[1].IsZero())) ? current[1] : current[1] + ~(power[1]/voltage[1]) + voltage[1]*shunt[1];
-			temp_current_val[2] = (voltage[2].IsZero() || (power[2].IsZero() && shunt[2].IsZero())) ? current[2] : current[2] + ~(power[2]/voltage[2]) + voltage[2]*shunt[2];
-
-			current_inj[0] += temp_current_val[0];
-			current_inj[1] += temp_current_val[1];
-			current_inj[2] += temp_current_val[2];
-#endif
-		}
-
-		//Handle explicit delta-wye connections now -- no triplex
-		if (!(has_phase(PHASE_S)))
+		//Currents and voltages of radial trees are handled by the level sweep, run from the tree's root
+		if (FBS_sweep_tree>=0)
 		{
-			//Convert delta connected power to appropriate line current
-			delta_current[0]= (voltageAB.IsZero()) ? 0 : ~(power_dy[0]/voltageAB);
-			delta_current[1]= (voltageBC.IsZero()) ? 0 : ~(power_dy[1]/voltageBC);
-			delta_current[2]= (voltageCA.IsZero()) ? 0 : ~(power_dy[2]/voltageCA);
-
-			power_current[0]=delta_current[0]-delta_current[2];
-			power_current[1]=delta_current[1]-delta_current[0];
-			power_current[2]=delta_current[2]-delta_current[1];
-
-			//Convert delta connected load to appropriate line current
-			delta_shunt[0] = voltageAB*shunt_dy[0];
-			delta_shunt[1] = voltageBC*shunt_dy[1];
-			delta_shunt[2] = voltageCA*shunt_dy[2];
-
-			delta_shunt_curr[0] = delta_shunt[0]-delta_shunt[2];
-			delta_shunt_curr[1] = delta_shunt[1]-delta_shunt[0];
-			delta_shunt_curr[2] = delta_shunt[2]-delta_shunt[1];
-
-			//Convert delta-current into a phase current - reuse temp variable
-			delta_current[0]=current_dy[0]-current_dy[2];
-			delta_current[1]=current_dy[1]-current_dy[0];
-			delta_current[2]=current_dy[2]-current_dy[1];
-
-			//Accumulate
-			dy_curr_accum[0] = delta_current[0] + power_current[0] + delta_shunt_curr[0];
-			dy_curr_accum[1] = delta_current[1] + power_current[1] + delta_shunt_curr[1];
-			dy_curr_accum[2] = delta_current[2] + power_current[2] + delta_shunt_curr[2];
-
-			//Wye-connected portions
-			dy_curr_accum[0] += (voltageA.IsZero() || (power_dy[3].IsZero() && shunt_dy[3].IsZero())) ? current_dy[3] : current_dy[3] + ~(power_dy[3]/voltageA) + voltageA*shunt_dy[3];
-			dy_curr_accum[1] += (voltageB.IsZero() || (power_dy[4].IsZero() && shunt_dy[4].IsZero())) ? current_dy[4] : current_dy[4] + ~(power_dy[4]/voltageB) + voltageB*shunt_dy[4];
-			dy_curr_accum[2] += (voltageC.IsZero() || (power_dy[5].IsZero() && shunt_dy[5].IsZero())) ? current_dy[5] : current_dy[5] + ~(power_dy[5]/voltageC) + voltageC*shunt_dy[5];
-				
-			//Accumulate in to final portion
-			current_inj[0] += dy_curr_accum[0];
-			current_inj[1] += dy_curr_accum[1];
-			current_inj[2] += dy_curr_accum[2];
-
-		}//End delta/wye explicit
-
-#ifdef SUPPORT_OUTAGES
-	if (is_open_any())
-		throw "unable to handle node open phase condition";
-
-	if (is_contact_any())
-	{
-		/* phase-phase contact */
-		if (is_contact(PHASE_A|PHASE_B|PHASE_C))
-			voltageA = voltageB = voltageC = (voltageA + voltageB + voltageC)/3;
-		else if (is_contact(PHASE_A|PHASE_B))
-			voltageA = voltageB = (voltageA + voltageB)/2;
-		else if (is_contact(PHASE_B|PHASE_C))
-			voltageB = voltageC = (voltageB + voltageC)/2;
-		else if (is_contact(PHASE_A|PHASE_C))
-			voltageA = voltageC = (voltageA + voltageC)/2;
+			if (FBS_sweep_root)
+				solver_fbs(FBS_sweep_tree);
+			break;
+		}
 
-		/* phase-neutral/ground contact */
-		if (is_contact(PHASE_A|PHASE_N) || is_contact(PHASE_A|GROUND))
-			voltageA /= 2;
-		if (is_contact(PHASE_B|PHASE_N) || is_contact(PHASE_B|GROUND))
-			voltageB /= 2;
-		if (is_contact(PHASE_C|PHASE_N) || is_contact(PHASE_C|GROUND))
-			voltageC /= 2;
-	}
-#endif
+		//Call FBS sync function items
+		FBS_node_sync_fxn(obj);
 
 		// if the parent object is another node
-		if (obj->parent!=NULL && gl_object_isa(obj->parent,"node","powerflow"))
+		if (parent_is_node)
 		{
 			node *pNode = OBJECTDATA(obj->parent,node);
 
 			//Check to make sure phases are correct - ignore Deltas and neutrals (load changes take care of those)
-			if (((pNode->phases & phases) & (!(PHASE_D | PHASE_N))) == (phases & (!(PHASE_D | PHASE_N))))
+			if (((pNode->phases & phases) & (~(PHASE_D | PHASE_N))) == (phases & (~(PHASE_D | PHASE_N))))
 			{
 				// add the injections on this node to the parent
 				WRITELOCK_OBJECT(obj->parent);
@@ -2777,7 +2835,7 @@ TIMESTAMP node::postsync(TIMESTAMP t0)
 	if (solver_method==SM_FBS)
 	{
 		// if the parent object is a node
-		if (obj->parent!=NULL && (gl_object_isa(obj->parent,"node","powerflow")))
+		if (parent_is_node)
 		{
 			// copy the voltage from the parent - check for mismatch handled earlier
 			node *pNode = OBJECTDATA(obj->parent,node);
@@ -245,6 +245,8 @@ public:
 	//Functionalized portions for deltamode calls -- allows updates
 	TIMESTAMP NR_node_presync_fxn(TIMESTAMP t0_val);
 	void NR_node_sync_fxn(OBJECT *obj);
+	void FBS_node_sync_fxn(OBJECT *obj);
+	bool FBS_node_sync_threadsafe(void);
 	void BOTH_node_postsync_fxn(OBJECT *obj);
 	OBJECT *NR_master_swing_search(const char *node_type_value,bool main_swing);
 
@@ -259,8 +261,14 @@ public:
 
 	int NR_populate(void);
 	OBJECT *SubNodeParent;	/// Child node's original parent or child of parent
+	bool parent_is_node;			/// Parent is a powerflow node - resolved by update_parent_class so sync does not compare class names
+	bool parent_is_load;			/// Parent is a powerflow load
+	bool parent_is_triplex_line;	/// Parent is a powerflow triplex_line
 	int NR_current_update(bool postpass, bool parentcall);
+	void update_parent_class(void);
 	object TopologicalParent;	/// Child node's original parent as per the topological configuration in the GLM file
+	int FBS_sweep_tree;				/// Tree of the FBS level sweep this node is solved in, -1 if it is solved by the object passes
+	bool FBS_sweep_root;			/// Node is the root of its FBS level sweep tree and runs the sweep from its sync
 
 	//NR bus status toggle function
 	STATUS NR_swap_swing_status(bool desired_status);
@@ -278,6 +286,7 @@ public:
 	friend class capacitor;		// Needs access to deltamode stuff
 	friend class fuse;			// needs access to current_inj
 	friend class frequency_gen;	// needs access to current_inj
+	friend void solver_fbs_init(void);	// needs access to current_inj
 	friend class motor;	// needs access to curr_state
 
 	static int kmlinit(int (*stream)(const char*,...));
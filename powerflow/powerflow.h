@@ -66,11 +66,15 @@ EXTERN int64 NR_iteration_limit INIT(500);			/**< Newton-Raphson iteration limit
 EXTERN bool NR_dyn_first_run INIT(true);			/**< Newton-Raphson first run indicator - used by deltamode functionality for initialization powerflow */
 EXTERN bool NR_admit_change INIT(true);				/**< Newton-Raphson admittance matrix change detector - used to prevent complete recalculation of admittance at every timestep */
 EXTERN int NR_superLU_procs INIT(1);				/**< Newton-Raphson related - superLU MT processor count to request - separate from thread_count */
+EXTERN int NR_load_threads INIT(0);					/**< Newton-Raphson related - threads for the load calculations on large systems - 0 uses the core thread count */
+EXTERN bool NR_predictor INIT(false);				/**< Newton-Raphson related - extrapolate the first voltage guess of each timestep from the last two solutions */
 EXTERN TIMESTAMP NR_retval INIT(TS_NEVER);			/**< Newton-Raphson current return value - if t0 objects know we aren't going anywhere */
 EXTERN OBJECT *NR_swing_bus INIT(NULL);				/**< Newton-Raphson swing bus */
 EXTERN int NR_swing_bus_reference INIT(-1);			/**< Newton-Raphson swing bus index reference in NR_busdata */
 EXTERN int64 NR_delta_iteration_limit INIT(10);		/**< Newton-Raphson iteration limit (per deltamode timestep) */
 EXTERN bool FBS_swing_set INIT(false);				/**< Forward-Back Sweep swing assignment variable */
+EXTERN bool FBS_level_sweep INIT(false);			/**< Forward-Back Sweep - solve radial trees in one level-ordered sweep instead of the object passes */
+EXTERN int FBS_sweep_threads INIT(0);				/**< Forward-Back Sweep related - threads for wide levels of the level sweep - 0 uses the core thread count */
 EXTERN bool show_matrix_values INIT(false);			/**< flag to enable dumping matrix calculations as they occur */
 EXTERN double primary_voltage_ratio INIT(60.0);		/**< primary voltage ratio (@todo explain primary_voltage_ratio in powerflow (ticket #131) */
 EXTERN double nominal_frequency INIT(60.0);			/**< nomimal operating frequencty */
@@ -1847,8 +1847,7 @@ void restoration::simplifyTop_2(void)
 {
 	int idx, uIdx, vIdx;
 	int top_sim_2_getVerNum;
-	int allocsizeval;
-	CHAINNODE *v;
+	int allocsizeval, vPos;
 
     // Initialize top_sim_2 -- allocate first
 		top_sim_2 = (LinkedUndigraph *)gl_malloc(sizeof(LinkedUndigraph));
@@ -1898,11 +1897,9 @@ void restoration::simplifyTop_2(void)
 	top_sim_2_getVerNum = top_sim_2->getVerNum();
 	for (uIdx=0; uIdx<top_sim_2_getVerNum; uIdx++)
 	{
-		v = top_sim_2->adjList[uIdx]->first;
-
-		while (v != NULL)
+		for (vPos=0; vPos<top_sim_2->adjList[uIdx]->length; vPos++)
 		{
-			vIdx = v->data;
+			vIdx = top_sim_2->adjList[uIdx]->data[vPos];
 			if ((vIdx > uIdx)  && ((((uIdx==f_sec_2.from_vert) && (vIdx==f_sec_2.to_vert)) || ((uIdx==f_sec_2.to_vert) && (vIdx==f_sec_2.from_vert)))) == false)
 			{
 				sec_swi_2.data_1[sec_swi_2.currSize] = uIdx;
@@ -1926,7 +1923,6 @@ void restoration::simplifyTop_2(void)
 					}
 				}
 			}
-			v = v->link;
 		}
 	}
 }
@@ -1934,8 +1930,8 @@ void restoration::simplifyTop_2(void)
 //Set feeder vertices
 void restoration::setFeederVertices_2(void)
 {
-	int idx, curNode, nodeSetIdx;
-	CHAINNODE *tNode;
+	int idx, curNode, nodeSetIdx, tPos;
+	Chain *tNode;
 	INTVECT nodeSet;
 
 	//Empty it, to be safe
@@ -1969,23 +1965,15 @@ void restoration::setFeederVertices_2(void)
 			}
 			else
 			{
-				if (top_sim_1->adjList[curNode] != NULL)
-				{
-					tNode = top_sim_1->adjList[curNode]->first;
-				}
-				else
-				{
-					tNode = NULL;
-				}
+				tNode = top_sim_1->adjList[curNode];
 
-				while (tNode != NULL)
+				for (tPos=0; (tNode != NULL) && (tPos<tNode->length); tPos++)
 				{
-					if (tNode->data != s_ver_1)
+					if (tNode->data[tPos] != s_ver_1)
 					{
-						nodeSet.data[nodeSet.currSize] = tNode->data;
+						nodeSet.data[nodeSet.currSize] = tNode->data[tPos];
 						nodeSet.currSize++;
 					}
-					tNode = tNode->link;
 				}
 			}
 		}
@@ -3916,18 +3904,11 @@ void restoration::PowerflowSave(void)
 	//See if we're already allocated - we shouldn't be, but check
 	if (voltage_storage != NULL)
 	{
-		//Loop and free our components first
-		for (indexval=0; indexval<NR_bus_count; indexval++)
-		{
-			gl_free(voltage_storage[indexval]);
-		}
-
-		//Free us up too
 		gl_free(voltage_storage);
 	}
 
-	//Allocate us
-	voltage_storage = (complex **)gl_malloc(NR_bus_count*sizeof(complex *));
+	//Allocate us - one block, three phases per bus
+	voltage_storage = (complex *)gl_malloc(3*NR_bus_count*sizeof(complex));
 
 	//Make sure it worked
 	if (voltage_storage == NULL)
@@ -3940,23 +3921,13 @@ void restoration::PowerflowSave(void)
 		*/
 	}
 
-	//Now loop for allocate/copy
+	//Now loop and copy
 	for (indexval=0; indexval<NR_bus_count; indexval++)
 	{
-		//Allocate this entry
-		voltage_storage[indexval] = (complex *)gl_malloc(3*sizeof(complex));
-
-		//Check it
-		if (voltage_storage[indexval] == NULL)
-		{
-			GL_THROW("Restoration: failed to allocate memory for base voltage values!");
-			//Defined above
-		}
-
 		//Copy the voltage values
-		voltage_storage[indexval][0] = NR_busdata[indexval].V[0];
-		voltage_storage[indexval][1] = NR_busdata[indexval].V[1];
-		voltage_storage[indexval][2] = NR_busdata[indexval].V[2];
+		voltage_storage[3*indexval] = NR_busdata[indexval].V[0];
+		voltage_storage[3*indexval+1] = NR_busdata[indexval].V[1];
+		voltage_storage[3*indexval+2] = NR_busdata[indexval].V[2];
 	}
 }
 
@@ -3968,9 +3939,9 @@ void restoration::PowerflowRestore(void)
 	//Loop through and put the values back
 	for (indexval=0; indexval<NR_bus_count; indexval++)
 	{
-		NR_busdata[indexval].V[0] = voltage_storage[indexval][0];
-		NR_busdata[indexval].V[1] = voltage_storage[indexval][1];
-		NR_busdata[indexval].V[2] = voltage_storage[indexval][2];
+		NR_busdata[indexval].V[0] = voltage_storage[3*indexval];
+		NR_busdata[indexval].V[1] = voltage_storage[3*indexval+1];
+		NR_busdata[indexval].V[2] = voltage_storage[3*indexval+2];
 	}
 }
 
@@ -3980,162 +3951,86 @@ void restoration::PowerflowRestore(void)
 //delete all nodes of the linked list
 void Chain::delAllNodes(void)
 {
-	CHAINNODE *next;
-
-	while (first != NULL)
+	if (data != NULL)
 	{
-		next = first->link;
-
-		//Remove it
-		gl_free(first);
-
-		first = next;
+		gl_free(data);
 	}
-	first = NULL;
-	last = NULL;
+
+	data = NULL;
+	length = 0;
+	capacity = 0;
 }
 
 //if the linked list is empty, return 1.  Else return 0
 bool Chain::isempty(void)
 {
-	bool flag;
-
-	if (first == NULL)
-	{
-		flag = TRUE;
-	}
-	else
-	{
-		flag = FALSE;
-	}
-
-	return flag;
+	return (length == 0);
 }
 
 //return the length of the linked list
 int Chain::getLength(void)
 {
-	CHAINNODE *currentNode;
-	int length;
-	
-	length = 0;
-	currentNode = first;
-
-	while (currentNode != NULL)
-	{
-		length = length + 1;
-		currentNode = currentNode->link;
-	}
-
 	return length;
 }
 
-//search the linked list for given data.  If found, return index of 1st node.  If not found, return 0
+//search the linked list for given data.  If found, return index of 1st node.  If not found, return -1
 int Chain::search(int sData)
 {
 	int index;
-	CHAINNODE *currentNode;
 
-	index = 0;
-	currentNode = first;
-
-	while (currentNode != NULL)
+	for (index=0; index<length; index++)
 	{
-		if (currentNode->data != sData)
-		{
-			currentNode = currentNode->link;
-			index = index + 1;
-		}
-		else
+		if (data[index] == sData)
 		{
-			break;
+			return index;
 		}
 	}
 
-	if (currentNode == NULL)
-	{
-		index = -1;
-	}
-	
-	return index;
+	return -1;
 }
 
 //modifies node data.  Only 1st found data is modified.  If oldData is found, modify it and return 1
 //if oldData is not found, do nothing and return 0
 bool Chain::modify(int oldData, int newData)
 {
-	CHAINNODE *currentNode;
-	bool flag;
+	int index;
 
-	flag = FALSE;
-	currentNode = first;
+	index = search(oldData);
 
-	while (currentNode != NULL)
+	if (index == -1)
 	{
-		if (currentNode->data != oldData)
-		{
-			currentNode = currentNode->link;
-		}
-		else
-		{
-			break;
-		}
-	}
-
-	//if oldData is found:
-	if (currentNode != NULL)
-	{
-		if (currentNode->data == oldData)
-		{
-			currentNode->data = newData;
-			flag = TRUE;
-		}
-		//Default else -- leave it false
+		return FALSE;
 	}
 
-	//if oldData is not found:
-	if (currentNode == NULL)
-	{
-		flag = FALSE;
-	}
+	data[index] = newData;
 
-	return flag;
+	return TRUE;
 }
 
-//adds a new node after the kth node in the linked list.  If k is out of bounds, do nothing.  
-//if k = 0, add the new node as the first node
-void Chain::addNode(int kIndex, int newData)
+//make sure the list can hold newCapacity entries - grows geometrically so appends stay cheap
+void Chain::reserve(int newCapacity)
 {
-	CHAINNODE *currentNode, *newNode;
-	int currentIndex;
+	int *newData;
 
-	//check bounds
-	if (kIndex < 0)
+	if (newCapacity <= capacity)
 	{
-		GL_THROW("The index is out of bounds.");
+		return;
 	}
 
-	//find kth node
-	currentIndex = 0;	//Adjusted from 1
-	currentNode = first;
-	while ((currentIndex < kIndex) && (currentNode != NULL))
+	if (newCapacity < (2*capacity))
 	{
-		currentIndex = currentIndex + 1;
-		currentNode = currentNode->link;
+		newCapacity = 2*capacity;
 	}
 
-	//out of bounds
-	if ((kIndex > 0) && (currentNode==NULL))
+	if (newCapacity < 4)
 	{
-		GL_THROW("The index is out of bounds.");
+		newCapacity = 4;
 	}
 
-	//insert new node
-	//Malloc it
-	newNode = (CHAINNODE *)gl_malloc(sizeof(CHAINNODE));
+	newData = (int *)gl_malloc(newCapacity*sizeof(int));
 
 	//See if it worked
-	if (newNode == NULL)
+	if (newData == NULL)
 	{
 		GL_THROW("Restoration:Failed to allocate new node in chain");
 		/*  TROUBLESHOOT
@@ -4145,92 +4040,73 @@ void Chain::addNode(int kIndex, int newData)
 		*/
 	}
 
-	//Set the new data
-	newNode->data = newData;
-
-	if (kIndex > 0)
+	if (data != NULL)
 	{
-		newNode->link = currentNode->link;
-		currentNode->link = newNode;
-	} 
-	else
+		memcpy(newData,data,length*sizeof(int));
+		gl_free(data);
+	}
+
+	data = newData;
+	capacity = newCapacity;
+}
+
+//adds a new node after the kth node in the linked list.  If k is out of bounds, do nothing.  
+//if k = 0, add the new node as the first node
+void Chain::addNode(int kIndex, int newData)
+{
+	int index;
+
+	//check bounds
+	if ((kIndex < 0) || (kIndex > length))
 	{
-		newNode->link = first;
-		first = newNode;
+		GL_THROW("The index is out of bounds.");
 	}
-	
-	if (newNode->link == NULL)
+
+	reserve(length+1);
+
+	//Shift the tail up one and drop the new entry in
+	for (index=length; index>kIndex; index--)
 	{
-		last = newNode;
+		data[index] = data[index-1];
 	}
+
+	data[kIndex] = newData;
+	length++;
 }
 
 //Deletes the first found node found with data = dData
 //does nothing if dData is not found
 void Chain::deleteNode(int dData)
 {
-	CHAINNODE *currentNode, *trail;
+	int index;
 
-	currentNode = first;
-	trail = NULL;					//the node before currentNode
-	
-	while (currentNode != NULL)
-	{
-		if (currentNode->data != dData)
-		{
-			trail = currentNode;
-			currentNode = currentNode->link;
-		}
-		else
-		{
-			break;
-		}
-	}
+	index = search(dData);
 
-	if (currentNode == NULL)
+	if (index == -1)
 	{
 		GL_THROW("The data cannot be found.");
 	}
 
-	//if node with dData is found, delete that node
-	if (trail != NULL)
-	{
-		trail->link = currentNode->link;
-	}
-	else
-	{
-		first = currentNode->link;
-	}
-
-	if (currentNode->link == NULL)
+	//Close the gap, keeping the order
+	for (; index<(length-1); index++)
 	{
-		last = trail;
+		data[index] = data[index+1];
 	}
 
-	//remove the current node
-	gl_free(currentNode);
+	length--;
 }
 
 //make a copy of llist
 void Chain::copy(Chain *ilist)
 {
-	CHAINNODE *currNode;
-
-	//delete all nodes in llist2
-	if (first != NULL)
-	{
-		delAllNodes();
-	}
+	length = 0;
 
 	//copy nodes
-	if (ilist != NULL)
+	if ((ilist != NULL) && (ilist->length > 0))
 	{
-		currNode = ilist->first;
-		while (currNode != NULL)
-		{
-			append(currNode->data);
-			currNode = currNode->link;
-		}
+		reserve(ilist->length);
+		memcpy(data,ilist->data,ilist->length*sizeof(int));
+		length = ilist->length;
 	}
 	//Default else, it was empty, just ignore it?
 }
@@ -4238,32 +4114,10 @@ void Chain::copy(Chain *ilist)
 //add a new node at the end of the linked list llist
 void Chain::append(int newData)
 {
-	CHAINNODE *newNode;
-	
-	//Create a new node
-	newNode = (CHAINNODE *)gl_malloc(sizeof(CHAINNODE));
-
-	//Make sure it worked
-	if (newNode == NULL)
-	{
-		GL_THROW("Restoration:Failed to allocate new node in chain");
-		//Defined above
-	}
-
-	newNode->data = newData;
-
-	//Set initial link
-	newNode->link = NULL;
+	reserve(length+1);
 
-	if (first != NULL)
-	{
-		last->link = newNode;
-		last = newNode;
-	}
-	else {
-		first = newNode;
-		last = newNode;
-	}
+	data[length] = newData;
+	length++;
 }
 
 //****************************************/
@@ -4272,53 +4126,21 @@ void Chain::append(int newData)
 // Add a new node at the end of the queue
 void LinkedQueue::enQueue(int newData)
 {
-	CHAINNODE *newNode;
-
-	//Create one
-	newNode = (CHAINNODE *)gl_malloc(sizeof(CHAINNODE));
-
-	//Make sure it worked
-	if (newNode == NULL)
-	{
-		GL_THROW("Restoration:Failed to allocate new node in chain");
-		//Defined above
-	}
-
-	newNode->link = NULL;
-	newNode->data = newData;
-	
-	if (first != NULL)
-	{
-		last->link = newNode;
-		last = newNode;
-	}
-    else
-	{
-		first = newNode;
-		last = newNode;
-	}
+	append(newData);
 }
 
 // Delete the first node of the queue and return its data
 int LinkedQueue::deQueue(void)
 {
-	int fData;
-	CHAINNODE *tempNode;
-
 	if (isempty() == true)
 	{
 		GL_THROW("Restoration: The queue is empty!");
 	}
 
-	fData = first->data;
-	tempNode = first;
-
-	first = first->link;
+	//Entries ahead of head are spent - the array is only released with the queue
+	head++;
 
-	//Free it
-	gl_free(tempNode);
-
-	return fData;
+	return data[head-1];
 }
 
 //****************************************/
@@ -4327,45 +4149,38 @@ int LinkedQueue::deQueue(void)
 //initializes the iterator, takes as argument lList of class Chain
 int ChainIterator::initialize(Chain *lList)			
 {
-	int nData;
-
-	location = lList->first;
+	list = lList;
+	location = 0;
 
-	if (location != NULL)
+	if (list->length > 0)
 	{
-		nData = location->data;
+		return list->data[0];
 	}
 	else
 	{
-		nData = -1;
+		return -1;
 	}
-	
-	return nData;
 }
 
 
 //move pointer to next node
 int ChainIterator::next(void)
 {
-	int nData;
-
-	if (location == NULL)
+	if ((list == NULL) || (location >= list->length))
 	{
 		return -1;
 	}
 
-	location = location->link;
-	
-	if (location != NULL)
+	location++;
+
+	if (location < list->length)
 	{
-		nData = location->data;
+		return list->data[location];
 	}
 	else
 	{
-		nData = -1;
+		return -1;
 	}
-
-	return nData;
 }
 
 //****************************************/
@@ -4494,6 +4309,7 @@ void LinkedBase::delAllVer(void)
 		//Loop through and remove chain items
 		for (indexvar = 0; indexvar < numVertices; indexvar++)
 		{
+			adjList[indexvar]->delAllNodes();
 			gl_free(adjList[indexvar]);
 
 			//NULL it
@@ -4693,6 +4509,10 @@ void LinkedBase::BFS(int s)
 	
 	// Deactive the iterator
 	deactivatePos();
+
+	//Release the queue
+	Q->delAllNodes();
+	gl_free(Q);
 }
 
 // Depth-first search I: create a depth-first forest
@@ -5430,7 +5250,7 @@ int LinkedUndigraph::isolateDeg12Ver(INTVECT *iVer)
             if (getDeg(u) == 1)	//  Isolate vertices whose degree is 1
 			{
                 // find the vertex connected to u
-				v = adjList[u]->first->data;
+				v = adjList[u]->data[0];
                 // delete edge (u, v)
 				deleteEdge(u,v);
                 iNum = iNum + 1;
@@ -5440,8 +5260,8 @@ int LinkedUndigraph::isolateDeg12Ver(INTVECT *iVer)
             if (getDeg(u) == 2) //  Isolate vertices whose degree is 2
 			{
                 // find the vertices connected to u
-				v1 = adjList[u]->first->data;
-				v2 = adjList[u]->first->link->data;
+				v1 = adjList[u]->data[0];
+				v2 = adjList[u]->data[1];
                 // delete edge (u, v1) and (u, v2)
 				deleteEdge(u,v1);
 				deleteEdge(u,v2);
@@ -5462,8 +5282,7 @@ int LinkedUndigraph::isolateDeg12Ver(INTVECT *iVer)
 // Delete all isolated vertices (degree = 0)
 void LinkedUndigraph::deleteIsoVer(INTVECT *vMap)
 {
-	int idx, idx2, numIsoVer, newArraySize;
-	CHAINNODE *v;
+	int idx, idx2, numIsoVer, newArraySize, vPos;
 	INTVECT isoVerArray;
 	Chain **tempList;
 	bool allocation_needed;
@@ -5572,12 +5391,9 @@ void LinkedUndigraph::deleteIsoVer(INTVECT *vMap)
     // Modify index of vertices
     for (idx=0; idx<numVertices; idx++)
 	{
-		v = adjList[idx]->first;
-
-		while (v != NULL)
+		for (vPos=0; vPos<adjList[idx]->length; vPos++)
 		{
-			v->data = vMap->data[v->data];
-            v = v->link;
+			adjList[idx]->data[vPos] = vMap->data[adjList[idx]->data[vPos]];
 		}
 	}
     
@@ -5586,6 +5402,7 @@ void LinkedUndigraph::deleteIsoVer(INTVECT *vMap)
     for (idx=0; idx<numIsoVer; idx++)
 	{
 		//Remove items no longer needed
+		adjList[isoVerArray.data[idx]]->delAllNodes();
 		gl_free(adjList[isoVerArray.data[idx]]);
 
 		//Null it, to be safe -- theoretically done, but be paranoid
@@ -5715,7 +5532,8 @@ void LinkedUndigraph::mergeVer_2(INTVECT *vMap)
 {
 	int idx, tempidx, n_V_new, k, numIsoVer, newArraySize, numFound;
 	INTVECT V_new, isoVerArray, resVerArray, merge_V, tempoutVect;
-	CHAINNODE *cur_ver, *next_ver;
+	int cur_ver, cur_pos;
+	Chain *cur_list;
 	Chain **tempList;
 
 	//Initialize local variables, just in case
@@ -5816,33 +5634,32 @@ void LinkedUndigraph::mergeVer_2(INTVECT *vMap)
 		//Check for empty
 		if (merge_V.data[0] == -1)	//Empty
 		{
-			cur_ver = NULL;
+			cur_list = NULL;
 		}
 		else
 		{
-			cur_ver = adjList[merge_V.data[0]]->first;
+			cur_list = adjList[merge_V.data[0]];
 		}
 
-		while (cur_ver != NULL)
+		cur_pos = 0;
+		while ((cur_list != NULL) && (cur_pos < cur_list->length))
 		{
-			if (cur_ver->link != NULL)
-			{
-				next_ver = cur_ver->link;
-			}
-			else
-			{
-				next_ver = NULL;
-			}
+			cur_ver = cur_list->data[cur_pos];
 
 			//See if something can be found
-			find_int(&merge_V,&tempoutVect,cur_ver->data,1);
+			find_int(&merge_V,&tempoutVect,cur_ver,1);
 
 			//Check
 			if (tempoutVect.currSize != -1)
 			{
-				deleteEdge(merge_V.data[0],cur_ver->data);
+				deleteEdge(merge_V.data[0],cur_ver);
+			}
+
+			//Only step on if the entry is still there - deleting it pulls the next one into place
+			if ((cur_pos < cur_list->length) && (cur_list->data[cur_pos] == cur_ver))
+			{
+				cur_pos++;
 			}
-            cur_ver = next_ver;
 		}
         
         for (k=1; k<numFound; k++)	//Starts 1 index higher (started at 2 in ML)
@@ -5850,38 +5667,37 @@ void LinkedUndigraph::mergeVer_2(INTVECT *vMap)
 			//Initial check
 			if (merge_V.data[k] != -1)	//Empty
 			{
-				cur_ver = adjList[merge_V.data[k]]->first;
+				cur_list = adjList[merge_V.data[k]];
 			}
 			else	//Empty
 			{
-				cur_ver = NULL;
+				cur_list = NULL;
 			}
 
-            while (cur_ver != NULL)
+			cur_pos = 0;
+			while ((cur_list != NULL) && (cur_pos < cur_list->length))
 			{
-				if (cur_ver->link != NULL)
-				{
-					next_ver = cur_ver->link;
-				}
-				else
-				{
-					next_ver = NULL;
-				}
+				cur_ver = cur_list->data[cur_pos];
 
 				//See if anything more is found
-				find_int(&merge_V,&tempoutVect,cur_ver->data,1);
+				find_int(&merge_V,&tempoutVect,cur_ver,1);
 
 				//Check
 				if (tempoutVect.currSize != -1)
 				{
-					deleteEdge(merge_V.data[k],cur_ver->data);
+					deleteEdge(merge_V.data[k],cur_ver);
 				}
                 else
 				{
-					addEdge(merge_V.data[0],cur_ver->data);
-					deleteEdge(merge_V.data[k],cur_ver->data);
+					addEdge(merge_V.data[0],cur_ver);
+					deleteEdge(merge_V.data[k],cur_ver);
+				}
+
+				//Only step on if the entry is still there - deleting it pulls the next one into place
+				if ((cur_pos < cur_list->length) && (cur_list->data[cur_pos] == cur_ver))
+				{
+					cur_pos++;
 				}
-                cur_ver = next_ver;
 			}
 		}
 	}
@@ -5889,11 +5705,9 @@ void LinkedUndigraph::mergeVer_2(INTVECT *vMap)
     // Modify indexes of vertices
     for (idx=0; idx<numVertices; idx++)
 	{
-		cur_ver = adjList[idx]->first;
-        while (cur_ver != NULL)
+		for (cur_pos=0; cur_pos<adjList[idx]->length; cur_pos++)
 		{
-			cur_ver->data = vMap->data[cur_ver->data];
-            cur_ver = cur_ver->link;
+			adjList[idx]->data[cur_pos] = vMap->data[adjList[idx]->data[cur_pos]];
 		}
 	}
 
@@ -5902,6 +5716,7 @@ void LinkedUndigraph::mergeVer_2(INTVECT *vMap)
     for (idx=0; idx<numIsoVer; idx++)
 	{
 		//Remove items no longer needed
+		adjList[isoVerArray.data[idx]]->delAllNodes();
 		gl_free(adjList[isoVerArray.data[idx]]);
 
 		//Null it, to be safe -- theoretically done, but be paranoid
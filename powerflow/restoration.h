@@ -7,11 +7,6 @@
 #include "powerflow.h"
 #include "powerflow_library.h"
 
-typedef struct s_ChainNode {
-	int data;
-	struct s_ChainNode *link;
-} CHAINNODE;	///Node of the linked list
-
 typedef struct s_intVect {
 	int *data;
 	int currSize;
@@ -51,17 +46,19 @@ typedef struct s_BranchVertices {
 	int to_vert;	//To vertex
 } BRANCHVERTICES;
 
-//ChainNode class
+//Chain class - adjacency/work list kept in one contiguous array
 class Chain
 {
 public: //member properties
-	CHAINNODE *first;												//first node of linked list
-	CHAINNODE *last;												//last node of linked list
+	int *data;														//entries of the list, in order
+	int length;														//number of entries in use
+	int capacity;													//number of entries allocated
 public: //member constructor
 	inline Chain()
 	{
-		first = NULL;
-		last = NULL;
+		data = NULL;
+		length = 0;
+		capacity = 0;
 	}
 public: //member functions
 	void delAllNodes(void);					//deletes all nodes in linked list
@@ -73,13 +70,16 @@ public: //member functions
 	void deleteNode(int dData);				//delete 1st node found containing dData.  If not found, do nothing
 	void copy(Chain *ilist);				//copy a linked list into a new linked list
 	void append(int newData);				//add a new node containing newData at the end of the linked list
+	void reserve(int newCapacity);			//make sure at least newCapacity entries are allocated
 };
 
 //LinkedQueue class
 class LinkedQueue : public Chain
 {
 public:
-	inline LinkedQueue():Chain(){};		//Constructor link
+	int head;							//index of the front of the queue
+	inline LinkedQueue():Chain(){head = 0;};		//Constructor link
+	inline bool isempty(void){return (head >= length);};	//checks if the queue is empty
 	void enQueue(int newData);			//add new node at end of the queue
 	int deQueue(void);					//delete first node of queue and return its data
 };
@@ -88,11 +88,13 @@ public:
 class ChainIterator
 {
 public: // member properties
-	CHAINNODE *location;			//a pointer to a node of a linked list
+	Chain *list;					//list being iterated
+	int location;					//index of the current entry of the list
 public: // class constructor
 	inline ChainIterator()
 	{
-		location = NULL;
+		list = NULL;
+		location = 0;
 	}
 public: // member functions
 	int initialize(Chain *lList);	//initializes the iterator, takes as argument lList of class Chain
@@ -264,7 +266,7 @@ private:
 	CANDSWOP candidateSwOpe_1;			//Candidate switching operations on top_sim_1
 	CANDSWOP candidateSwOpe_2;			//Candidate switching operations on top_sim_2
 
-	complex **voltage_storage;			//Voltage storage - to restore when powerflow dies a horrible death
+	complex *voltage_storage;			//Voltage storage (three phases per bus) - to restore when powerflow dies a horrible death
 
 	//Voltage saving (value saving) functions
 	void PowerflowSave(void);
@@ -0,0 +1,580 @@
+/** $Id
+
+	@file snapshotdump.cpp
+
+	Writes the Newton-Raphson bus and branch arrays to a binary, column-ordered
+	file.  Unlike voltdump and currdump nothing is looked up or formatted per
+	object - the values are read straight from NR_busdata/NR_branchdata.
+
+	The file starts with a header that is written once:
+	- char[8] SNAPSHOT_MAGIC, uint32 SNAPSHOT_VERSION, uint32 bus count, uint32 branch count
+	- bus columns: uint8 type, double volt_base, then each name as uint32 length + characters
+	- branch columns: int32 from bus, int32 to bus, uint8 link type, then the names
+
+	and is followed by one record per snapshot:
+	- char[4] "SNAP", int64 timestamp, uint32 record flags (SNAPSHOT_DELTA, SNAPSHOT_ADMITTANCE)
+	- uint32 bus entries, uint32 bus index column (delta records only), uint8 phases column,
+	  then six double columns: voltage A real, A imaginary, B real, B imaginary, C real, C imaginary
+	- the same for the branches, with a uint8 status column after the phases and the
+	  current flowing into the link in the double columns
+	- with SNAPSHOT_ADMITTANCE: uint32 rows, uint32 entries, uint32 row pointers[rows+1],
+	  uint32 column indices[entries], double values[entries] - the fixed portion of the
+	  NR admittance matrix (the load-dependent diagonal terms are not included)
+
+	Delta records only hold the buses and branches whose phases changed or whose value
+	on some phase moved by more than delta_tolerance (relative to the value last written),
+	and only carry the admittance matrix when it differs from the one last written.
+	powerflow/snapshotdump.py reads the files back and rebuilds the full state from the
+	delta records.
+
+	@{
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "snapshotdump.h"
+
+//////////////////////////////////////////////////////////////////////////
+// snapshotdump CLASS FUNCTIONS
+//////////////////////////////////////////////////////////////////////////
+
+CLASS* snapshotdump::oclass = NULL;
+
+snapshotdump::snapshotdump(MODULE *mod)
+{
+	if (oclass==NULL)
+	{
+		// register the class definition
+		oclass = gl_register_class(mod,"snapshotdump",sizeof(snapshotdump),PC_BOTTOMUP|PC_AUTOLOCK);
+		if (oclass==NULL)
+			throw "unable to register class snapshotdump";
+		else
+			oclass->trl = TRL_PROTOTYPE;
+
+		// publish the class properties
+		if (gl_publish_variable(oclass,
+			PT_timestamp,"runtime",PADDR(runtime),PT_DESCRIPTION,"the time to take the snapshot",
+			PT_char256,"filename",PADDR(filename),PT_DESCRIPTION,"the file to write the snapshots into",
+			PT_char256,"file",PADDR(filename),PT_DESCRIPTION,"the file to write the snapshots into",
+			PT_int32,"runcount",PADDR(runcount),PT_ACCESS,PA_REFERENCE,PT_DESCRIPTION,"the number of snapshots written",
+			PT_int32,"maxcount",PADDR(maxcount),PT_DESCRIPTION,"the maximum number of snapshots written",
+			PT_double, "interval[s]", PADDR(interval), PT_DESCRIPTION, "interval at which snapshots are taken",
+			PT_bool, "delta", PADDR(delta), PT_DESCRIPTION, "only write the buses and branches that changed since the previous snapshot",
+			PT_double, "delta_tolerance", PADDR(delta_tolerance), PT_DESCRIPTION, "relative change of a voltage or current before a delta snapshot includes it",
+			PT_bool, "admittance", PADDR(admittance), PT_DESCRIPTION, "include the NR admittance matrix, in CSR form, in the snapshots",
+			NULL)<1) GL_THROW("unable to publish properties in %s",__FILE__);
+	}
+}
+
+
+int snapshotdump::create(void)
+{
+	runtime = TS_NEVER;
+	runcount = 0;
+	maxcount = -1;
+	interval = 0;
+	delta = false;
+	delta_tolerance = 0.0;
+	admittance = false;
+
+	bus_count = branch_count = 0;
+	last_V = last_I = NULL;
+	last_bus_phases = last_branch_phases = NULL;
+	index = NULL;
+	column = NULL;
+	flags = NULL;
+	for (int n=0; n<2; n++)
+	{
+		Y_row[n] = Y_col[n] = NULL;
+		Y_value[n] = NULL;
+		Y_rows[n] = Y_nnz[n] = 0;
+	}
+	Y_work = Y_work_row = Y_work_col = NULL;
+	Y_work_value = NULL;
+	Y_max_rows = Y_max_nnz = 0;
+	return 1;
+}
+
+int snapshotdump::init(OBJECT *parent)
+{
+	if (solver_method!=SM_NR)
+	{
+		GL_THROW("snapshotdump:%d - %s - only the NR solver is supported",get_id(),get_name());
+		/*  TROUBLESHOOT
+		The snapshotdump object writes the Newton-Raphson bus and branch arrays, which are only
+		built when the powerflow module uses solver_method NR.  Use voltdump and currdump for the
+		other solvers.
+		*/
+	}
+	if (delta_tolerance < 0)
+	{
+		gl_error("negative delta_tolerance is not permitted");
+		return 0;
+	}
+
+	unlink(filename);
+	if ( interval < 0 )
+	{
+		gl_error("negative interval is not permitted");
+		return 0;
+	}
+	else if ( interval > 0 )
+	{
+		if ( maxcount < 0 )
+		{
+			maxcount = 0;
+		}
+		runtime = TS_NEVER;
+	}
+	else
+	{
+		if ( maxcount < 0 )
+		{
+			maxcount = 1;
+		}
+	}
+	return 1;
+}
+
+int snapshotdump::isa(CLASSNAME classname)
+{
+	return strcmp(classname,"snapshotdump")==0;
+}
+
+//Checks the three phases of value against the last values written - copies them over if any moved enough
+bool snapshotdump::changed(double *last, double *value)
+{
+	int n;
+	double diff_re, diff_im, base;
+
+	for (n=0; n<6; n+=2)
+	{
+		diff_re = value[n] - last[n];
+		diff_im = value[n+1] - last[n+1];
+		base = delta_tolerance*delta_tolerance*(last[n]*last[n] + last[n+1]*last[n+1]);
+		if ((diff_re*diff_re + diff_im*diff_im) > base)
+			break;
+	}
+	if (n==6)
+		return false;
+
+	memcpy(last,value,6*sizeof(double));
+	return true;
+}
+
+//Writes the names and the static columns, and sizes the arrays the records are built in
+bool snapshotdump::write_header(FILE *fp)
+{
+	unsigned int version = SNAPSHOT_VERSION;
+	unsigned int max_count, indexval, length;
+	char namestr[64];
+	const char *name;
+	OBJECT *obj;
+
+	bus_count = NR_bus_count;
+	branch_count = NR_branch_count;
+	max_count = (bus_count > branch_count) ? bus_count : branch_count;
+
+	last_V = (double *)gl_malloc(6*bus_count*sizeof(double));
+	last_I = (double *)gl_malloc(6*(branch_count+1)*sizeof(double));
+	last_bus_phases = (unsigned char *)gl_malloc(bus_count*sizeof(unsigned char));
+	last_branch_phases = (unsigned char *)gl_malloc((branch_count+1)*sizeof(unsigned char));
+	index = (unsigned int *)gl_malloc(max_count*sizeof(unsigned int));
+	column = (double *)gl_malloc(max_count*sizeof(double));
+	flags = (unsigned char *)gl_malloc(max_count*sizeof(unsigned char));
+	if (last_V==NULL || last_I==NULL || last_bus_phases==NULL || last_branch_phases==NULL || index==NULL || column==NULL || flags==NULL)
+	{
+		gl_error("snapshotdump: unable to allocate memory for %d buses and %d branches",bus_count,branch_count);
+		/*  TROUBLESHOOT
+		The snapshotdump object was unable to allocate the arrays it assembles its records in.
+		Please try again.  If the error persists, please submit your code and a bug report via the trac website.
+		*/
+		return false;
+	}
+
+	fwrite(SNAPSHOT_MAGIC,sizeof(char),8,fp);
+	fwrite(&version,sizeof(unsigned int),1,fp);
+	fwrite(&bus_count,sizeof(unsigned int),1,fp);
+	fwrite(&branch_count,sizeof(unsigned int),1,fp);
+
+	//Bus columns
+	for (indexval=0; indexval<bus_count; indexval++)
+		flags[indexval] = (unsigned char)NR_busdata[indexval].type;
+	fwrite(flags,sizeof(unsigned char),bus_count,fp);
+	for (indexval=0; indexval<bus_count; indexval++)
+		column[indexval] = NR_busdata[indexval].volt_base;
+	fwrite(column,sizeof(double),bus_count,fp);
+	for (indexval=0; indexval<bus_count; indexval++)
+	{
+		obj = NR_busdata[indexval].obj;
+		name = NR_busdata[indexval].name;
+		if (name==NULL)
+		{
+			snprintf(namestr,sizeof(namestr),"%s:%d",obj->oclass->name,obj->id);
+			name = namestr;
+		}
+		length = (unsigned int)strlen(name);
+		fwrite(&length,sizeof(unsigned int),1,fp);
+		fwrite(name,sizeof(char),length,fp);
+	}
+
+	//Branch columns
+	for (indexval=0; indexval<branch_count; indexval++)
+		index[indexval] = (unsigned int)NR_branchdata[indexval].from;
+	fwrite(index,sizeof(unsigned int),branch_count,fp);
+	for (indexval=0; indexval<branch_count; indexval++)
+		index[indexval] = (unsigned int)NR_branchdata[indexval].to;
+	fwrite(index,sizeof(unsigned int),branch_count,fp);
+	for (indexval=0; indexval<branch_count; indexval++)
+		flags[indexval] = NR_branchdata[indexval].lnk_type;
+	fwrite(flags,sizeof(unsigned char),branch_count,fp);
+	for (indexval=0; indexval<branch_count; indexval++)
+	{
+		obj = NR_branchdata[indexval].obj;
+		name = NR_branchdata[indexval].name;
+		if (name==NULL)
+		{
+			snprintf(namestr,sizeof(namestr),"%s:%d",obj->oclass->name,obj->id);
+			name = namestr;
+		}
+		length = (unsigned int)strlen(name);
+		fwrite(&length,sizeof(unsigned int),1,fp);
+		fwrite(name,sizeof(char),length,fp);
+	}
+
+	return true;
+}
+
+//Assembles the fixed portion of the NR admittance matrix into the [1] CSR arrays, sorted by
+//row and then column.  Returns true if it differs from the matrix in [0].
+bool snapshotdump::build_admittance(void)
+{
+	unsigned int rows, nnz, entry, indexval, pos, count;
+	Y_NR *source;
+
+	rows = 2*NR_powerflow.total_variables;
+	nnz = NR_powerflow.size_offdiag_PQ + NR_powerflow.size_diag_fixed;
+
+	if (rows > Y_max_rows || nnz > Y_max_nnz)
+	{
+		if (rows > Y_max_rows)
+			Y_max_rows = rows;
+		if (nnz > Y_max_nnz)
+			Y_max_nnz = nnz;
+		for (indexval=0; indexval<2; indexval++)
+		{
+			if (Y_row[indexval]!=NULL)
+			{
+				gl_free(Y_row[indexval]);
+				gl_free(Y_col[indexval]);
+				gl_free(Y_value[indexval]);
+			}
+			Y_row[indexval] = (unsigned int *)gl_malloc((Y_max_rows+1)*sizeof(unsigned int));
+			Y_col[indexval] = (unsigned int *)gl_malloc((Y_max_nnz+1)*sizeof(unsigned int));
+			Y_value[indexval] = (double *)gl_malloc((Y_max_nnz+1)*sizeof(double));
+		}
+		if (Y_work!=NULL)
+		{
+			gl_free(Y_work);
+			gl_free(Y_work_row);
+			gl_free(Y_work_col);
+			gl_free(Y_work_value);
+		}
+		Y_work = (unsigned int *)gl_malloc((Y_max_rows+1)*sizeof(unsigned int));
+		Y_work_row = (unsigned int *)gl_malloc((Y_max_nnz+1)*sizeof(unsigned int));
+		Y_work_col = (unsigned int *)gl_malloc((Y_max_nnz+1)*sizeof(unsigned int));
+		Y_work_value = (double *)gl_malloc((Y_max_nnz+1)*sizeof(double));
+
+		//Anything written before no longer fits - force the next comparison to fail
+		Y_rows[0] = 0;
+		if (Y_row[0]==NULL || Y_row[1]==NULL || Y_col[0]==NULL || Y_col[1]==NULL || Y_value[0]==NULL || Y_value[1]==NULL
+			|| Y_work==NULL || Y_work_row==NULL || Y_work_col==NULL || Y_work_value==NULL)
+		{
+			GL_THROW("snapshotdump: unable to allocate memory for the admittance matrix");
+			/*  TROUBLESHOOT
+			The snapshotdump object was unable to allocate the arrays it assembles the admittance matrix in.
+			Please try again.  If the error persists, please submit your code and a bug report via the trac website.
+			*/
+		}
+	}
+
+	//Bucket by column first, so the stable pass by row leaves each row sorted by column
+	memset(Y_work,0,(rows+1)*sizeof(unsigned int));
+	for (entry=0; entry<nnz; entry++)
+	{
+		source = (entry < NR_powerflow.size_offdiag_PQ) ? &NR_powerflow.Y_offdiag_PQ[entry] : &NR_powerflow.Y_diag_fixed[entry-NR_powerflow.size_offdiag_PQ];
+		Y_work[source->col_ind+1]++;
+	}
+	for (indexval=0; indexval<rows; indexval++)
+		Y_work[indexval+1] += Y_work[indexval];
+	for (entry=0; entry<nnz; entry++)
+	{
+		source = (entry < NR_powerflow.size_offdiag_PQ) ? &NR_powerflow.Y_offdiag_PQ[entry] : &NR_powerflow.Y_diag_fixed[entry-NR_powerflow.size_offdiag_PQ];
+		pos = Y_work[source->col_ind]++;
+		Y_work_row[pos] = source->row_ind;
+		Y_work_col[pos] = source->col_ind;
+		Y_work_value[pos] = source->Y_value;
+	}
+
+	memset(Y_row[1],0,(rows+1)*sizeof(unsigned int));
+	for (entry=0; entry<nnz; entry++)
+		Y_row[1][Y_work_row[entry]+1]++;
+	for (indexval=0; indexval<rows; indexval++)
+		Y_row[1][indexval+1] += Y_row[1][indexval];
+	memcpy(Y_work,Y_row[1],rows*sizeof(unsigned int));
+	for (entry=0; entry<nnz; entry++)
+	{
+		pos = Y_work[Y_work_row[entry]]++;
+		Y_col[1][pos] = Y_work_col[entry];
+		Y_value[1][pos] = Y_work_value[entry];
+	}
+	Y_rows[1] = rows;
+	Y_nnz[1] = nnz;
+
+	if (Y_rows[0]!=rows || Y_nnz[0]!=nnz)
+		return true;
+	count = (rows+1)*sizeof(unsigned int);
+	if (memcmp(Y_row[0],Y_row[1],count)!=0)
+		return true;
+	if (memcmp(Y_col[0],Y_col[1],nnz*sizeof(unsigned int))!=0)
+		return true;
+	return memcmp(Y_value[0],Y_value[1],nnz*sizeof(double))!=0;
+}
+
+//Writes the [1] admittance matrix and keeps it as the last one written
+void snapshotdump::write_admittance(FILE *fp)
+{
+	unsigned int *temp_index;
+	double *temp_value;
+
+	fwrite(&Y_rows[1],sizeof(unsigned int),1,fp);
+	fwrite(&Y_nnz[1],sizeof(unsigned int),1,fp);
+	fwrite(Y_row[1],sizeof(unsigned int),Y_rows[1]+1,fp);
+	fwrite(Y_col[1],sizeof(unsigned int),Y_nnz[1],fp);
+	fwrite(Y_value[1],sizeof(double),Y_nnz[1],fp);
+
+	temp_index = Y_row[0]; Y_row[0] = Y_row[1]; Y_row[1] = temp_index;
+	temp_index = Y_col[0]; Y_col[0] = Y_col[1]; Y_col[1] = temp_index;
+	temp_value = Y_value[0]; Y_value[0] = Y_value[1]; Y_value[1] = temp_value;
+	Y_rows[0] = Y_rows[1];
+	Y_nnz[0] = Y_nnz[1];
+}
+
+void snapshotdump::dump(TIMESTAMP t)
+{
+	FILE *outfile = NULL;
+	bool first = (bus_count==0);
+	bool delta_record;
+	unsigned int record_flags, entries, indexval, phase;
+	double values[6];
+	int64 timestamp = t;
+	link_object *plink;
+
+	if (NR_bus_count==0 || NR_busdata==NULL)
+	{
+		gl_warning("snapshotdump: no NR buses were found to dump");
+		return;
+	}
+	if (!first && (bus_count!=NR_bus_count || branch_count!=NR_branch_count))
+	{
+		gl_error("snapshotdump: the NR bus or branch count changed after %s was started",filename.get_string());
+		/*  TROUBLESHOOT
+		The snapshot file header lists the buses and branches once, so the records that follow
+		must keep describing the same system.  The NR arrays of the powerflow module changed size
+		after the first snapshot, which should not happen - please submit your code and a bug report
+		via the trac website.
+		*/
+		return;
+	}
+
+	outfile = fopen(filename, first ? "wb" : "ab");
+	if (outfile == NULL)
+	{
+		gl_error("snapshotdump unable to open %s for output", filename.get_string());
+		return;
+	}
+	if (first && !write_header(outfile))
+	{
+		fclose(outfile);
+		bus_count = 0;
+		return;
+	}
+
+	delta_record = (delta && !first);
+	record_flags = delta_record ? SNAPSHOT_DELTA : 0;
+	if (admittance && NR_powerflow.Y_offdiag_PQ!=NULL && NR_powerflow.Y_diag_fixed!=NULL)
+	{
+		if (build_admittance() || !delta_record)
+			record_flags |= SNAPSHOT_ADMITTANCE;
+	}
+
+	fwrite("SNAP",sizeof(char),4,outfile);
+	fwrite(&timestamp,sizeof(int64),1,outfile);
+	fwrite(&record_flags,sizeof(unsigned int),1,outfile);
+
+	//Buses - pick the entries, then write them column by column
+	entries = 0;
+	for (indexval=0; indexval<bus_count; indexval++)
+	{
+		for (phase=0; phase<3; phase++)
+		{
+			values[2*phase] = NR_busdata[indexval].V[phase].Re();
+			values[2*phase+1] = NR_busdata[indexval].V[phase].Im();
+		}
+		if (!delta_record || NR_busdata[indexval].phases!=last_bus_phases[indexval])
+		{
+			memcpy(&last_V[6*indexval],values,6*sizeof(double));
+			last_bus_phases[indexval] = NR_busdata[indexval].phases;
+			index[entries++] = indexval;
+		}
+		else if (changed(&last_V[6*indexval],values))
+			index[entries++] = indexval;
+	}
+	fwrite(&entries,sizeof(unsigned int),1,outfile);
+	if (delta_record)
+		fwrite(index,sizeof(unsigned int),entries,outfile);
+	for (indexval=0; indexval<entries; indexval++)
+		flags[indexval] = last_bus_phases[index[indexval]];
+	fwrite(flags,sizeof(unsigned char),entries,outfile);
+	for (phase=0; phase<6; phase++)
+	{
+		for (indexval=0; indexval<entries; indexval++)
+			column[indexval] = last_V[6*index[indexval]+phase];
+		fwrite(column,sizeof(double),entries,outfile);
+	}
+
+	//Branches
+	entries = 0;
+	for (indexval=0; indexval<branch_count; indexval++)
+	{
+		plink = OBJECTDATA(NR_branchdata[indexval].obj,link_object);
+		for (phase=0; phase<3; phase++)
+		{
+			values[2*phase] = plink->read_I_in[phase].Re();
+			values[2*phase+1] = plink->read_I_in[phase].Im();
+		}
+		if (!delta_record || NR_branchdata[indexval].phases!=last_branch_phases[indexval])
+		{
+			memcpy(&last_I[6*indexval],values,6*sizeof(double));
+			last_branch_phases[indexval] = NR_branchdata[indexval].phases;
+			index[entries++] = indexval;
+		}
+		else if (changed(&last_I[6*indexval],values))
+			index[entries++] = indexval;
+	}
+	fwrite(&entries,sizeof(unsigned int),1,outfile);
+	if (delta_record)
+		fwrite(index,sizeof(unsigned int),entries,outfile);
+	for (indexval=0; indexval<entries; indexval++)
+		flags[indexval] = last_branch_phases[index[indexval]];
+	fwrite(flags,sizeof(unsigned char),entries,outfile);
+	for (indexval=0; indexval<entries; indexval++)
+		flags[indexval] = (NR_branchdata[index[indexval]].status!=NULL) ? (unsigned char)*NR_branchdata[index[indexval]].status : 0;
+	fwrite(flags,sizeof(unsigned char),entries,outfile);
+	for (phase=0; phase<6; phase++)
+	{
+		for (indexval=0; indexval<entries; indexval++)
+			column[indexval] = last_I[6*index[indexval]+phase];
+		fwrite(column,sizeof(double),entries,outfile);
+	}
+
+	if (record_flags & SNAPSHOT_ADMITTANCE)
+		write_admittance(outfile);
+
+	fclose(outfile);
+}
+
+TIMESTAMP snapshotdump::commit(TIMESTAMP t)
+{
+	if ( interval != 0 )
+	{
+		unsigned long long dt = (unsigned long long)interval;
+		if ( t % dt == 0 )
+		{
+			dump(t);
+			++runcount;
+		}
+		return ( maxcount > 0 && runcount > maxcount) ? TS_NEVER : ((t/dt)+1)*dt;
+	}
+
+	if ( runtime == 0 )
+	{
+		runtime = t;
+	}
+	if ( (t >= runtime || runtime == TS_NEVER) && (runcount < maxcount || maxcount < 0) )
+	{
+		/* dump */
+		dump(t);
+		++runcount;
+	}
+	return TS_NEVER;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// IMPLEMENTATION OF CORE LINKAGE: snapshotdump
+//////////////////////////////////////////////////////////////////////////
+
+/**
+* REQUIRED: allocate and initialize an object.
+*
+* @param obj a pointer to a pointer of the last object in the list
+* @param parent a pointer to the parent of this object
+* @return 1 for a successfully created object, 0 for error
+*/
+EXPORT int create_snapshotdump(OBJECT **obj, OBJECT *parent)
+{
+	try
+	{
+		*obj = gl_create_object(snapshotdump::oclass);
+		if (*obj!=NULL)
+		{
+			snapshotdump *my = OBJECTDATA(*obj,snapshotdump);
+			gl_set_parent(*obj,parent);
+			return my->create();
+		}
+		else
+			return 0;
+	}
+	CREATE_CATCHALL(snapshotdump);
+}
+
+EXPORT int init_snapshotdump(OBJECT *obj)
+{
+	try {
+		snapshotdump *my = OBJECTDATA(obj,snapshotdump);
+		return my->init(obj->parent);
+	}
+	INIT_CATCHALL(snapshotdump);
+}
+
+EXPORT TIMESTAMP sync_snapshotdump(OBJECT *obj, TIMESTAMP t1, PASSCONFIG pass)
+{
+	try
+	{
+		snapshotdump *my = OBJECTDATA(obj,snapshotdump);
+		TIMESTAMP rv;
+		obj->clock = t1;
+		rv = my->runtime > t1 ? my->runtime : TS_NEVER;
+		return rv;
+	}
+	SYNC_CATCHALL(snapshotdump);
+}
+
+EXPORT TIMESTAMP commit_snapshotdump(OBJECT *obj, TIMESTAMP t1, TIMESTAMP t2){
+	try {
+		snapshotdump *my = OBJECTDATA(obj,snapshotdump);
+		return my->commit(t1);
+	}
+	I_CATCHALL(commit,snapshotdump);
+}
+
+EXPORT int isa_snapshotdump(OBJECT *obj, CLASSNAME classname)
+{
+	return OBJECTDATA(obj,snapshotdump)->isa(classname);
+}
+
+/**@}*/
@@ -0,0 +1,66 @@
+/* $Id
+ * Binary snapshot dump of the Newton-Raphson bus and branch arrays
+ */
+
+#ifndef _SNAPSHOTDUMP_H
+#define _SNAPSHOTDUMP_H
+
+#include "powerflow.h"
+#include "link.h"
+
+#define SNAPSHOT_MAGIC "GLDPFSNP"	///< first bytes of a snapshot file
+#define SNAPSHOT_VERSION 1			///< layout version written after the magic
+
+#define SNAPSHOT_DELTA 0x01			///< record only holds the buses/branches that changed since the last record
+#define SNAPSHOT_ADMITTANCE 0x02	///< record is followed by the admittance matrix in CSR form
+
+class snapshotdump : public gld_object
+{
+public:
+	TIMESTAMP runtime;
+	char256 filename;
+	int32 runcount;
+	int32 maxcount;
+	double interval;
+	bool delta;				///< write change-only records after the first snapshot
+	double delta_tolerance;	///< relative change a value needs before a delta record includes it
+	bool admittance;		///< append the NR admittance matrix to the records
+private:
+	unsigned int bus_count;		///< buses the header was written for - 0 until the first snapshot
+	unsigned int branch_count;	///< branches the header was written for
+	double *last_V;				///< bus voltages as of the last record, 6*bus+n
+	double *last_I;				///< branch currents as of the last record, 6*branch+n
+	unsigned char *last_bus_phases;		///< bus phases as of the last record
+	unsigned char *last_branch_phases;	///< branch phases as of the last record
+	unsigned int *index;		///< scratch list of the entries a record holds
+	double *column;				///< scratch column
+	unsigned char *flags;		///< scratch per-entry column
+	unsigned int *Y_row[2];		///< CSR row pointers - [0] is the admittance last written, [1] the one being built
+	unsigned int *Y_col[2];		///< CSR column indices
+	double *Y_value[2];			///< CSR values
+	unsigned int *Y_work;		///< scratch counts/positions for the CSR sort
+	unsigned int *Y_work_row;	///< scratch row indices for the CSR sort
+	unsigned int *Y_work_col;	///< scratch column indices for the CSR sort
+	double *Y_work_value;		///< scratch values for the CSR sort
+	unsigned int Y_rows[2];		///< rows of each admittance - [0] is 0 if none was written yet
+	unsigned int Y_nnz[2];		///< entries of each admittance
+	unsigned int Y_max_rows;	///< rows the CSR arrays are allocated for
+	unsigned int Y_max_nnz;		///< entries the CSR arrays are allocated for
+public:
+	static CLASS *oclass;
+public:
+	snapshotdump(MODULE *mod);
+	int create(void);
+	int init(OBJECT *parent);
+	TIMESTAMP commit(TIMESTAMP t);
+	int isa(CLASSNAME classname);
+
+	void dump(TIMESTAMP t);
+private:
+	bool changed(double *last, double *value);
+	bool write_header(FILE *fp);
+	bool build_admittance(void);
+	void write_admittance(FILE *fp);
+};
+
+#endif // _SNAPSHOTDUMP_H
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Reads the binary files written by the powerflow snapshotdump object.
+
+The layout is described at the top of snapshotdump.cpp.  Values are in the
+byte order of the machine that wrote the file, which is assumed to match the
+machine reading it.  Delta records are applied on top of the previous
+snapshot, so every snapshot returned holds the full state of the system.
+
+Usage: snapshotdump.py [--voltages|--currents] [--record N] file
+
+Without an option, one summary line is printed per record: the timestamp, the
+record flags, the number of bus and branch entries and the size of the
+admittance matrix it carries.  --voltages prints the bus voltages and
+--currents the branch currents of the last record (or of record N) in the
+rectangular voltdump/currdump column layout.
+"""
+
+import struct
+import sys
+
+SNAPSHOT_MAGIC = b'GLDPFSNP'
+SNAPSHOT_VERSION = 1
+SNAPSHOT_DELTA = 0x01
+SNAPSHOT_ADMITTANCE = 0x02
+
+
+class SnapshotReader:
+	"""Walks through a snapshot file one record at a time."""
+
+	def __init__(self, data):
+		self.data = data
+		self.pos = 0
+
+	def read(self, fmt, count=None):
+		if count is not None:
+			fmt = '=%d%s' % (count, fmt)
+		else:
+			fmt = '=' + fmt
+		size = struct.calcsize(fmt)
+		if self.pos + size > len(self.data):
+			raise ValueError('snapshot file is truncated at byte %d' % self.pos)
+		values = struct.unpack_from(fmt, self.data, self.pos)
+		self.pos += size
+		return list(values) if count is not None else values[0]
+
+	def read_names(self, count):
+		names = []
+		for n in range(count):
+			length = self.read('I')
+			names.append(self.data[self.pos:self.pos+length].decode('ascii'))
+			self.pos += length
+		return names
+
+	def at_end(self):
+		return self.pos >= len(self.data)
+
+
+class Snapshot:
+	"""The full system state as of one record."""
+
+	def __init__(self, bus_count, branch_count):
+		self.timestamp = None
+		self.flags = 0
+		self.bus_entries = 0
+		self.branch_entries = 0
+		self.bus_phases = [0] * bus_count
+		self.voltage = [[0j, 0j, 0j] for n in range(bus_count)]
+		self.branch_phases = [0] * branch_count
+		self.branch_status = [0] * branch_count
+		self.current = [[0j, 0j, 0j] for n in range(branch_count)]
+		self.admittance = None
+
+	def copy(self):
+		other = Snapshot(0, 0)
+		other.bus_phases = list(self.bus_phases)
+		other.voltage = [list(v) for v in self.voltage]
+		other.branch_phases = list(self.branch_phases)
+		other.branch_status = list(self.branch_status)
+		other.current = [list(i) for i in self.current]
+		other.admittance = self.admittance
+		return other
+
+
+def read_section(reader, count, delta, phases, values, status=None):
+	entries = reader.read('I')
+	index = reader.read('I', entries) if delta else list(range(entries))
+	if not delta and entries != count:
+		raise ValueError('full record holds %d of %d entries' % (entries, count))
+	for n, phase in zip(index, reader.read('B', entries)):
+		phases[n] = phase
+	if status is not None:
+		for n, value in zip(index, reader.read('B', entries)):
+			status[n] = value
+	columns = [reader.read('d', entries) for n in range(6)]
+	for k, n in enumerate(index):
+		values[n] = [complex(columns[2*p][k], columns[2*p+1][k]) for p in range(3)]
+	return entries
+
+
+def read_admittance(reader):
+	rows = reader.read('I')
+	nnz = reader.read('I')
+	rowptr = reader.read('I', rows+1)
+	col = reader.read('I', nnz)
+	val = reader.read('d', nnz)
+	if rowptr[0] != 0 or rowptr[-1] != nnz:
+		raise ValueError('admittance row pointers do not span its %d entries' % nnz)
+	return {'rows': rows, 'rowptr': rowptr, 'col': col, 'val': val}
+
+
+def read_snapshots(filename):
+	"""Returns the header and the list of snapshots in a file.
+
+	The header is a dict of its columns: bus_type, volt_base, bus_name,
+	branch_from, branch_to, link_type and branch_name.
+	"""
+	with open(filename, 'rb') as fp:
+		reader = SnapshotReader(fp.read())
+
+	if reader.data[:8] != SNAPSHOT_MAGIC:
+		raise ValueError('%s is not a snapshot file' % filename)
+	reader.pos = 8
+	version = reader.read('I')
+	if version != SNAPSHOT_VERSION:
+		raise ValueError('%s has layout version %d, expected %d' % (filename, version, SNAPSHOT_VERSION))
+	bus_count = reader.read('I')
+	branch_count = reader.read('I')
+
+	header = {}
+	header['bus_type'] = reader.read('B', bus_count)
+	header['volt_base'] = reader.read('d', bus_count)
+	header['bus_name'] = reader.read_names(bus_count)
+	header['branch_from'] = reader.read('I', branch_count)
+	header['branch_to'] = reader.read('I', branch_count)
+	header['link_type'] = reader.read('B', branch_count)
+	header['branch_name'] = reader.read_names(branch_count)
+
+	snapshots = []
+	state = Snapshot(bus_count, branch_count)
+	while not reader.at_end():
+		if reader.read('4s') != b'SNAP':
+			raise ValueError('record %d does not start with SNAP' % len(snapshots))
+		state = state.copy()
+		state.timestamp = reader.read('q')
+		state.flags = reader.read('I')
+		delta = (state.flags & SNAPSHOT_DELTA) != 0
+		if delta and not snapshots:
+			raise ValueError('first record is a delta record')
+		state.bus_entries = read_section(reader, bus_count, delta, state.bus_phases, state.voltage)
+		state.branch_entries = read_section(reader, branch_count, delta, state.branch_phases, state.current, state.branch_status)
+		if state.flags & SNAPSHOT_ADMITTANCE:
+			state.admittance = read_admittance(reader)
+		snapshots.append(state)
+	return header, snapshots
+
+
+def print_columns(names, values):
+	for name, value in zip(names, values):
+		print('%s,%f,%f,%f,%f,%f,%f' % (name, value[0].real, value[0].imag, value[1].real, value[1].imag, value[2].real, value[2].imag))
+
+
+def main(argv):
+	mode = 'summary'
+	record = -1
+	args = argv[1:]
+	while len(args) > 1:
+		if args[0] == '--voltages' or args[0] == '--currents':
+			mode = args[0][2:]
+			args = args[1:]
+		elif args[0] == '--record':
+			record = int(args[1])
+			args = args[2:]
+		else:
+			break
+	if len(args) != 1:
+		sys.stderr.write(__doc__)
+		return 2
+
+	header, snapshots = read_snapshots(args[0])
+	if mode == 'summary':
+		for state in snapshots:
+			rows, nnz = (state.admittance['rows'], len(state.admittance['col'])) if state.flags & SNAPSHOT_ADMITTANCE else (0, 0)
+			print('%d,%d,%d,%d,%d,%d' % (state.timestamp, state.flags, state.bus_entries, state.branch_entries, rows, nnz))
+	elif not snapshots:
+		sys.stderr.write('%s holds no snapshots\n' % args[0])
+		return 1
+	elif mode == 'voltages':
+		print_columns(header['bus_name'], snapshots[record].voltage)
+	else:
+		print_columns(header['branch_name'], snapshots[record].current)
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv))
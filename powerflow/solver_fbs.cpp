@@ -0,0 +1,635 @@
+/* $Id
+ * Forward-back sweep solver for radial networks
+ *
+ * With powerflow::FBS_level_sweep set, the FBS network is flattened once, before the first sync pass,
+ * into one tree per source node.  Each tree holds its nodes in level order (breadth first from the
+ * root), along with the link feeding each node.  The root runs the whole sweep from its own sync:
+ * the backward sweep goes up a level at a time, adding each node's own load once everything below
+ * it has been accumulated, and the forward sweep then pushes the voltages back down.  This is the
+ * same arithmetic the link and node passes do, just without going through the object passes for
+ * every link and node.  The nodes of a level only touch their own values, so wide levels are split
+ * across threads; the currents are then added into the level above in order, so the sums do not
+ * depend on the number of threads.
+ *
+ * Networks that are not strictly radial (a node fed from more than one place, or a loop) are left
+ * to the object passes.
+ */
+
+#include "solver_fbs.h"
+
+/* access to module global variables */
+#include "powerflow.h"
+#include "node.h"
+#include "link.h"
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+static FBS_TREE *fbs_trees = NULL;
+static unsigned int fbs_tree_count = 0;
+static bool fbs_initialized = false;
+static pthread_mutex_t fbs_init_lock = PTHREAD_MUTEX_INITIALIZER;
+
+//Connection in the network while it is being flattened - a link, or a child node hanging off its parent
+typedef struct {
+	unsigned int from;		///< index of the upstream node
+	unsigned int to;		///< index of the downstream node
+	link_object *lnk;		///< link, NULL for a parent-child connection
+} FBS_EDGE;
+
+//Flattens the FBS network into level-ordered trees and flags the nodes and links that are swept
+//Returns without flagging anything if the network is not radial, which leaves it to the object passes
+static void flatten_trees(void)
+{
+	FINDLIST *objects = gl_find_objects(FL_NEW,FT_MODULE,SAME,"powerflow",FT_END);
+	OBJECT *obj = NULL;
+	node **nodes = NULL;
+	int *index = NULL;
+	FBS_EDGE *edges = NULL;
+	unsigned int *incoming = NULL, *first = NULL, *fill = NULL, *order = NULL, *bus_node = NULL, *levels = NULL;
+	FBS_BUS *bus = NULL;
+	unsigned int node_count = 0, edge_count = 0, max_id = 0;
+	unsigned int indexer, edge, pos, tree_count, level_count, deepest;
+	unsigned int begin, end, tree_start;
+	char threadcount[32];
+	int threads;
+
+	if (objects == NULL)
+		return;
+
+	//Size everything up
+	while ((obj=gl_find_next(objects,obj)) != NULL)
+	{
+		if (obj->id > max_id)
+			max_id = obj->id;
+		if (gl_object_isa(obj,"node","powerflow"))
+			node_count++;
+		else if (gl_object_isa(obj,"link","powerflow"))
+			edge_count++;
+	}
+
+	if (node_count == 0)
+	{
+		gl_free(objects);
+		return;
+	}
+
+	//Every child node adds at most one more connection
+	edge_count += node_count;
+
+	nodes = (node**)gl_malloc(node_count*sizeof(node*));
+	index = (int*)gl_malloc((max_id+1)*sizeof(int));
+	edges = (FBS_EDGE*)gl_malloc(edge_count*sizeof(FBS_EDGE));
+	incoming = (unsigned int*)gl_malloc(node_count*sizeof(unsigned int));
+	first = (unsigned int*)gl_malloc((node_count+1)*sizeof(unsigned int));
+	fill = (unsigned int*)gl_malloc(node_count*sizeof(unsigned int));
+	order = (unsigned int*)gl_malloc(edge_count*sizeof(unsigned int));
+	bus_node = (unsigned int*)gl_malloc(node_count*sizeof(unsigned int));
+	levels = (unsigned int*)gl_malloc((node_count+1)*sizeof(unsigned int));
+	bus = (FBS_BUS*)gl_malloc(node_count*sizeof(FBS_BUS));
+
+	if ((nodes == NULL) || (index == NULL) || (edges == NULL) || (incoming == NULL) || (first == NULL) || (fill == NULL) || (order == NULL) || (bus_node == NULL) || (levels == NULL) || (bus == NULL))
+	{
+		GL_THROW("FBS: memory allocation failure for level sweep");
+		/*  TROUBLESHOOT
+		While attempting to allocate the arrays for the FBS level sweep, an error occurred.
+		Please try again.  If the error persists, please submit your code and a bug report via the trac website.
+		*/
+	}
+
+	for (indexer=0; indexer<=max_id; indexer++)
+		index[indexer] = -1;
+
+	node_count = 0;
+	while ((obj=gl_find_next(objects,obj)) != NULL)
+	{
+		if (gl_object_isa(obj,"node","powerflow"))
+		{
+			index[obj->id] = node_count;
+			nodes[node_count++] = OBJECTDATA(obj,node);
+		}
+	}
+
+	//Collect the connections - links first, then children to their parents
+	edge_count = 0;
+	while ((obj=gl_find_next(objects,obj)) != NULL)
+	{
+		if (gl_object_isa(obj,"link","powerflow"))
+		{
+			link_object *lnk = OBJECTDATA(obj,link_object);
+
+			if ((lnk->from == NULL) || (lnk->to == NULL) || (index[lnk->from->id] < 0) || (index[lnk->to->id] < 0) || (lnk->from == lnk->to))
+			{
+				gl_warning("link:%d (%s) does not join two nodes - the FBS level sweep will not be used",obj->id,(obj->name ? obj->name : "Unnamed"));
+				/*  TROUBLESHOOT
+				The FBS level sweep only handles links that run between two powerflow nodes.  The network will be
+				solved by the regular forward-back sweep passes instead.  Check the from and to of the link.
+				*/
+				goto Fallback;
+			}
+
+			edges[edge_count].from = index[lnk->from->id];
+			edges[edge_count].to = index[lnk->to->id];
+			edges[edge_count].lnk = lnk;
+			edge_count++;
+		}
+	}
+
+	for (indexer=0; indexer<node_count; indexer++)
+	{
+		if (nodes[indexer]->parent_is_node)
+		{
+			obj = OBJECTHDR(nodes[indexer]);
+
+			edges[edge_count].from = index[obj->parent->id];
+			edges[edge_count].to = indexer;
+			edges[edge_count].lnk = NULL;
+			edge_count++;
+		}
+	}
+
+	//A radial network feeds every node from exactly one place
+	memset(incoming,0,node_count*sizeof(unsigned int));
+	memset(first,0,(node_count+1)*sizeof(unsigned int));
+	for (edge=0; edge<edge_count; edge++)
+	{
+		incoming[edges[edge].to]++;
+		first[edges[edge].from+1]++;
+
+		if (incoming[edges[edge].to] > 1)
+		{
+			obj = OBJECTHDR(nodes[edges[edge].to]);
+			gl_warning("node:%d (%s) is fed from more than one place - the FBS level sweep will not be used",obj->id,(obj->name ? obj->name : "Unnamed"));
+			/*  TROUBLESHOOT
+			The FBS level sweep needs a strictly radial network, where each node is the to node of one link or
+			the child of one node.  The network will be solved by the regular forward-back sweep passes instead.
+			*/
+			goto Fallback;
+		}
+	}
+
+	//Connections leaving each node, in the order they were collected
+	for (indexer=0; indexer<node_count; indexer++)
+	{
+		first[indexer+1] += first[indexer];
+		fill[indexer] = first[indexer];
+	}
+	for (edge=0; edge<edge_count; edge++)
+		order[fill[edges[edge].from]++] = edge;
+
+	//Breadth first from every node nothing feeds, one tree each
+	pos = 0;
+	tree_count = 0;
+	for (indexer=0; indexer<node_count; indexer++)
+	{
+		if (incoming[indexer] == 0)
+			tree_count++;
+	}
+
+	if (tree_count == 0)
+		goto Loop;
+
+	fbs_trees = (FBS_TREE*)gl_malloc(tree_count*sizeof(FBS_TREE));
+	if (fbs_trees == NULL)
+	{
+		GL_THROW("FBS: memory allocation failure for level sweep");
+		//Defined above
+	}
+
+	threads = FBS_sweep_threads;
+	if (threads == 0)
+		threads = (gl_global_getvar("threadcount",threadcount,sizeof(threadcount)) != NULL) ? atoi(threadcount) : 1;
+	if (threads > FBS_SWEEP_MAX_THREADS)
+		threads = FBS_SWEEP_MAX_THREADS;
+	if (threads < 1)
+		threads = 1;
+
+	tree_count = 0;
+	deepest = 0;
+	for (indexer=0; indexer<node_count; indexer++)
+	{
+		if (incoming[indexer] != 0)
+			continue;
+
+		tree_start = pos;
+		bus_node[pos] = indexer;
+		bus[pos].up = 0;
+		bus[pos].lnk = NULL;
+		pos++;
+
+		level_count = 0;
+		begin = tree_start;
+		while (begin < pos)
+		{
+			levels[level_count++] = begin - tree_start;
+			end = pos;
+			for (; begin<end; begin++)
+			{
+				for (edge=first[bus_node[begin]]; edge<first[bus_node[begin]+1]; edge++)
+				{
+					bus_node[pos] = edges[order[edge]].to;
+					bus[pos].up = begin - tree_start;
+					bus[pos].lnk = edges[order[edge]].lnk;
+					pos++;
+				}
+			}
+		}
+		levels[level_count] = pos - tree_start;
+
+		fbs_trees[tree_count].bus = &bus[tree_start];
+		fbs_trees[tree_count].bus_count = pos - tree_start;
+		fbs_trees[tree_count].level_count = level_count;
+		fbs_trees[tree_count].level = (unsigned int*)gl_malloc((level_count+1)*sizeof(unsigned int));
+		fbs_trees[tree_count].parts = threads;
+		fbs_trees[tree_count].pool = NULL;
+		if (fbs_trees[tree_count].level == NULL)
+		{
+			GL_THROW("FBS: memory allocation failure for level sweep");
+			//Defined above
+		}
+		memcpy(fbs_trees[tree_count].level,levels,(level_count+1)*sizeof(unsigned int));
+
+		if (level_count > deepest)
+			deepest = level_count;
+		tree_count++;
+	}
+
+	//Anything left over sits on a loop
+	if (pos != node_count)
+	{
+		for (indexer=0; indexer<tree_count; indexer++)
+			gl_free(fbs_trees[indexer].level);
+		gl_free(fbs_trees);
+		fbs_trees = NULL;
+Loop:
+		gl_warning("the powerflow network has a loop - the FBS level sweep will not be used");
+		/*  TROUBLESHOOT
+		Some nodes could not be reached from a node that is not fed by anything, which means the network has
+		a loop in it.  The FBS level sweep needs a strictly radial network, so the network will be solved by
+		the regular forward-back sweep passes instead.
+		*/
+		goto Fallback;
+	}
+
+	//Hand everything over to the sweep
+	for (indexer=0; indexer<node_count; indexer++)
+	{
+		bus[indexer].nd = nodes[bus_node[indexer]];
+		bus[indexer].V = bus[indexer].nd->voltage;
+	}
+	for (indexer=0; indexer<tree_count; indexer++)
+	{
+		for (pos=0; pos<fbs_trees[indexer].bus_count; pos++)
+		{
+			//Nodes whose sync can call out or throw keep the whole tree on the sync thread
+			if (fbs_trees[indexer].bus[pos].nd->FBS_node_sync_threadsafe() == false)
+				fbs_trees[indexer].parts = 1;
+
+			fbs_trees[indexer].bus[pos].nd->FBS_sweep_tree = indexer;
+			if (fbs_trees[indexer].bus[pos].lnk != NULL)
+				fbs_trees[indexer].bus[pos].lnk->FBS_sweep_tree = indexer;
+		}
+		fbs_trees[indexer].bus[0].nd->FBS_sweep_root = true;
+	}
+	fbs_tree_count = tree_count;
+
+	gl_verbose("FBS level sweep: %d nodes in %d trees, deepest is %d levels",node_count,tree_count,deepest);
+
+	gl_free(nodes);
+	gl_free(index);
+	gl_free(edges);
+	gl_free(incoming);
+	gl_free(first);
+	gl_free(fill);
+	gl_free(order);
+	gl_free(bus_node);
+	gl_free(levels);
+	gl_free(objects);
+	return;
+
+Fallback:
+	gl_free(nodes);
+	gl_free(index);
+	gl_free(edges);
+	gl_free(incoming);
+	gl_free(first);
+	gl_free(fill);
+	gl_free(order);
+	gl_free(bus_node);
+	gl_free(levels);
+	gl_free(bus);
+	gl_free(objects);
+}
+
+//Flattens the network the first time it is called, from the first node presync
+void solver_fbs_init(void)
+{
+	unsigned int tree, indexer;
+
+	pthread_mutex_lock(&fbs_init_lock);
+	if (fbs_initialized == false)
+	{
+		//Nodes waiting on the lock must not flatten again if this throws
+		fbs_initialized = true;
+		try {
+			flatten_trees();
+		}
+		catch (...)
+		{
+			pthread_mutex_unlock(&fbs_init_lock);
+			throw;
+		}
+
+		//Map the current injections the sweep accumulates into
+		for (tree=0; tree<fbs_tree_count; tree++)
+		{
+			for (indexer=0; indexer<fbs_trees[tree].bus_count; indexer++)
+				fbs_trees[tree].bus[indexer].I = fbs_trees[tree].bus[indexer].nd->current_inj;
+		}
+	}
+	pthread_mutex_unlock(&fbs_init_lock);
+}
+
+//Backward sweep for part of a level - the node's own load goes on top of everything below it,
+//then the link feeding it works out what it draws from upstream (c*Vto + d*Ito)
+static void sweep_currents(FBS_BUS *bus, unsigned int first, unsigned int last)
+{
+	unsigned int indexer;
+
+	for (indexer=first; indexer<last; indexer++)
+	{
+		FBS_BUS *b = &bus[indexer];
+		link_object *lnk = b->lnk;
+
+		b->nd->FBS_node_sync_fxn(OBJECTHDR(b->nd));
+
+		if ((lnk != NULL) && lnk->is_closed())
+		{
+			lnk->current_in[0] =
+				lnk->c_mat[0][0] * b->V[0] +
+				lnk->c_mat[0][1] * b->V[1] +
+				lnk->c_mat[0][2] * b->V[2] +
+				lnk->d_mat[0][0] * b->I[0] +
+				lnk->d_mat[0][1] * b->I[1] +
+				lnk->d_mat[0][2] * b->I[2];
+			lnk->current_in[1] =
+				lnk->c_mat[1][0] * b->V[0] +
+				lnk->c_mat[1][1] * b->V[1] +
+				lnk->c_mat[1][2] * b->V[2] +
+				lnk->d_mat[1][0] * b->I[0] +
+				lnk->d_mat[1][1] * b->I[1] +
+				lnk->d_mat[1][2] * b->I[2];
+			lnk->current_in[2] =
+				lnk->c_mat[2][0] * b->V[0] +
+				lnk->c_mat[2][1] * b->V[1] +
+				lnk->c_mat[2][2] * b->V[2] +
+				lnk->d_mat[2][0] * b->I[0] +
+				lnk->d_mat[2][1] * b->I[1] +
+				lnk->d_mat[2][2] * b->I[2];
+		}
+	}
+}
+
+//Forward sweep for part of a level - child nodes take their parent's voltage, everything else
+//gets A*Vfrom - B*Ito through its link, unless the link is open
+static void sweep_voltages(FBS_BUS *bus, unsigned int first, unsigned int last)
+{
+	unsigned int indexer;
+
+	for (indexer=first; indexer<last; indexer++)
+	{
+		FBS_BUS *b = &bus[indexer];
+		complex *Vf = bus[b->up].V;
+		link_object *lnk = b->lnk;
+
+		if (lnk == NULL)
+		{
+			b->V[0] = Vf[0];
+			b->V[1] = Vf[1];
+			b->V[2] = Vf[2];
+		}
+		else if (!lnk->is_open())
+		{
+			complex v0 =
+				lnk->A_mat[0][0] * Vf[0] +
+				lnk->A_mat[0][1] * Vf[1] +
+				lnk->A_mat[0][2] * Vf[2] -
+				lnk->B_mat[0][0] * b->I[0] -
+				lnk->B_mat[0][1] * b->I[1] -
+				lnk->B_mat[0][2] * b->I[2];
+			complex v1 =
+				lnk->A_mat[1][0] * Vf[0] +
+				lnk->A_mat[1][1] * Vf[1] +
+				lnk->A_mat[1][2] * Vf[2] -
+				lnk->B_mat[1][0] * b->I[0] -
+				lnk->B_mat[1][1] * b->I[1] -
+				lnk->B_mat[1][2] * b->I[2];
+			complex v2 =
+				lnk->A_mat[2][0] * Vf[0] +
+				lnk->A_mat[2][1] * Vf[1] +
+				lnk->A_mat[2][2] * Vf[2] -
+				lnk->B_mat[2][0] * b->I[0] -
+				lnk->B_mat[2][1] * b->I[1] -
+				lnk->B_mat[2][2] * b->I[2];
+
+			b->V[0] = v0;
+			b->V[1] = v1;
+			b->V[2] = v2;
+		}
+	}
+}
+
+//Runs one part of a level split into parts
+static void sweep_part(FBS_BUS *bus, unsigned int first, unsigned int width, unsigned int part, unsigned int parts, bool backward)
+{
+	unsigned int begin = first + (width*part)/parts;
+	unsigned int end = first + (width*(part+1))/parts;
+
+	if (backward == true)
+		sweep_currents(bus,begin,end);
+	else
+		sweep_voltages(bus,begin,end);
+}
+
+//Worker threads kept by a tree for its wide levels.  They are started the first time one of the
+//tree's levels is split and wait on the condition variable between levels, so each level of each
+//sweep only wakes them instead of creating and joining threads.
+typedef struct s_fbs_sweep_worker {
+	pthread_t thread;
+	struct s_fbs_sweep_pool *pool;
+	unsigned int part;
+} FBS_SWEEP_WORKER;
+
+typedef struct s_fbs_sweep_pool {
+	unsigned int started;		///< workers running, they take parts 1 to started-1
+	FBS_SWEEP_WORKER worker[FBS_SWEEP_MAX_THREADS];
+	pthread_mutex_t lock;
+	pthread_cond_t go;			///< signalled when a new level is posted
+	pthread_cond_t done;		///< signalled when the last worker finishes a level
+	unsigned int request;		///< incremented for each level
+	unsigned int pending;		///< workers still working on the current level
+	FBS_BUS *bus;				///< current level
+	unsigned int first;
+	unsigned int width;
+	unsigned int parts;
+	bool backward;
+} FBS_SWEEP_POOL;
+
+static void *sweep_worker(void *ptr)
+{
+	FBS_SWEEP_WORKER *data = (FBS_SWEEP_WORKER*)ptr;
+	FBS_SWEEP_POOL *pool = data->pool;
+	unsigned int seen = 0;	//a new pool starts at request 0
+
+	pthread_mutex_lock(&pool->lock);
+	while (true)
+	{
+		while (pool->request == seen)
+			pthread_cond_wait(&pool->go,&pool->lock);
+		seen = pool->request;
+
+		//Narrower levels are split into fewer parts than there are workers
+		if (data->part >= pool->parts)
+			continue;
+		pthread_mutex_unlock(&pool->lock);
+
+		sweep_part(pool->bus,pool->first,pool->width,data->part,pool->parts,pool->backward);
+
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->pending == 0)
+			pthread_cond_signal(&pool->done);
+	}
+	return NULL;
+}
+
+//Gets the workers for a tree, starting them the first time it splits a level
+static FBS_SWEEP_POOL *get_sweep_pool(FBS_TREE *tree)
+{
+	FBS_SWEEP_POOL *pool = tree->pool;
+
+	if (pool != NULL)
+		return pool;
+
+	pool = (FBS_SWEEP_POOL*)gl_malloc(sizeof(FBS_SWEEP_POOL));
+	if (pool == NULL)
+		return NULL;
+	memset(pool,0,sizeof(FBS_SWEEP_POOL));
+	pthread_mutex_init(&pool->lock,NULL);
+	pthread_cond_init(&pool->go,NULL);
+	pthread_cond_init(&pool->done,NULL);
+
+	//Parts that do not get a thread are done by the sync thread
+	for (pool->started=1; pool->started<tree->parts; pool->started++)
+	{
+		pool->worker[pool->started].pool = pool;
+		pool->worker[pool->started].part = pool->started;
+		if (pthread_create(&pool->worker[pool->started].thread,NULL,sweep_worker,&pool->worker[pool->started]) != 0)
+			break;
+	}
+
+	tree->pool = pool;
+	return pool;
+}
+
+//Runs one level of the sweep, split across the tree's workers when it is wide enough
+static void sweep_level(FBS_TREE *tree, unsigned int level, bool backward)
+{
+	FBS_SWEEP_POOL *pool = NULL;
+	unsigned int first = tree->level[level];
+	unsigned int width = tree->level[level+1] - first;
+	unsigned int parts = width / FBS_SWEEP_THREAD_BUSES;
+	unsigned int part, started = 1;
+
+	if (parts > tree->parts)
+		parts = tree->parts;
+
+	if (parts < 2)
+	{
+		sweep_part(tree->bus,first,width,0,1,backward);
+		return;
+	}
+
+	//Post the level to the workers
+	pool = get_sweep_pool(tree);
+	if (pool != NULL)
+	{
+		started = (pool->started < parts) ? pool->started : parts;
+
+		pthread_mutex_lock(&pool->lock);
+		pool->bus = tree->bus;
+		pool->first = first;
+		pool->width = width;
+		pool->parts = parts;
+		pool->backward = backward;
+		pool->pending = started - 1;
+		pool->request++;
+		pthread_cond_broadcast(&pool->go);
+		pthread_mutex_unlock(&pool->lock);
+	}
+
+	//Sync thread takes the first part and anything that did not get a thread
+	for (part=0; part<parts; part++)
+	{
+		if (part!=0 && part<started)
+			continue;
+		sweep_part(tree->bus,first,width,part,parts,backward);
+	}
+
+	if (pool != NULL)
+	{
+		pthread_mutex_lock(&pool->lock);
+		while (pool->pending > 0)
+			pthread_cond_wait(&pool->done,&pool->lock);
+		pthread_mutex_unlock(&pool->lock);
+	}
+}
+
+//Runs one backward and one forward sweep over a tree - called from the sync of its root, once
+//every load in the tree has been updated.  Convergence is still checked by the node postsyncs.
+void solver_fbs(int tree)
+{
+	FBS_TREE *t = &fbs_trees[tree];
+	unsigned int level, indexer;
+
+	//Backward sweep - deepest level first
+	for (level=t->level_count; level-->0; )
+	{
+		sweep_level(t,level,true);
+
+		//Add the level into the one above it, in order
+		if (level == 0)
+			break;
+		for (indexer=t->level[level]; indexer<t->level[level+1]; indexer++)
+		{
+			FBS_BUS *b = &t->bus[indexer];
+			complex *Iup = t->bus[b->up].I;
+
+			if (b->lnk == NULL)
+			{
+				//Same phase check node::sync makes before adding a child's injections to its parent
+				if (((t->bus[b->up].nd->phases & b->nd->phases) & (~(PHASE_D | PHASE_N))) != (b->nd->phases & (~(PHASE_D | PHASE_N))))
+				{
+					GL_THROW("Node:%d's parent does not have the proper phase connection to be a parent.",OBJECTHDR(b->nd)->id);
+					/*  TROUBLESHOOT
+					A parent-child relationship was attempted when the parent node does not contain the phases
+					of the child node.  Ensure parent nodes have at least the phases of the child object.
+					*/
+				}
+
+				Iup[0] += b->I[0];
+				Iup[1] += b->I[1];
+				Iup[2] += b->I[2];
+			}
+			else if (b->lnk->is_closed())
+			{
+				Iup[0] += b->lnk->current_in[0];
+				Iup[1] += b->lnk->current_in[1];
+				Iup[2] += b->lnk->current_in[2];
+			}
+		}
+	}
+
+	//Forward sweep - the root keeps its voltage
+	for (level=1; level<t->level_count; level++)
+		sweep_level(t,level,false);
+}
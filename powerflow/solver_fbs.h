@@ -0,0 +1,37 @@
+/* $Id
+ * Forward-back sweep solver for radial networks
+ */
+
+#ifndef _SOLVER_FBS
+#define _SOLVER_FBS
+
+#include "complex.h"
+#include "object.h"
+
+#define FBS_SWEEP_THREAD_BUSES 1024	///< smallest share of a level worth giving its own thread
+#define FBS_SWEEP_MAX_THREADS 64	///< upper limit on the threads used for one level
+
+class node;
+class link_object;
+
+typedef struct {
+	node *nd;				///< node object
+	complex *V;				///< node voltage
+	complex *I;				///< node current injection
+	link_object *lnk;		///< link feeding this node - NULL for the root and for child nodes, which hang off their parent
+	unsigned int up;		///< index of the upstream node in the tree
+} FBS_BUS;
+
+typedef struct {
+	FBS_BUS *bus;			///< nodes of the tree, root first, in level order
+	unsigned int bus_count;	///< number of nodes in the tree
+	unsigned int *level;	///< index of the first node of each level, followed by bus_count
+	unsigned int level_count;	///< number of levels (the root is level 0)
+	unsigned int parts;		///< threads used for wide levels
+	struct s_fbs_sweep_pool *pool;	///< threads kept for the wide levels between sweeps - NULL until a level is split
+} FBS_TREE;
+
+void solver_fbs_init(void);
+void solver_fbs(int tree);
+
+#endif
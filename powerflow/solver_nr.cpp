@@ -46,6 +46,7 @@ Initialization after returning to service?
 #include "powerflow.h"
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 
 //Generic solver variables
 NR_SOLVER_VARS matrices_LU;
@@ -58,7 +59,7 @@ SuperMatrix A_LU,B_LU;
 void *ext_solver_glob_vars;
 
 char1024 solver_profile_filename =  "solver_nr_profile.csv";
-char1024 solver_headers =  "timestamp,duration[microsec],iteration,bus_count,branch_count,error";
+char1024 solver_headers =  "timestamp,duration[microsec],iteration,bus_count,branch_count,error,predictor[pu]";
 static FILE * nr_profile = NULL;
 bool solver_profile_headers_included = true;
 bool solver_profile_enable = false;
@@ -250,6 +251,269 @@ void sparse_tonr(SPARSE* sm, NR_SOLVER_VARS *matrices_LU)
 	n>0 to indicate success after n interations, or 
 	n<0 to indicate failure after n iterations
  **/
+//Resize one of the solver state arrays, if needed
+template <class T> static void size_solver_state(T *&values, unsigned int count, unsigned int max_count)
+{
+	if (count > max_count)
+	{
+		if (values != NULL)
+			gl_free(values);
+
+		values = (T *)gl_malloc(count*sizeof(T));
+
+		//Make sure it worked
+		if (values == NULL)
+		{
+			GL_THROW("NR: Failed to allocate memory for one of the necessary matrices");
+			/*  TROUBLESHOOT
+			While attempting to allocate the contiguous working copy of the bus and branch values,
+			an error was encountered.  Please try again.  If the error persists, please submit
+			your code and a bug report via the ticketing system.
+			*/
+		}
+	}
+}
+
+//Picks the load calculation kernel for a bus - see compute_load_values
+static NR_LOADBIN load_bin_of(BUSDATA *bus, NR_SOLVER_STATE *state, unsigned int indexer)
+{
+	unsigned int jindex;
+
+	if (bus[indexer].full_Y_load != NULL)
+		return NR_LOAD_GENERAL;
+
+	if ((bus[indexer].phases & 0x80) == 0x80)
+		return NR_LOAD_TRIPLEX;
+
+	if (((bus[indexer].phases & 0x18) != 0x00) || ((bus[indexer].phases & 0x07) == 0x00) || (*bus[indexer].dynamics_enabled == true))
+		return NR_LOAD_GENERAL;
+
+	for (jindex=0; jindex<6; jindex++)
+	{
+		if ((state->S_dy[6*indexer+jindex] != 0.0) || (state->Y_dy[6*indexer+jindex] != 0.0) || (state->I_dy[6*indexer+jindex] != 0.0))
+			return NR_LOAD_GENERAL;
+	}
+
+	return NR_LOAD_WYE;
+}
+
+//Copies the bus voltages and loads and the branch admittances the NR iterations read into
+//contiguous arrays, so the load, mismatch and Jacobian loops do not follow the BUSDATA and
+//BRANCHDATA pointers back into the node and link objects.  Loads and admittances do not
+//change during a solution, voltage updates are written to both the state and the nodes.
+void gather_solver_state(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STATE *state)
+{
+	unsigned int indexer, jindex;
+
+	//Make sure there is room
+	size_solver_state(state->V,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->S,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->Y,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->I,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->prerot_I,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->S_dy,6*bus_count,6*state->max_bus_count);
+	size_solver_state(state->Y_dy,6*bus_count,6*state->max_bus_count);
+	size_solver_state(state->I_dy,6*bus_count,6*state->max_bus_count);
+	size_solver_state(state->PL,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->QL,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->Jacob_A,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->Jacob_B,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->Jacob_C,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->Jacob_D,3*bus_count,3*state->max_bus_count);
+	size_solver_state(state->Yfrom,9*branch_count,9*state->max_branch_count);
+	size_solver_state(state->Yto,9*branch_count,9*state->max_branch_count);
+	size_solver_state(state->load_bus,bus_count,state->max_bus_count);
+
+	if (bus_count > state->max_bus_count)
+		state->max_bus_count = bus_count;
+
+	if (branch_count > state->max_branch_count)
+		state->max_branch_count = branch_count;
+
+	//Copy the bus values
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		for (jindex=0; jindex<3; jindex++)
+		{
+			state->V[3*indexer+jindex] = bus[indexer].V[jindex];
+			state->S[3*indexer+jindex] = bus[indexer].S[jindex];
+			state->Y[3*indexer+jindex] = bus[indexer].Y[jindex];
+			state->I[3*indexer+jindex] = bus[indexer].I[jindex];
+			state->prerot_I[3*indexer+jindex] = bus[indexer].prerot_I[jindex];
+		}
+
+		for (jindex=0; jindex<6; jindex++)
+		{
+			state->S_dy[6*indexer+jindex] = bus[indexer].S_dy[jindex];
+			state->Y_dy[6*indexer+jindex] = bus[indexer].Y_dy[jindex];
+			state->I_dy[6*indexer+jindex] = bus[indexer].I_dy[jindex];
+		}
+	}
+
+	//Group the buses by load calculation kernel
+	unsigned int bin, bin_count[NR_LOAD_BINS], threads;
+	char threadcount[32];
+	bool threadsafe = true;
+
+	for (bin=0; bin<NR_LOAD_BINS; bin++)
+		bin_count[bin] = 0;
+
+	for (indexer=0; indexer<bus_count; indexer++)
+		bin_count[load_bin_of(bus,state,indexer)]++;
+
+	state->load_bin[0] = 0;
+	for (bin=0; bin<NR_LOAD_BINS; bin++)
+	{
+		state->load_bin[bin+1] = state->load_bin[bin] + bin_count[bin];
+		bin_count[bin] = state->load_bin[bin];
+	}
+
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		bin = load_bin_of(bus,state,indexer);
+		state->load_bus[bin_count[bin]++] = indexer;
+
+		//Buses without phases make compute_load_general throw, which has to happen on this thread
+		if (((bus[indexer].phases & 0x80) != 0x80) && ((bus[indexer].phases & 0x07) == 0x00))
+			threadsafe = false;
+	}
+
+	//Split large systems across threads
+	threads = NR_load_threads;
+	if (threads == 0)
+		threads = (gl_global_getvar("threadcount",threadcount,sizeof(threadcount)) != NULL) ? atoi(threadcount) : 1;
+
+	state->load_parts = bus_count / NR_LOAD_THREAD_BUSES;
+	if (state->load_parts > threads)
+		state->load_parts = threads;
+	if (state->load_parts > NR_LOAD_MAX_THREADS)
+		state->load_parts = NR_LOAD_MAX_THREADS;
+	if ((state->load_parts < 1) || (threadsafe == false))
+		state->load_parts = 1;
+
+	//Copy the branch admittances - links that have not been populated yet are left zeroed
+	for (indexer=0; indexer<branch_count; indexer++)
+	{
+		for (jindex=0; jindex<9; jindex++)
+		{
+			state->Yfrom[9*indexer+jindex] = (branch[indexer].Yfrom != NULL) ? branch[indexer].Yfrom[jindex] : complex(0.0,0.0);
+			state->Yto[9*indexer+jindex] = (branch[indexer].Yto != NULL) ? branch[indexer].Yto[jindex] : complex(0.0,0.0);
+		}
+	}
+}
+
+//Voltages a bus's NR updates touch, as a mask of 3*bus+phase entries - SWING buses acting as
+//swings and PV buses keep theirs
+static unsigned char solved_phases(BUSDATA *bus, unsigned int indexer)
+{
+	unsigned char mask = 0x00;
+
+	if (!((bus[indexer].type == 0) || ((bus[indexer].type > 1) && (bus[indexer].swing_functions_enabled == false))))
+		return 0x00;
+
+	if ((bus[indexer].phases & 0x80) == 0x80)	//Split phase - 1 and 2
+		return 0x03;
+
+	if ((bus[indexer].phases & 0x04) == 0x04)	//A
+		mask |= 0x01;
+	if ((bus[indexer].phases & 0x02) == 0x02)	//B
+		mask |= 0x02;
+	if ((bus[indexer].phases & 0x01) == 0x01)	//C
+		mask |= 0x04;
+
+	return mask;
+}
+
+//Moves the starting voltages of the first solution of a timestep along the change between the last
+//two timesteps' solutions, so the iterations start closer to where the loads have been heading.
+//The step is scaled for uneven timesteps (never past one step ahead).  Buses it would move by more
+//than NR_PREDICTOR_MAX_STEP keep their voltage, and nothing is predicted right after an admittance
+//change, since the old solutions say nothing about the new network.
+static void predict_solver_voltages(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STATE *state)
+{
+	TIMESTAMP t = gl_globalclock;
+	unsigned int indexer, jindex;
+	unsigned char solved;
+	double ratio, step_pu;
+	dcomplex step;
+
+	state->predicted_step = 0.0;
+
+	//Only the first solution of a timestep
+	if (t == state->predicted_time)
+		return;
+	state->predicted_time = t;
+
+	if ((NR_admit_change == true) || (state->hist_bus_count != bus_count) || (state->hist_time[1] == 0) || (state->hist_time[0] >= t))
+		return;
+
+	ratio = (double)(t - state->hist_time[0]) / (double)(state->hist_time[0] - state->hist_time[1]);
+	if (ratio > 1.0)
+		ratio = 1.0;
+
+	for (indexer=0; indexer<bus_count; indexer++)
+	{
+		solved = solved_phases(bus,indexer);
+
+		if ((solved == 0x00) || (bus[indexer].volt_base <= 0.0))
+			continue;
+
+		for (jindex=0; jindex<3; jindex++)
+		{
+			if ((solved & (1<<jindex)) == 0x00)
+				continue;
+
+			step = (state->V_hist[0][3*indexer+jindex] - state->V_hist[1][3*indexer+jindex]) * ratio;
+			step_pu = step.Mag() / bus[indexer].volt_base;
+
+			if (step_pu > NR_PREDICTOR_MAX_STEP)
+				continue;
+
+			state->V[3*indexer+jindex] += step;
+			bus[indexer].V[jindex] = state->V[3*indexer+jindex];	//Write through to the node
+
+			if (step_pu > state->predicted_step)
+				state->predicted_step = step_pu;
+		}
+	}
+}
+
+//Keeps the converged voltages of the last two timesteps for predict_solver_voltages - a later
+//solution in the same timestep replaces that timestep's voltages
+static void save_solver_voltages(unsigned int bus_count, NR_SOLVER_STATE *state)
+{
+	TIMESTAMP t = gl_globalclock;
+	dcomplex *temp_V;
+
+	if (state->hist_bus_count != bus_count)
+	{
+		if (state->V_hist[0] != NULL)
+			gl_free(state->V_hist[0]);
+		if (state->V_hist[1] != NULL)
+			gl_free(state->V_hist[1]);
+		state->V_hist[0] = NULL;
+		state->V_hist[1] = NULL;
+		size_solver_state(state->V_hist[0],3*bus_count,0);
+		size_solver_state(state->V_hist[1],3*bus_count,0);
+		state->hist_time[0] = state->hist_time[1] = 0;
+		state->hist_bus_count = bus_count;
+	}
+
+	if (t < state->hist_time[0])	//Not going back in time
+		return;
+
+	if (t != state->hist_time[0])
+	{
+		temp_V = state->V_hist[1];
+		state->V_hist[1] = state->V_hist[0];
+		state->V_hist[0] = temp_V;
+		state->hist_time[1] = state->hist_time[0];
+		state->hist_time[0] = t;
+	}
+
+	memcpy(state->V_hist[0],state->V,3*bus_count*sizeof(dcomplex));
+}
+
 int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type , NR_MESHFAULT_IMPEDANCE *mesh_imped_vals, bool *bad_computations)
 {	
 	// Begin solver timer
@@ -340,6 +604,10 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 	unsigned int m,n;
 	double *sol_LU;
 
+	//Contiguous working state - see gather_solver_state
+	dcomplex *state_V, *state_Yfrom, *state_Yto;
+	double *state_PL, *state_QL, *state_Jacob_A, *state_Jacob_B, *state_Jacob_C, *state_Jacob_D;
+
 	//Spare notation variable - for output
 	SP_E *temp_element;
 	int row, col;
@@ -2192,6 +2460,33 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 	//Reset saturation checks
 	SaturationMismatchPresent = false;
 
+	//Copy the voltages, loads and branch admittances the iterations use into contiguous arrays
+	gather_solver_state(bus_count,bus,branch_count,branch,&powerflow_values->state);
+	state_V = powerflow_values->state.V;
+	state_Yfrom = powerflow_values->state.Yfrom;
+	state_Yto = powerflow_values->state.Yto;
+	state_PL = powerflow_values->state.PL;
+	state_QL = powerflow_values->state.QL;
+	state_Jacob_A = powerflow_values->state.Jacob_A;
+	state_Jacob_B = powerflow_values->state.Jacob_B;
+	state_Jacob_C = powerflow_values->state.Jacob_C;
+	state_Jacob_D = powerflow_values->state.Jacob_D;
+
+	//Start the first solution of a timestep from the predicted voltages
+	if ((NR_predictor == true) && (powerflow_type == PF_NORMAL) && (mesh_imped_vals == NULL) && (restoration_checks_active == false))
+	{
+		predict_solver_voltages(bus_count,bus,&powerflow_values->state);
+
+		if (powerflow_values->state.predicted_step > 0.0)
+		{
+			gl_verbose("NR: predictor moved the starting voltages by up to %g pu",powerflow_values->state.predicted_step);
+		}
+	}
+	else
+	{
+		powerflow_values->state.predicted_step = 0.0;
+	}
+
 	//Calculate the system load - this is the specified power of the system
 	for (Iteration=0; Iteration<NR_iteration_limit; Iteration++)
 	{
@@ -2244,41 +2539,41 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 				if ((*bus[indexer].dynamics_enabled==true) && (bus[indexer].full_Y != NULL) && (bus[indexer].DynCurrent != NULL))
 				{
 					//Form denominator term of Ii, since it won't change
-					temp_complex_1 = (~bus[indexer].V[0]) + (~bus[indexer].V[1])*avalsq + (~bus[indexer].V[2])*aval;
+					temp_complex_1 = (~state_V[3*indexer+0]) + (~state_V[3*indexer+1])*avalsq + (~state_V[3*indexer+2])*aval;
 					
 					//Form up numerator portion that doesn't change (Q and admittance)
 					//Do in parts, just for readability
-					temp_complex_2 = ~bus[indexer].V[0];	//conj(Va)
+					temp_complex_2 = ~state_V[3*indexer+0];	//conj(Va)
 					
 					//Row 1 of admittance mult
-					temp_complex_0 = temp_complex_2*(bus[indexer].full_Y[0]*bus[indexer].V[0] + bus[indexer].full_Y[1]*bus[indexer].V[1] + bus[indexer].full_Y[2]*bus[indexer].V[2]);
+					temp_complex_0 = temp_complex_2*(bus[indexer].full_Y[0]*state_V[3*indexer+0] + bus[indexer].full_Y[1]*state_V[3*indexer+1] + bus[indexer].full_Y[2]*state_V[3*indexer+2]);
 
 					// Row 1 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus 
-					temp_complex_5 = bus[indexer].full_Y[0]*bus[indexer].V[0] + bus[indexer].full_Y[1]*bus[indexer].V[1] + bus[indexer].full_Y[2]*bus[indexer].V[2];
+					temp_complex_5 = bus[indexer].full_Y[0]*state_V[3*indexer+0] + bus[indexer].full_Y[1]*state_V[3*indexer+1] + bus[indexer].full_Y[2]*state_V[3*indexer+2];
 					temp_complex_4 = ~temp_complex_5;
-					temp_complex_3 = bus[indexer].V[0]*temp_complex_4;
+					temp_complex_3 = state_V[3*indexer+0]*temp_complex_4;
 
 					//conj(Vb)
-					temp_complex_2 = ~bus[indexer].V[1];
+					temp_complex_2 = ~state_V[3*indexer+1];
 
 					//Row 2 of admittance
-					temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[3]*bus[indexer].V[0] + bus[indexer].full_Y[4]*bus[indexer].V[1] + bus[indexer].full_Y[5]*bus[indexer].V[2]);
+					temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[3]*state_V[3*indexer+0] + bus[indexer].full_Y[4]*state_V[3*indexer+1] + bus[indexer].full_Y[5]*state_V[3*indexer+2]);
 					
 					// Row 2 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus
-					temp_complex_5 = bus[indexer].full_Y[3]*bus[indexer].V[0] + bus[indexer].full_Y[4]*bus[indexer].V[1] + bus[indexer].full_Y[5]*bus[indexer].V[2];
+					temp_complex_5 = bus[indexer].full_Y[3]*state_V[3*indexer+0] + bus[indexer].full_Y[4]*state_V[3*indexer+1] + bus[indexer].full_Y[5]*state_V[3*indexer+2];
 					temp_complex_4 = ~temp_complex_5;
-					temp_complex_3 += bus[indexer].V[1]*temp_complex_4;
+					temp_complex_3 += state_V[3*indexer+1]*temp_complex_4;
 
 					//conj(Vc)
-					temp_complex_2 = ~bus[indexer].V[2];
+					temp_complex_2 = ~state_V[3*indexer+2];
 
 					//Row 3 of admittance
-					temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[6]*bus[indexer].V[0] + bus[indexer].full_Y[7]*bus[indexer].V[1] + bus[indexer].full_Y[8]*bus[indexer].V[2]);
+					temp_complex_0 += temp_complex_2*(bus[indexer].full_Y[6]*state_V[3*indexer+0] + bus[indexer].full_Y[7]*state_V[3*indexer+1] + bus[indexer].full_Y[8]*state_V[3*indexer+2]);
 
 					// Row 3 also calculate Sysource ( = v * conj(ysource * v)) to substract from PTsource and obtain Pgen at generator bus
-					temp_complex_5 = bus[indexer].full_Y[6]*bus[indexer].V[0] + bus[indexer].full_Y[7]*bus[indexer].V[1] + bus[indexer].full_Y[8]*bus[indexer].V[2];
+					temp_complex_5 = bus[indexer].full_Y[6]*state_V[3*indexer+0] + bus[indexer].full_Y[7]*state_V[3*indexer+1] + bus[indexer].full_Y[8]*state_V[3*indexer+2];
 					temp_complex_4 = ~temp_complex_5;
-					temp_complex_3 += bus[indexer].V[2]*temp_complex_4;					
+					temp_complex_3 += state_V[3*indexer+2]*temp_complex_4;					
 
 					//numerator done, except PT portion (add in below - SWING bus is different
 
@@ -2306,24 +2601,24 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 					if ((bus[indexer].phases & 0x20) == 0x20)	//We're the To bus
 					{
 						//Pre-negated due to the nature of how it's calculated (V1 compared to I1)
-						tempPbus =  bus[indexer].PL[jindex];	//Copy load amounts in
-						tempQbus =  bus[indexer].QL[jindex];	
+						tempPbus =  state_PL[3*indexer+jindex];	//Copy load amounts in
+						tempQbus =  state_QL[3*indexer+jindex];	
 					}
 					else	//We're just a normal triplex bus
 					{
 						//This one isn't negated (normal operations)
-						tempPbus =  -bus[indexer].PL[jindex];	//Copy load amounts in
-						tempQbus =  -bus[indexer].QL[jindex];	
+						tempPbus =  -state_PL[3*indexer+jindex];	//Copy load amounts in
+						tempQbus =  -state_QL[3*indexer+jindex];	
 					}//end normal triplex bus
 
 					//Get diagonal contributions - only (& always) 2
 					//Column 1
-					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (bus[indexer].V[0]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (bus[indexer].V[0]).Im();// equation (7), the diag elements of bus admittance matrix 
-					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (bus[indexer].V[0]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (bus[indexer].V[0]).Re();// equation (8), the diag elements of bus admittance matrix 
+					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (state_V[3*indexer+0]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (state_V[3*indexer+0]).Im();// equation (7), the diag elements of bus admittance matrix 
+					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][0]).Re() * (state_V[3*indexer+0]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][0]).Im() * (state_V[3*indexer+0]).Re();// equation (8), the diag elements of bus admittance matrix 
 
 					//Column 2
-					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (bus[indexer].V[1]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (bus[indexer].V[1]).Im();// equation (7), the diag elements of bus admittance matrix 
-					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (bus[indexer].V[1]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (bus[indexer].V[1]).Re();// equation (8), the diag elements of bus admittance matrix 
+					tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (state_V[3*indexer+1]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (state_V[3*indexer+1]).Im();// equation (7), the diag elements of bus admittance matrix 
+					tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][1]).Re() * (state_V[3*indexer+1]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][1]).Im() * (state_V[3*indexer+1]).Re();// equation (8), the diag elements of bus admittance matrix 
 
 					//Now off diagonals
 					for (kindexer=0; kindexer<(bus[indexer].Link_Table_Size); kindexer++)
@@ -2340,12 +2635,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 								//This situation can only be a normal line (triplex will never be the from for another type)
 								//Again only, & always 2 columns (just do them explicitly)
 								//Column 1
-								tempIcalcReal += ((branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Re() - ((branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += ((branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Im() + ((branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcReal += ((state_Yfrom[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].to+0]).Re() - ((state_Yfrom[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].to+0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += ((state_Yfrom[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].to+0]).Im() + ((state_Yfrom[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].to+0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 								//Column2
-								tempIcalcReal += ((branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Re() - ((branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += ((branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Im() + ((branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcReal += ((state_Yfrom[9*jindexer+jindex*3+1])).Re() * (state_V[3*branch[jindexer].to+1]).Re() - ((state_Yfrom[9*jindexer+jindex*3+1])).Im() * (state_V[3*branch[jindexer].to+1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += ((state_Yfrom[9*jindexer+jindex*3+1])).Re() * (state_V[3*branch[jindexer].to+1]).Im() + ((state_Yfrom[9*jindexer+jindex*3+1])).Im() * (state_V[3*branch[jindexer].to+1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 							}//End SPCT To bus - from diagonal contributions
 							else		//Normal line connection to normal triplex
@@ -2354,12 +2649,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 								//This situation can only be a normal line (triplex will never be the from for another type)
 								//Again only, & always 2 columns (just do them explicitly)
 								//Column 1
-								tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcReal += (-(state_Yfrom[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].to+0]).Re() - (-(state_Yfrom[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].to+0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += (-(state_Yfrom[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].to+0]).Im() + (-(state_Yfrom[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].to+0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 								//Column2
-								tempIcalcReal += (-(branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Re() - (-(branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += (-(branch[jindexer].Yfrom[jindex*3+1])).Re() * (bus[branch[jindexer].to].V[1]).Im() + (-(branch[jindexer].Yfrom[jindex*3+1])).Im() * (bus[branch[jindexer].to].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcReal += (-(state_Yfrom[9*jindexer+jindex*3+1])).Re() * (state_V[3*branch[jindexer].to+1]).Re() - (-(state_Yfrom[9*jindexer+jindex*3+1])).Im() * (state_V[3*branch[jindexer].to+1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += (-(state_Yfrom[9*jindexer+jindex*3+1])).Re() * (state_V[3*branch[jindexer].to+1]).Im() + (-(state_Yfrom[9*jindexer+jindex*3+1])).Im() * (state_V[3*branch[jindexer].to+1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 							}//end normal triplex from
 						}//end from bus
@@ -2388,8 +2683,8 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 								work_vals_char_0 = jindex*3+temp_index;
 
 								//Perform the update, it only happens for one column (nature of the transformer)
-								tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[temp_index]).Re() - (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[temp_index]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-								tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[temp_index]).Im() + (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[temp_index]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcReal += (-(state_Yto[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].from+temp_index]).Re() - (-(state_Yto[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].from+temp_index]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+								tempIcalcImag += (-(state_Yto[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].from+temp_index]).Im() + (-(state_Yto[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].from+temp_index]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 							}//end transformer
 							else									//Must be a normal line then
@@ -2400,24 +2695,24 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 									//This case should never really exist, but if someone reverses a secondary or is doing meshed secondaries, it might
 									//Again only, & always 2 columns (just do them explicitly)
 									//Column 1
-									tempIcalcReal += ((branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Re() - ((branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += ((branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Im() + ((branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcReal += ((state_Yto[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].from+0]).Re() - ((state_Yto[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].from+0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcImag += ((state_Yto[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].from+0]).Im() + ((state_Yto[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].from+0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 									//Column2
-									tempIcalcReal += ((branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Re() - ((branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += ((branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Im() + ((branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcReal += ((state_Yto[9*jindexer+work_vals_char_0+1])).Re() * (state_V[3*branch[jindexer].from+1]).Re() - ((state_Yto[9*jindexer+work_vals_char_0+1])).Im() * (state_V[3*branch[jindexer].from+1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcImag += ((state_Yto[9*jindexer+work_vals_char_0+1])).Re() * (state_V[3*branch[jindexer].from+1]).Im() + ((state_Yto[9*jindexer+work_vals_char_0+1])).Im() * (state_V[3*branch[jindexer].from+1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 								}//End SPCT To bus - from diagonal contributions
 								else		//Normal line connection to normal triplex
 								{
 									work_vals_char_0 = jindex*3;
 									//Again only, & always 2 columns (just do them explicitly)
 									//Column 1
-									tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Re() - (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0])).Re() * (bus[branch[jindexer].from].V[0]).Im() + (-(branch[jindexer].Yto[work_vals_char_0])).Im() * (bus[branch[jindexer].from].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcReal += (-(state_Yto[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].from+0]).Re() - (-(state_Yto[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].from+0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcImag += (-(state_Yto[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].from+0]).Im() + (-(state_Yto[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].from+0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 									//Column2
-									tempIcalcReal += (-(branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Re() - (-(branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-									tempIcalcImag += (-(branch[jindexer].Yto[work_vals_char_0+1])).Re() * (bus[branch[jindexer].from].V[1]).Im() + (-(branch[jindexer].Yto[work_vals_char_0+1])).Im() * (bus[branch[jindexer].from].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcReal += (-(state_Yto[9*jindexer+work_vals_char_0+1])).Re() * (state_V[3*branch[jindexer].from+1]).Re() - (-(state_Yto[9*jindexer+work_vals_char_0+1])).Im() * (state_V[3*branch[jindexer].from+1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+									tempIcalcImag += (-(state_Yto[9*jindexer+work_vals_char_0+1])).Re() * (state_V[3*branch[jindexer].from+1]).Im() + (-(state_Yto[9*jindexer+work_vals_char_0+1])).Im() * (state_V[3*branch[jindexer].from+1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 								}//End normal triplex connection
 							}//end normal line
 						}//end to bus
@@ -2458,8 +2753,8 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 				}//End split-phase present
 				else	//Three phase or some variant thereof
 				{
-					tempPbus =  - bus[indexer].PL[jindex];	//Copy load amounts in
-					tempQbus =  - bus[indexer].QL[jindex];	
+					tempPbus =  - state_PL[3*indexer+jindex];	//Copy load amounts in
+					tempQbus =  - state_QL[3*indexer+jindex];	
 
 					for (kindex=0; kindex<(size_t)powerflow_values->BA_diag[indexer].size; kindex++)		//cols - Still only for specified phases
 					{
@@ -2522,14 +2817,14 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 						}
 
 						//Normal diagonal contributions
-						tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (bus[indexer].V[temp_index]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (bus[indexer].V[temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
-						tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (bus[indexer].V[temp_index]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (bus[indexer].V[temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
+						tempIcalcReal += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (state_V[3*indexer+temp_index]).Re() - (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (state_V[3*indexer+temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
+						tempIcalcImag += (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Re() * (state_V[3*indexer+temp_index]).Im() + (powerflow_values->BA_diag[indexer].Y[jindex][kindex]).Im() * (state_V[3*indexer+temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
 
 						//In-rush load contributions (if any) - only along explicit diagonal
 						if ((bus[indexer].full_Y_load != NULL) && (jindex==kindex))
 						{
-							tempIcalcReal += (bus[indexer].full_Y_load[temp_index]).Re() * (bus[indexer].V[temp_index]).Re() - (bus[indexer].full_Y_load[temp_index]).Im() * (bus[indexer].V[temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
-							tempIcalcImag += (bus[indexer].full_Y_load[temp_index]).Re() * (bus[indexer].V[temp_index]).Im() + (bus[indexer].full_Y_load[temp_index]).Im() * (bus[indexer].V[temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
+							tempIcalcReal += (bus[indexer].full_Y_load[temp_index]).Re() * (state_V[3*indexer+temp_index]).Re() - (bus[indexer].full_Y_load[temp_index]).Im() * (state_V[3*indexer+temp_index]).Im();// equation (7), the diag elements of bus admittance matrix 
+							tempIcalcImag += (bus[indexer].full_Y_load[temp_index]).Re() * (state_V[3*indexer+temp_index]).Im() + (bus[indexer].full_Y_load[temp_index]).Im() * (state_V[3*indexer+temp_index]).Re();// equation (8), the diag elements of bus admittance matrix 
 						}
 
 						//Off diagonal contributions
@@ -2661,22 +2956,22 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 										work_vals_char_0 = temp_index_b*3;
 										//Do columns individually
 										//1
-										tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-										tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0])).Re() * (bus[branch[jindexer].to].V[0]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0])).Im() * (bus[branch[jindexer].to].V[0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+										tempIcalcReal += (-(state_Yfrom[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].to+0]).Re() - (-(state_Yfrom[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].to+0]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+										tempIcalcImag += (-(state_Yfrom[9*jindexer+work_vals_char_0])).Re() * (state_V[3*branch[jindexer].to+0]).Im() + (-(state_Yfrom[9*jindexer+work_vals_char_0])).Im() * (state_V[3*branch[jindexer].to+0]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 										//2
-										tempIcalcReal += (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Re() * (bus[branch[jindexer].to].V[1]).Re() - (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Im() * (bus[branch[jindexer].to].V[1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
-										tempIcalcImag += (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Re() * (bus[branch[jindexer].to].V[1]).Im() + (-(branch[jindexer].Yfrom[work_vals_char_0+1])).Im() * (bus[branch[jindexer].to].V[1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+										tempIcalcReal += (-(state_Yfrom[9*jindexer+work_vals_char_0+1])).Re() * (state_V[3*branch[jindexer].to+1]).Re() - (-(state_Yfrom[9*jindexer+work_vals_char_0+1])).Im() * (state_V[3*branch[jindexer].to+1]).Im();// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
+										tempIcalcImag += (-(state_Yfrom[9*jindexer+work_vals_char_0+1])).Re() * (state_V[3*branch[jindexer].to+1]).Im() + (-(state_Yfrom[9*jindexer+work_vals_char_0+1])).Im() * (state_V[3*branch[jindexer].to+1]).Re();// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 
 									}
 								}//end SPCT transformer
 								else	///Must be a standard line
 								{
 									work_vals_char_0 = temp_index_b*3+temp_index;
-									work_vals_double_0 = (-branch[jindexer].Yfrom[work_vals_char_0]).Re();
-									work_vals_double_1 = (-branch[jindexer].Yfrom[work_vals_char_0]).Im();
-									work_vals_double_2 = (bus[branch[jindexer].to].V[temp_index]).Re();
-									work_vals_double_3 = (bus[branch[jindexer].to].V[temp_index]).Im();
+									work_vals_double_0 = (-state_Yfrom[9*jindexer+work_vals_char_0]).Re();
+									work_vals_double_1 = (-state_Yfrom[9*jindexer+work_vals_char_0]).Im();
+									work_vals_double_2 = (state_V[3*branch[jindexer].to+temp_index]).Re();
+									work_vals_double_3 = (state_V[3*branch[jindexer].to+temp_index]).Im();
 
 									tempIcalcReal += work_vals_double_0 * work_vals_double_2 - work_vals_double_1 * work_vals_double_3;// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 									tempIcalcImag += work_vals_double_0 * work_vals_double_3 + work_vals_double_1 * work_vals_double_2;// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
@@ -2686,10 +2981,10 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 							if  (branch[jindexer].to == (int)indexer)
 							{
 								work_vals_char_0 = temp_index_b*3+temp_index;
-								work_vals_double_0 = (-branch[jindexer].Yto[work_vals_char_0]).Re();
-								work_vals_double_1 = (-branch[jindexer].Yto[work_vals_char_0]).Im();
-								work_vals_double_2 = (bus[branch[jindexer].from].V[temp_index]).Re();
-								work_vals_double_3 = (bus[branch[jindexer].from].V[temp_index]).Im();
+								work_vals_double_0 = (-state_Yto[9*jindexer+work_vals_char_0]).Re();
+								work_vals_double_1 = (-state_Yto[9*jindexer+work_vals_char_0]).Im();
+								work_vals_double_2 = (state_V[3*branch[jindexer].from+temp_index]).Re();
+								work_vals_double_3 = (state_V[3*branch[jindexer].from+temp_index]).Im();
 
 								tempIcalcReal += work_vals_double_0 * work_vals_double_2 - work_vals_double_1 * work_vals_double_3;// equation (7), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
 								tempIcalcImag += work_vals_double_0 * work_vals_double_3 + work_vals_double_1 * work_vals_double_2;// equation (8), the off_diag elements of bus admittance matrix are equal to negative value of branch admittance
@@ -2707,7 +3002,7 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 							if (bus[indexer].full_Y != NULL)
 							{
 								//Compute our "power generated" value for this phase - conjugated in formation
-								temp_complex_2 = bus[indexer].V[jindex] * complex(tempIcalcReal,-tempIcalcImag);
+								temp_complex_2 = state_V[3*indexer+jindex] * complex(tempIcalcReal,-tempIcalcImag);
 
 								if (Iteration>0)	//Only update SWING on subsequent passes
 								{
@@ -2716,12 +3011,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 								}
 
 								//Compute the delta_I, just like below - but don't post it (still zero in calcs)
-								work_vals_double_0 = (bus[indexer].V[temp_index_b]).Mag()*(bus[indexer].V[temp_index_b]).Mag();
+								work_vals_double_0 = (state_V[3*indexer+temp_index_b]).Mag()*(state_V[3*indexer+temp_index_b]).Mag();
 
 								if (work_vals_double_0!=0)	//Only normal one (not square), but a zero is still a zero even after that
 								{
-									work_vals_double_1 = (bus[indexer].V[temp_index_b]).Re();
-									work_vals_double_2 = (bus[indexer].V[temp_index_b]).Im();
+									work_vals_double_1 = (state_V[3*indexer+temp_index_b]).Re();
+									work_vals_double_2 = (state_V[3*indexer+temp_index_b]).Im();
 									work_vals_double_3 = (tempPbus * work_vals_double_1 + tempQbus * work_vals_double_2)/ (work_vals_double_0) - tempIcalcReal; // equation(7), Real part of deltaI, left hand side of equation (11)
 									work_vals_double_4 = (tempPbus * work_vals_double_2 - tempQbus * work_vals_double_1)/ (work_vals_double_0) - tempIcalcImag; // Imaginary part of deltaI, left hand side of equation (11)
 
@@ -2741,12 +3036,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 							else	//Other generator types
 							{
 								//Compute the delta_I, just like below - but don't post it (still zero in calcs)
-								work_vals_double_0 = (bus[indexer].V[temp_index_b]).Mag()*(bus[indexer].V[temp_index_b]).Mag();
+								work_vals_double_0 = (state_V[3*indexer+temp_index_b]).Mag()*(state_V[3*indexer+temp_index_b]).Mag();
 
 								if (work_vals_double_0!=0)	//Only normal one (not square), but a zero is still a zero even after that
 								{
-									work_vals_double_1 = (bus[indexer].V[temp_index_b]).Re();
-									work_vals_double_2 = (bus[indexer].V[temp_index_b]).Im();
+									work_vals_double_1 = (state_V[3*indexer+temp_index_b]).Re();
+									work_vals_double_2 = (state_V[3*indexer+temp_index_b]).Im();
 									work_vals_double_3 = (tempPbus * work_vals_double_1 + tempQbus * work_vals_double_2)/ (work_vals_double_0) - tempIcalcReal; // equation(7), Real part of deltaI, left hand side of equation (11)
 									work_vals_double_4 = (tempPbus * work_vals_double_2 - tempQbus * work_vals_double_1)/ (work_vals_double_0) - tempIcalcImag; // Imaginary part of deltaI, left hand side of equation (11)
 
@@ -2785,12 +3080,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 					}//End SWING bus cases
 					else	//PQ bus or SWING masquerading as a PQ
 					{
-						work_vals_double_0 = (bus[indexer].V[temp_index_b]).Mag()*(bus[indexer].V[temp_index_b]).Mag();
+						work_vals_double_0 = (state_V[3*indexer+temp_index_b]).Mag()*(state_V[3*indexer+temp_index_b]).Mag();
 
 						if (work_vals_double_0!=0)	//Only normal one (not square), but a zero is still a zero even after that
 						{
-							work_vals_double_1 = (bus[indexer].V[temp_index_b]).Re();
-							work_vals_double_2 = (bus[indexer].V[temp_index_b]).Im();
+							work_vals_double_1 = (state_V[3*indexer+temp_index_b]).Re();
+							work_vals_double_2 = (state_V[3*indexer+temp_index_b]).Im();
 
 							//See if deltamode needs to include extra term
 							if (NR_busdata[indexer].BusHistTerm != NULL)
@@ -3008,22 +3303,22 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 				{
 					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
 					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + bus[jindexer].Jacob_A[jindex]; // Equation(14)
+					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + state_Jacob_A[3*jindexer+jindex]; // Equation(14)
 					indexer += 1;
 					
 					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex;
 					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind + powerflow_values->BA_diag[jindexer].size;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + bus[jindexer].Jacob_B[jindex]; // Equation(15)
+					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + state_Jacob_B[3*jindexer+jindex]; // Equation(15)
 					indexer += 1;
 					
 					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
 					powerflow_values->Y_diag_update[indexer].col_ind = 2*bus[jindexer].Matrix_Loc + jindex;
-					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + bus[jindexer].Jacob_C[jindex]; // Equation(16)
+					powerflow_values->Y_diag_update[indexer].Y_value = (powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Re() + state_Jacob_C[3*jindexer+jindex]; // Equation(16)
 					indexer += 1;
 					
 					powerflow_values->Y_diag_update[indexer].row_ind = 2*bus[jindexer].Matrix_Loc + jindex + powerflow_values->BA_diag[jindexer].size;
 					powerflow_values->Y_diag_update[indexer].col_ind = powerflow_values->Y_diag_update[indexer].row_ind;
-					powerflow_values->Y_diag_update[indexer].Y_value = -(powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + bus[jindexer].Jacob_D[jindex]; // Equation(17)
+					powerflow_values->Y_diag_update[indexer].Y_value = -(powerflow_values->BA_diag[jindexer].Y[jindex][jindex]).Im() + state_Jacob_D[3*jindexer+jindex]; // Equation(17)
 					indexer += 1;
 				}//end PQ phase traversion
 			}//End PQ bus
@@ -3704,8 +3999,12 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 					//Pull the two updates (assume split-phase is always 2)
 					DVConvCheck[0]=complex(sol_LU[2*bus[indexer].Matrix_Loc],sol_LU[(2*bus[indexer].Matrix_Loc+2)]);
 					DVConvCheck[1]=complex(sol_LU[(2*bus[indexer].Matrix_Loc+1)],sol_LU[(2*bus[indexer].Matrix_Loc+3)]);
-					bus[indexer].V[0] += DVConvCheck[0];
-					bus[indexer].V[1] += DVConvCheck[1];	//Negative due to convention
+					state_V[3*indexer+0] += DVConvCheck[0];
+					state_V[3*indexer+1] += DVConvCheck[1];	//Negative due to convention
+
+					//Write through to the node, so anything called between iterations sees the update
+					bus[indexer].V[0] = state_V[3*indexer+0];
+					bus[indexer].V[1] = state_V[3*indexer+1];
 					
 					//Pull off the magnitude (no sense calculating it twice)
 					CurrConvVal=DVConvCheck[0].Mag();
@@ -3794,7 +4093,8 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 						}
 
 						DVConvCheck[jindex]=complex(sol_LU[(2*bus[indexer].Matrix_Loc+temp_index)],sol_LU[(2*bus[indexer].Matrix_Loc+powerflow_values->BA_diag[indexer].size+temp_index)]);
-						bus[indexer].V[temp_index_b] += DVConvCheck[jindex];
+						state_V[3*indexer+temp_index_b] += DVConvCheck[jindex];
+						bus[indexer].V[temp_index_b] = state_V[3*indexer+temp_index_b];	//Write through to the node
 						
 						//Pull off the magnitude (no sense calculating it twice)
 						CurrConvVal=DVConvCheck[jindex].Mag();
@@ -3976,1068 +4276,1308 @@ int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count,
 	}
 	else	//Must have converged 
 	{
+		//Keep the solution for the predictor
+		if ((NR_predictor == true) && (powerflow_type == PF_NORMAL) && (mesh_imped_vals == NULL) && (restoration_checks_active == false))
+		{
+			save_solver_voltages(bus_count,&powerflow_values->state);
+		}
+
 		if ( nr_profile != NULL ) 
 		{	
 			double t = clock() - t_start;	
 			char buffer[64];
 			if ( gl_printtime(gl_globalclock,buffer,sizeof(buffer)-1) > 0 )
-				fprintf(nr_profile, "%s,%.1f,%.1lld,%d,%d,%s\n", buffer, t, Iteration == 0 ? 1 : Iteration,bus_count,branch_count,bad_computations ? "false" : "true");
+				fprintf(nr_profile, "%s,%.1f,%.1lld,%d,%d,%s,%g\n", buffer, t, Iteration == 0 ? 1 : Iteration,bus_count,branch_count,bad_computations ? "false" : "true",powerflow_values->state.predicted_step);
 		}
 		return Iteration;
 	}
 }
 
-//Performs the load calculation portions of the current injection or Jacobian update
-//jacobian_pass should be set to true for the a,b,c, and d updates
-// For first approach, working on system load at each bus for current injection
-// For the second approach, calculate the elements of a,b,c,d in equations(14),(15),(16),(17).
-void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, bool jacobian_pass)
+//Rows and columns of the per-bus load terms for each phase combination (phases & 0x07), the same
+//mapping compute_load_general works out with its switch statements - [phases][row] = {row, column}
+static const unsigned char NR_phase_columns[8][3][2] = {
+	{{0,0},{0,0},{0,0}},	//none - not binned
+	{{0,2},{0,2},{0,2}},	//C
+	{{0,1},{0,1},{0,1}},	//B
+	{{0,1},{1,2},{1,2}},	//BC
+	{{0,0},{0,0},{0,0}},	//A
+	{{0,0},{1,2},{1,2}},	//AC
+	{{0,0},{1,1},{2,2}},	//AB
+	{{0,0},{1,1},{2,2}},	//ABC
+};
+
+//Split-phase load calculations for a single bus
+template <bool jacobian_pass> static void compute_load_triplex(BUSDATA *bus, NR_SOLVER_STATE *state, size_t indexer)
+{
+	complex delta_current[3], voltageDel[3];
+	complex temp_current[3], temp_store[3];
+	size_t jindex;
+
+	//This bus's entries in the contiguous solver state
+	dcomplex *bus_V = &state->V[3*indexer];
+	dcomplex *bus_S = &state->S[3*indexer];
+	dcomplex *bus_Y = &state->Y[3*indexer];
+	dcomplex *bus_I = &state->I[3*indexer];
+	dcomplex *bus_prerot_I = &state->prerot_I[3*indexer];
+	double *bus_PL = &state->PL[3*indexer];
+	double *bus_QL = &state->QL[3*indexer];
+	double *bus_Jacob_A = &state->Jacob_A[3*indexer];
+	double *bus_Jacob_B = &state->Jacob_B[3*indexer];
+	double *bus_Jacob_C = &state->Jacob_C[3*indexer];
+	double *bus_Jacob_D = &state->Jacob_D[3*indexer];
+
+	//Convert it all back to current (easiest to handle)
+	//Get V12 first
+	voltageDel[0] = bus_V[0] + bus_V[1];
+
+	//Start with the currents (just put them in)
+	temp_current[0] = bus_I[0];
+	temp_current[1] = bus_I[1];
+	temp_current[2] = *bus[indexer].extra_var; //current12 is not part of the standard current array
+
+	//Add in deltamode unrotated, if necessary
+	//With exception to house currents, rotational correction happened elsewhere (due to triplex being how it is)
+	if ((bus_prerot_I[2] != 0.0) && (*bus[indexer].dynamics_enabled == true))
+		temp_current[2] += bus_prerot_I[2];
+
+	//Now add in power contributions
+	temp_current[0] += bus_V[0] == 0.0 ? 0.0 : ~(bus_S[0]/bus_V[0]);
+	temp_current[1] += bus_V[1] == 0.0 ? 0.0 : ~(bus_S[1]/bus_V[1]);
+	temp_current[2] += voltageDel[0] == 0.0 ? 0.0 : ~(bus_S[2]/voltageDel[0]);
+
+	//Last, but not least, admittance/impedance contributions
+	temp_current[0] += bus_Y[0]*bus_V[0];
+	temp_current[1] += bus_Y[1]*bus_V[1];
+	temp_current[2] += bus_Y[2]*voltageDel[0];
+
+	//See if we are a house-connected node, if so, adjust and add in those values as well
+	if ((bus[indexer].phases & 0x40) == 0x40)
+	{
+		//Update phase adjustments
+		temp_store[0].SetPolar(1.0,bus_V[0].Arg());	//Pull phase of V1
+		temp_store[1].SetPolar(1.0,bus_V[1].Arg());	//Pull phase of V2
+		temp_store[2].SetPolar(1.0,voltageDel[0].Arg());		//Pull phase of V12
+
+		//Update these current contributions (use delta current variable, it isn't used in here anyways)
+		delta_current[0] = bus[indexer].house_var[0]/(~temp_store[0]);		//Just denominator conjugated to keep math right (rest was conjugated in house)
+		delta_current[1] = bus[indexer].house_var[1]/(~temp_store[1]);
+		delta_current[2] = bus[indexer].house_var[2]/(~temp_store[2]);
+
+		//Now add it into the current contributions
+		temp_current[0] += delta_current[0];
+		temp_current[1] += delta_current[1];
+		temp_current[2] += delta_current[2];
+	}//End house-attached splitphase
+
+	if (jacobian_pass == false)	//Current injection update
+	{
+		//Convert 'em to line currents
+		temp_store[0] = temp_current[0] + temp_current[2];
+		temp_store[1] = -temp_current[1] - temp_current[2];
+
+		//Update the stored values
+		bus_PL[0] = temp_store[0].Re();
+		bus_QL[0] = temp_store[0].Im();
+
+		bus_PL[1] = temp_store[1].Re();
+		bus_QL[1] = temp_store[1].Im();
+	}
+	else	//Jacobian update
+	{
+		//Convert 'em to line currents - they need to be negated (due to the convention from earlier)
+		temp_store[0] = -(temp_current[0] + temp_current[2]);
+		temp_store[1] = -(-temp_current[1] - temp_current[2]);
+
+		for (jindex=0; jindex<2; jindex++)
+		{
+			if ((bus_V[jindex]).Mag()!=0)	//Only current
+			{
+				bus_Jacob_A[jindex] = ((bus_V[jindex]).Re()*(bus_V[jindex]).Im()*(temp_store[jindex]).Re() + (temp_store[jindex]).Im() *pow((bus_V[jindex]).Im(),2))/pow((bus_V[jindex]).Mag(),3);// second part of equation(37)
+				bus_Jacob_B[jindex] = -((bus_V[jindex]).Re()*(bus_V[jindex]).Im()*(temp_store[jindex]).Im() + (temp_store[jindex]).Re() *pow((bus_V[jindex]).Re(),2))/pow((bus_V[jindex]).Mag(),3);// second part of equation(38)
+				bus_Jacob_C[jindex] =((bus_V[jindex]).Re()*(bus_V[jindex]).Im()*(temp_store[jindex]).Im() - (temp_store[jindex]).Re() *pow((bus_V[jindex]).Im(),2))/pow((bus_V[jindex]).Mag(),3);// second part of equation(39)
+				bus_Jacob_D[jindex] = ((bus_V[jindex]).Re()*(bus_V[jindex]).Im()*(temp_store[jindex]).Re() - (temp_store[jindex]).Im() *pow((bus_V[jindex]).Re(),2))/pow((bus_V[jindex]).Mag(),3);// second part of equation(40)
+			}
+			else
+			{
+				bus_Jacob_A[jindex]=  -1e-4;	//Put very small to avoid singularity issues
+				bus_Jacob_B[jindex]=  -1e-4;
+				bus_Jacob_C[jindex]=  -1e-4;
+				bus_Jacob_D[jindex]=  -1e-4;
+			}
+		}
+
+		//Zero the last elements, just to be safe (shouldn't be an issue, but who knows)
+		bus_Jacob_A[2] = 0.0;
+		bus_Jacob_B[2] = 0.0;
+		bus_Jacob_C[2] = 0.0;
+		bus_Jacob_D[2] = 0.0;
+	}//End specific update type
+}
+
+//Wye-connected load calculations for a bus with no deltamode adjustments, "different" children,
+//explicit delta/wye loads or in-rush admittance (NR_LOAD_WYE).  This is the wye path of
+//compute_load_general with the terms those cases contribute left out, since they are all zero.
+//Each voltage-dependent factor is computed once per phase instead of once per use.
+template <bool jacobian_pass> static void compute_load_wye(BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, size_t indexer)
+{
+	NR_SOLVER_STATE *state = &powerflow_values->state;
+	const unsigned char (*columns)[2] = NR_phase_columns[bus[indexer].phases & 0x07];
+	size_t jindex, row, col;
+	double Vr, Vi, Vmag, Vr2, Vi2, Vmag3, Vmag4;
+
+	for (jindex=0; jindex<(size_t)powerflow_values->BA_diag[indexer].size; jindex++)
+	{
+		row = 3*indexer + columns[jindex][0];
+		col = 3*indexer + columns[jindex][1];
+		const dcomplex &V = state->V[col];
+		const dcomplex &S = state->S[col];
+		const dcomplex &I = state->I[col];
+		const dcomplex &Y = state->Y[col];
+		Vr = V.Re();
+		Vi = V.Im();
+
+		if (jacobian_pass == false)	//Current injection pass
+		{
+			double tempPbus, tempQbus;
+
+			tempPbus = S.Re();							// Real power portion of constant power portion
+			tempPbus += I.Re() * Vr + I.Im() * Vi;		// Real power portion of Constant current component multiply the magnitude of bus voltage
+			tempPbus += Y.Re() * Vr * Vr + Y.Re() * Vi * Vi;	// Real power portion of Constant impedance component multiply the square of the magnitude of bus voltage
+			state->PL[row] = tempPbus;
+
+			tempQbus = S.Im();							// Reactive power portion of constant power portion
+			tempQbus += I.Re() * Vi - I.Im() * Vr;		// Reactive power portion of Constant current component multiply the magnitude of bus voltage
+			tempQbus += -Y.Im() * Vi * Vi - Y.Im() * Vr * Vr;	// Reactive power portion of Constant impedance component multiply the square of the magnitude of bus voltage
+			state->QL[row] = tempQbus;
+		}
+		else	//Jacobian update pass
+		{
+			Vmag = V.Mag();
+			if (Vmag!=0)
+			{
+				Vr2 = pow(Vr,2);
+				Vi2 = pow(Vi,2);
+				Vmag3 = pow(Vmag,3);
+				Vmag4 = pow(Vmag,4);
+
+				state->Jacob_A[row] = (S.Im() * (Vr2 - Vi2) - 2*Vr*Vi*S.Re())/Vmag4;// first part of equation(37)
+				state->Jacob_A[row] += (Vr*Vi*I.Re() + I.Im() *Vi2)/Vmag3 + Y.Im();// second part of equation(37)
+
+				state->Jacob_B[row] = (S.Re() * (Vr2 - Vi2) + 2*Vr*Vi*S.Im())/Vmag4;// first part of equation(38)
+				state->Jacob_B[row] += -(Vr*Vi*I.Im() + I.Re() *Vr2)/Vmag3 - Y.Re();// second part of equation(38)
+
+				state->Jacob_C[row] = (S.Re() * (Vi2 - Vr2) - 2*Vr*Vi*S.Im())/Vmag4;// first part of equation(39)
+				state->Jacob_C[row] += (Vr*Vi*I.Im() - I.Re() *Vi2)/Vmag3 - Y.Re();// second part of equation(39)
+
+				state->Jacob_D[row] = (S.Im() * (Vr2 - Vi2) - 2*Vr*Vi*S.Re())/Vmag4;// first part of equation(40)
+				state->Jacob_D[row] += (Vr*Vi*I.Re() - I.Im() *Vr2)/Vmag3 - Y.Im();// second part of equation(40)
+			}
+			else
+			{
+				//Small offset to avoid singularity issues - applied by both the wye and explicit load passes of compute_load_general
+				state->Jacob_A[row] = Y.Im() - 1e-4;
+				state->Jacob_B[row] = -Y.Re() - 1e-4;
+				state->Jacob_C[row] = -Y.Re() - 1e-4;
+				state->Jacob_D[row] = -Y.Im() - 1e-4;
+				state->Jacob_A[row] += -1e-4;
+				state->Jacob_B[row] += -1e-4;
+				state->Jacob_C[row] += -1e-4;
+				state->Jacob_D[row] += -1e-4;
+			}
+		}
+	}
+}
+
+//Load calculations for any bus - delta, split-phase and wye connections, deltamode adjustments,
+//"different" children, explicit delta/wye loads and in-rush admittance
+template <bool jacobian_pass> static void compute_load_general(BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, size_t indexer)
 {
-	size_t indexer;
 	double adjust_nominal_voltage_val, adjust_nominal_voltaged_val;
 	double tempPbus, tempQbus;
 	double adjust_temp_voltage_mag[6];
 	complex adjust_temp_nominal_voltage[6], adjusted_constant_current[6];
 	complex delta_current[3], voltageDel[3], undeltacurr[3];
-	complex temp_current[3], temp_store[3];
 	size_t jindex, temp_index, temp_index_b;
-
-	//Loop through the buses
-	for (indexer=0; indexer<bus_count; indexer++)
+	NR_SOLVER_STATE *state = &powerflow_values->state;
+
+	//This bus's entries in the contiguous solver state
+	dcomplex *bus_V = &state->V[3*indexer];
+	dcomplex *bus_S = &state->S[3*indexer];
+	dcomplex *bus_Y = &state->Y[3*indexer];
+	dcomplex *bus_I = &state->I[3*indexer];
+	dcomplex *bus_prerot_I = &state->prerot_I[3*indexer];
+	dcomplex *bus_S_dy = &state->S_dy[6*indexer];
+	dcomplex *bus_Y_dy = &state->Y_dy[6*indexer];
+	dcomplex *bus_I_dy = &state->I_dy[6*indexer];
+	double *bus_PL = &state->PL[3*indexer];
+	double *bus_QL = &state->QL[3*indexer];
+	double *bus_Jacob_A = &state->Jacob_A[3*indexer];
+	double *bus_Jacob_B = &state->Jacob_B[3*indexer];
+	double *bus_Jacob_C = &state->Jacob_C[3*indexer];
+	double *bus_Jacob_D = &state->Jacob_D[3*indexer];
+
+	if ((bus[indexer].phases & 0x08) == 0x08)	//Delta connected node
 	{
-		if ((bus[indexer].phases & 0x08) == 0x08)	//Delta connected node
+		//Populate the values for constant current -- deltamode different right now (all same in future?)
+		if (*bus[indexer].dynamics_enabled == true)
 		{
-			//Populate the values for constant current -- deltamode different right now (all same in future?)
-			if (*bus[indexer].dynamics_enabled == true)
+			//Create nominal magnitudes
+			adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
+
+			//Create the nominal voltage vectors
+			adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
+			adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
+			adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
+
+			//Compute delta voltages
+			voltageDel[0] = bus_V[0] - bus_V[1];
+			voltageDel[1] = bus_V[1] - bus_V[2];
+			voltageDel[2] = bus_V[2] - bus_V[0];
+
+			//Get magnitudes of all
+			adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
+			adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
+			adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
+
+			//Start adjustments - AB
+			if ((bus_I[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus_I[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
+			}
+			else
+			{
+				adjusted_constant_current[0] = complex(0.0,0.0);
+			}
+
+			//Start adjustments - BC
+			if ((bus_I[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus_I[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
+			}
+			else
+			{
+				adjusted_constant_current[1] = complex(0.0,0.0);
+			}
+
+			//Start adjustments - CA
+			if ((bus_I[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus_I[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
+			}
+			else
+			{
+				adjusted_constant_current[2] = complex(0.0,0.0);
+			}
+
+			//See if we have any "different children"
+			if ((bus[indexer].phases & 0x10) == 0x10)
 			{
 				//Create nominal magnitudes
-				adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
+				adjust_nominal_voltage_val = bus[indexer].volt_base;
 
 				//Create the nominal voltage vectors
-				adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
-				adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
-				adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
-
-				//Compute delta voltages
-				voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-				voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-				voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+				adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
+				adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
+				adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
 
 				//Get magnitudes of all
-				adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
-				adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
-				adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
+				adjust_temp_voltage_mag[3] = bus_V[0].Mag();
+				adjust_temp_voltage_mag[4] = bus_V[1].Mag();
+				adjust_temp_voltage_mag[5] = bus_V[2].Mag();
 
-				//Start adjustments - AB
-				if ((bus[indexer].I[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
+				//Start adjustments - A
+				if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
 				{
 					//calculate new value
-					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].I[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
+					adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[3] / (bus_V[0] * adjust_nominal_voltage_val));
 				}
 				else
 				{
-					adjusted_constant_current[0] = complex(0.0,0.0);
+					adjusted_constant_current[3] = complex(0.0,0.0);
 				}
 
-				//Start adjustments - BC
-				if ((bus[indexer].I[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
+				//Start adjustments - B
+				if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
 				{
 					//calculate new value
-					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].I[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
+					adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[4] / (bus_V[1] * adjust_nominal_voltage_val));
 				}
 				else
 				{
-					adjusted_constant_current[1] = complex(0.0,0.0);
+					adjusted_constant_current[4] = complex(0.0,0.0);
 				}
 
-				//Start adjustments - CA
-				if ((bus[indexer].I[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
+				//Start adjustments - C
+				if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
 				{
 					//calculate new value
-					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].I[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
+					adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[5] / (bus_V[2] * adjust_nominal_voltage_val));
 				}
 				else
 				{
-					adjusted_constant_current[2] = complex(0.0,0.0);
-				}
-
-				//See if we have any "different children"
-				if ((bus[indexer].phases & 0x10) == 0x10)
-				{
-					//Create nominal magnitudes
-					adjust_nominal_voltage_val = bus[indexer].volt_base;
-
-					//Create the nominal voltage vectors
-					adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
-					adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
-					adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
-
-					//Get magnitudes of all
-					adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-					adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-					adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
-
-					//Start adjustments - A
-					if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[3] = complex(0.0,0.0);
-					}
-
-					//Start adjustments - B
-					if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[4] = complex(0.0,0.0);
-					}
-
-					//Start adjustments - C
-					if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[5] = complex(0.0,0.0);
-					}
-				}
-				else	//Nope
-				{
-					//Set to zero, just cause
-					adjusted_constant_current[3] = complex(0.0,0.0);
-					adjusted_constant_current[4] = complex(0.0,0.0);
 					adjusted_constant_current[5] = complex(0.0,0.0);
 				}
 			}
-			else	//"Normal" modes -- handle traditionally
+			else	//Nope
 			{
-				adjusted_constant_current[0] = bus[indexer].I[0];
-				adjusted_constant_current[1] = bus[indexer].I[1];
-				adjusted_constant_current[2] = bus[indexer].I[2];
-
-				//See if we have different children too
-				if ((bus[indexer].phases & 0x10) == 0x10)
-				{
-					//Store them too
-					adjusted_constant_current[3] = bus[indexer].extra_var[6];
-					adjusted_constant_current[4] = bus[indexer].extra_var[7];
-					adjusted_constant_current[5] = bus[indexer].extra_var[8];
-				}
-				else	//Nope, just zero this for now
-				{
-					adjusted_constant_current[3] = complex(0.0,0.0);
-					adjusted_constant_current[4] = complex(0.0,0.0);
-					adjusted_constant_current[5] = complex(0.0,0.0);
-				}
-			}//End adjustment code
+				//Set to zero, just cause
+				adjusted_constant_current[3] = complex(0.0,0.0);
+				adjusted_constant_current[4] = complex(0.0,0.0);
+				adjusted_constant_current[5] = complex(0.0,0.0);
+			}
+		}
+		else	//"Normal" modes -- handle traditionally
+		{
+			adjusted_constant_current[0] = bus_I[0];
+			adjusted_constant_current[1] = bus_I[1];
+			adjusted_constant_current[2] = bus_I[2];
 
-			//Delta components - populate according to what is there
-			if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
+			//See if we have different children too
+			if ((bus[indexer].phases & 0x10) == 0x10)
 			{
-				//Voltage calculations
-				voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-
-				//Power - convert to a current (uses less iterations this way)
-				delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].S[0]/voltageDel[0]);
-
-				//Convert delta connected load to appropriate Wye
-				delta_current[0] += voltageDel[0] * (bus[indexer].Y[0]);
+				//Store them too
+				adjusted_constant_current[3] = bus[indexer].extra_var[6];
+				adjusted_constant_current[4] = bus[indexer].extra_var[7];
+				adjusted_constant_current[5] = bus[indexer].extra_var[8];
 			}
-			else
+			else	//Nope, just zero this for now
 			{
-				//Zero values - they shouldn't be used anyhow
-				voltageDel[0] = complex(0.0,0.0);
-				delta_current[0] = complex(0.0,0.0);
+				adjusted_constant_current[3] = complex(0.0,0.0);
+				adjusted_constant_current[4] = complex(0.0,0.0);
+				adjusted_constant_current[5] = complex(0.0,0.0);
 			}
+		}//End adjustment code
 
-			if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
-			{
-				//Voltage calculations
-				voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
+		//Delta components - populate according to what is there
+		if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
+		{
+			//Voltage calculations
+			voltageDel[0] = bus_V[0] - bus_V[1];
 
-				//Power - convert to a current (uses less iterations this way)
-				delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].S[1]/voltageDel[1]);
+			//Power - convert to a current (uses less iterations this way)
+			delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus_S[0]/voltageDel[0]);
 
-				//Convert delta connected load to appropriate Wye
-				delta_current[1] += voltageDel[1] * (bus[indexer].Y[1]);
-			}
-			else
-			{
-				//Zero unused
-				voltageDel[1] = complex(0.0,0.0);
-				delta_current[1] = complex(0.0,0.0);
-			}
+			//Convert delta connected load to appropriate Wye
+			delta_current[0] += voltageDel[0] * (bus_Y[0]);
+		}
+		else
+		{
+			//Zero values - they shouldn't be used anyhow
+			voltageDel[0] = complex(0.0,0.0);
+			delta_current[0] = complex(0.0,0.0);
+		}
 
-			if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
-			{
-				//Voltage calculations
-				voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+		if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
+		{
+			//Voltage calculations
+			voltageDel[1] = bus_V[1] - bus_V[2];
 
-				//Power - convert to a current (uses less iterations this way)
-				delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].S[2]/voltageDel[2]);
+			//Power - convert to a current (uses less iterations this way)
+			delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus_S[1]/voltageDel[1]);
 
-				//Convert delta connected load to appropriate Wye
-				delta_current[2] += voltageDel[2] * (bus[indexer].Y[2]);
-			}
-			else
-			{
-				//Zero unused
-				voltageDel[2] = complex(0.0,0.0);
-				delta_current[2] = complex(0.0,0.0);
-			}
+			//Convert delta connected load to appropriate Wye
+			delta_current[1] += voltageDel[1] * (bus_Y[1]);
+		}
+		else
+		{
+			//Zero unused
+			voltageDel[1] = complex(0.0,0.0);
+			delta_current[1] = complex(0.0,0.0);
+		}
 
-			//Convert delta-current into a phase current, where appropriate - reuse temp variable
-			//Everything will be accumulated into the "current" field for ease (including differents)
-			if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
-			{
-				undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
+		if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
+		{
+			//Voltage calculations
+			voltageDel[2] = bus_V[2] - bus_V[0];
 
-				//Check for "different" children and apply them, as well
-				if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
-				{
-					//Power values
-					undeltacurr[0] += (bus[indexer].V[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/bus[indexer].V[0]);
+			//Power - convert to a current (uses less iterations this way)
+			delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus_S[2]/voltageDel[2]);
 
-					//Shunt values
-					undeltacurr[0] += bus[indexer].extra_var[3]*bus[indexer].V[0];
+			//Convert delta connected load to appropriate Wye
+			delta_current[2] += voltageDel[2] * (bus_Y[2]);
+		}
+		else
+		{
+			//Zero unused
+			voltageDel[2] = complex(0.0,0.0);
+			delta_current[2] = complex(0.0,0.0);
+		}
 
-					//Current values
-					undeltacurr[0] += adjusted_constant_current[3];
-				}
-			}
-			else
-			{
-				//Zero it, just in case
-				undeltacurr[0] = complex(0.0,0.0);
-			}
+		//Convert delta-current into a phase current, where appropriate - reuse temp variable
+		//Everything will be accumulated into the "current" field for ease (including differents)
+		if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
+		{
+			undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
 
-			if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
+			//Check for "different" children and apply them, as well
+			if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
 			{
-				undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
-
-				//Check for "different" children and apply them, as well
-				if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
-				{
-					//Power values
-					undeltacurr[1] += (bus[indexer].V[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/bus[indexer].V[1]);
+				//Power values
+				undeltacurr[0] += (bus_V[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/bus_V[0]);
 
-					//Shunt values
-					undeltacurr[1] += bus[indexer].extra_var[4]*bus[indexer].V[1];
+				//Shunt values
+				undeltacurr[0] += bus[indexer].extra_var[3]*bus_V[0];
 
-					//Current values
-					undeltacurr[1] += adjusted_constant_current[4];
-				}
-			}
-			else
-			{
-				//Zero it, just in case
-				undeltacurr[1] = complex(0.0,0.0);
+				//Current values
+				undeltacurr[0] += adjusted_constant_current[3];
 			}
+		}
+		else
+		{
+			//Zero it, just in case
+			undeltacurr[0] = complex(0.0,0.0);
+		}
 
-			if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
-			{
-				undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+		if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
+		{
+			undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
 
-				//Check for "different" children and apply them, as well
-				if ((bus[indexer].phases & 0x10) == 0x10)		//We do, so they must be Wye-connected
-				{
-					//Power values
-					undeltacurr[2] += (bus[indexer].V[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/bus[indexer].V[2]);
+			//Check for "different" children and apply them, as well
+			if ((bus[indexer].phases & 0x10) == 0x10)	//We do, so they must be Wye-connected
+			{
+				//Power values
+				undeltacurr[1] += (bus_V[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/bus_V[1]);
 
-					//Shunt values
-					undeltacurr[2] += bus[indexer].extra_var[5]*bus[indexer].V[2];
+				//Shunt values
+				undeltacurr[1] += bus[indexer].extra_var[4]*bus_V[1];
 
-					//Current values
-					undeltacurr[2] += adjusted_constant_current[5];
-				}
+				//Current values
+				undeltacurr[1] += adjusted_constant_current[4];
 			}
-			else
+		}
+		else
+		{
+			//Zero it, just in case
+			undeltacurr[1] = complex(0.0,0.0);
+		}
+
+		if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
+		{
+			undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+
+			//Check for "different" children and apply them, as well
+			if ((bus[indexer].phases & 0x10) == 0x10)		//We do, so they must be Wye-connected
 			{
-				//Zero it, just in case
-				undeltacurr[2] = complex(0.0,0.0);
+				//Power values
+				undeltacurr[2] += (bus_V[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/bus_V[2]);
+
+				//Shunt values
+				undeltacurr[2] += bus[indexer].extra_var[5]*bus_V[2];
+
+				//Current values
+				undeltacurr[2] += adjusted_constant_current[5];
 			}
+		}
+		else
+		{
+			//Zero it, just in case
+			undeltacurr[2] = complex(0.0,0.0);
+		}
 
-			//Provide updates to relevant phases
-			//only compute and store phases that exist (make top heavy)
-			temp_index = -1;
-			temp_index_b = -1;
+		//Provide updates to relevant phases
+		//only compute and store phases that exist (make top heavy)
+		temp_index = -1;
+		temp_index_b = -1;
 
-			for (jindex=0; jindex<(size_t)powerflow_values->BA_diag[indexer].size; jindex++)
-			{
-				switch(bus[indexer].phases & 0x07) {
-					case 0x01:	//C
-						{
-							temp_index=0;
-							temp_index_b=2;
-							break;
-						}
-					case 0x02:	//B
+		for (jindex=0; jindex<(size_t)powerflow_values->BA_diag[indexer].size; jindex++)
+		{
+			switch(bus[indexer].phases & 0x07) {
+				case 0x01:	//C
+					{
+						temp_index=0;
+						temp_index_b=2;
+						break;
+					}
+				case 0x02:	//B
+					{
+						temp_index=0;
+						temp_index_b=1;
+						break;
+					}
+				case 0x03:	//BC
+					{
+						if (jindex==0)	//B
 						{
 							temp_index=0;
 							temp_index_b=1;
-							break;
 						}
-					case 0x03:	//BC
+						else			//C
 						{
-							if (jindex==0)	//B
-							{
-								temp_index=0;
-								temp_index_b=1;
-							}
-							else			//C
-							{
-								temp_index=1;
-								temp_index_b=2;
-							}
-							break;
+							temp_index=1;
+							temp_index_b=2;
 						}
-					case 0x04:	//A
+						break;
+					}
+				case 0x04:	//A
+					{
+						temp_index=0;
+						temp_index_b=0;
+						break;
+					}
+				case 0x05:	//AC
+					{
+						if (jindex==0)	//A
 						{
 							temp_index=0;
 							temp_index_b=0;
-							break;
-						}
-					case 0x05:	//AC
-						{
-							if (jindex==0)	//A
-							{
-								temp_index=0;
-								temp_index_b=0;
-							}
-							else			//C
-							{
-								temp_index=1;
-								temp_index_b=2;
-							}
-							break;
 						}
-					case 0x06:	//AB
-					case 0x07:	//ABC
+						else			//C
 						{
-							temp_index=jindex;
-							temp_index_b=jindex;
-							break;
+							temp_index=1;
+							temp_index_b=2;
 						}
-					default:
 						break;
-				}//end case
-
-				if (jacobian_pass == false)	//current-injection updates
-				{
-					if (((int)temp_index==-1) || ((int)temp_index_b==-1))
-					{
-						GL_THROW("NR: A scheduled power update element failed.");
-						//Defined below
-					}
-
-					//Real power calculations
-					tempPbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].PL[temp_index] = tempPbus;	//Real power portion - all is current based
-
-					//Reactive load calculations
-					tempQbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].QL[temp_index] = tempQbus;	//Reactive power portion - all is current based
-				}
-				else	//Jacobian-type update
-				{
-					if (((int)temp_index==-1) || ((int)temp_index_b==-1))
-					{
-						GL_THROW("NR: A Jacobian update element failed.");
-						//Defined below
-					}
-
-					if ((bus[indexer].V[temp_index_b]).Mag()!=0)
-					{
-						bus[indexer].Jacob_A[temp_index] = ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(37) - no power term needed
-						bus[indexer].Jacob_B[temp_index] = -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(38) - no power term needed
-						bus[indexer].Jacob_C[temp_index] =((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(39) - no power term needed
-						bus[indexer].Jacob_D[temp_index] = ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// second part of equation(40) - no power term needed
 					}
-					else	//Zero voltage = only impedance is valid (others get divided by VMag, so are IND) - not entirely sure how this gets in here anyhow
+				case 0x06:	//AB
+				case 0x07:	//ABC
 					{
-						bus[indexer].Jacob_A[temp_index] = -1e-4;	//Small offset to avoid singularities (if impedance is zero too)
-						bus[indexer].Jacob_B[temp_index] = -1e-4;
-						bus[indexer].Jacob_C[temp_index] = -1e-4;
-						bus[indexer].Jacob_D[temp_index] = -1e-4;
+						temp_index=jindex;
+						temp_index_b=jindex;
+						break;
 					}
-				}//End specific bus update method
-			}//End phase traversion
-		}//end delta-connected load
-		else if	((bus[indexer].phases & 0x80) == 0x80)	//Split phase computations
-		{
-			//Convert it all back to current (easiest to handle)
-			//Get V12 first
-			voltageDel[0] = bus[indexer].V[0] + bus[indexer].V[1];
-
-			//Start with the currents (just put them in)
-			temp_current[0] = bus[indexer].I[0];
-			temp_current[1] = bus[indexer].I[1];
-			temp_current[2] = *bus[indexer].extra_var; //current12 is not part of the standard current array
-
-			//Add in deltamode unrotated, if necessary
-			//Same note as above.  With exception to house currents, rotational correction happened elsewhere (due to triplex being how it is)
-			if ((bus[indexer].prerot_I[2] != 0.0) && (*bus[indexer].dynamics_enabled == true))
-				temp_current[2] += bus[indexer].prerot_I[2];
-
-			//Now add in power contributions
-			temp_current[0] += bus[indexer].V[0] == 0.0 ? 0.0 : ~(bus[indexer].S[0]/bus[indexer].V[0]);
-			temp_current[1] += bus[indexer].V[1] == 0.0 ? 0.0 : ~(bus[indexer].S[1]/bus[indexer].V[1]);
-			temp_current[2] += voltageDel[0] == 0.0 ? 0.0 : ~(bus[indexer].S[2]/voltageDel[0]);
-
-			//Last, but not least, admittance/impedance contributions
-			temp_current[0] += bus[indexer].Y[0]*bus[indexer].V[0];
-			temp_current[1] += bus[indexer].Y[1]*bus[indexer].V[1];
-			temp_current[2] += bus[indexer].Y[2]*voltageDel[0];
-
-			//See if we are a house-connected node, if so, adjust and add in those values as well
-			if ((bus[indexer].phases & 0x40) == 0x40)
-			{
-				//Update phase adjustments
-				temp_store[0].SetPolar(1.0,bus[indexer].V[0].Arg());	//Pull phase of V1
-				temp_store[1].SetPolar(1.0,bus[indexer].V[1].Arg());	//Pull phase of V2
-				temp_store[2].SetPolar(1.0,voltageDel[0].Arg());		//Pull phase of V12
-
-				//Update these current contributions (use delta current variable, it isn't used in here anyways)
-				delta_current[0] = bus[indexer].house_var[0]/(~temp_store[0]);		//Just denominator conjugated to keep math right (rest was conjugated in house)
-				delta_current[1] = bus[indexer].house_var[1]/(~temp_store[1]);
-				delta_current[2] = bus[indexer].house_var[2]/(~temp_store[2]);
-
-				//Now add it into the current contributions
-				temp_current[0] += delta_current[0];
-				temp_current[1] += delta_current[1];
-				temp_current[2] += delta_current[2];
-			}//End house-attached splitphase
+				default:
+					break;
+			}//end case
 
-			if (jacobian_pass == false)	//Current injection update
+			if (jacobian_pass == false)	//current-injection updates
 			{
-				//Convert 'em to line currents
-				temp_store[0] = temp_current[0] + temp_current[2];
-				temp_store[1] = -temp_current[1] - temp_current[2];
+				if (((int)temp_index==-1) || ((int)temp_index_b==-1))
+				{
+					GL_THROW("NR: A scheduled power update element failed.");
+					//Defined below
+				}
 
-				//Update the stored values
-				bus[indexer].PL[0] = temp_store[0].Re();
-				bus[indexer].QL[0] = temp_store[0].Im();
+				//Real power calculations
+				tempPbus = (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
+				bus_PL[temp_index] = tempPbus;	//Real power portion - all is current based
 
-				bus[indexer].PL[1] = temp_store[1].Re();
-				bus[indexer].QL[1] = temp_store[1].Im();
+				//Reactive load calculations
+				tempQbus = (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
+				bus_QL[temp_index] = tempQbus;	//Reactive power portion - all is current based
 			}
-			else	//Jacobian update
+			else	//Jacobian-type update
 			{
-				//Convert 'em to line currents - they need to be negated (due to the convention from earlier)
-				temp_store[0] = -(temp_current[0] + temp_current[2]);
-				temp_store[1] = -(-temp_current[1] - temp_current[2]);
-
-				for (jindex=0; jindex<2; jindex++)
+				if (((int)temp_index==-1) || ((int)temp_index_b==-1))
 				{
-					if ((bus[indexer].V[jindex]).Mag()!=0)	//Only current
-					{
-						bus[indexer].Jacob_A[jindex] = ((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Re() + (temp_store[jindex]).Im() *pow((bus[indexer].V[jindex]).Im(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(37)
-						bus[indexer].Jacob_B[jindex] = -((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Im() + (temp_store[jindex]).Re() *pow((bus[indexer].V[jindex]).Re(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(38)
-						bus[indexer].Jacob_C[jindex] =((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Im() - (temp_store[jindex]).Re() *pow((bus[indexer].V[jindex]).Im(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(39)
-						bus[indexer].Jacob_D[jindex] = ((bus[indexer].V[jindex]).Re()*(bus[indexer].V[jindex]).Im()*(temp_store[jindex]).Re() - (temp_store[jindex]).Im() *pow((bus[indexer].V[jindex]).Re(),2))/pow((bus[indexer].V[jindex]).Mag(),3);// second part of equation(40)
-					}
-					else
-					{
-						bus[indexer].Jacob_A[jindex]=  -1e-4;	//Put very small to avoid singularity issues
-						bus[indexer].Jacob_B[jindex]=  -1e-4;
-						bus[indexer].Jacob_C[jindex]=  -1e-4;
-						bus[indexer].Jacob_D[jindex]=  -1e-4;
-					}
+					GL_THROW("NR: A Jacobian update element failed.");
+					//Defined below
 				}
 
-				//Zero the last elements, just to be safe (shouldn't be an issue, but who knows)
-				bus[indexer].Jacob_A[2] = 0.0;
-				bus[indexer].Jacob_B[2] = 0.0;
-				bus[indexer].Jacob_C[2] = 0.0;
-				bus[indexer].Jacob_D[2] = 0.0;
-			}//End specific update type
-		}//end split-phase connected
-		else	//Wye-connected system/load
-		{
-			//Populate the values for constant current -- deltamode different right now (all same in future?)
-			if (*bus[indexer].dynamics_enabled == true)
-			{
-				//Create nominal magnitudes
-				adjust_nominal_voltage_val = bus[indexer].volt_base;
-
-				//Create the nominal voltage vectors
-				adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
-				adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
-				adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
-
-				//Get magnitudes of all
-				adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-				adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-				adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
-
-				//Start adjustments - A
-				if ((bus[indexer].I[0] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
+				if ((bus_V[temp_index_b]).Mag()!=0)
 				{
-					//calculate new value
-					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].I[0] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
+					bus_Jacob_A[temp_index] = ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3);// second part of equation(37) - no power term needed
+					bus_Jacob_B[temp_index] = -((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3);// second part of equation(38) - no power term needed
+					bus_Jacob_C[temp_index] =((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3);// second part of equation(39) - no power term needed
+					bus_Jacob_D[temp_index] = ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3);// second part of equation(40) - no power term needed
 				}
-				else
+				else	//Zero voltage = only impedance is valid (others get divided by VMag, so are IND) - not entirely sure how this gets in here anyhow
 				{
-					adjusted_constant_current[0] = complex(0.0,0.0);
+					bus_Jacob_A[temp_index] = -1e-4;	//Small offset to avoid singularities (if impedance is zero too)
+					bus_Jacob_B[temp_index] = -1e-4;
+					bus_Jacob_C[temp_index] = -1e-4;
+					bus_Jacob_D[temp_index] = -1e-4;
 				}
+			}//End specific bus update method
+		}//End phase traversion
+	}//end delta-connected load
+	else if	((bus[indexer].phases & 0x80) == 0x80)	//Split phase computations
+	{
+		compute_load_triplex<jacobian_pass>(bus,&powerflow_values->state,indexer);
+	}//end split-phase connected
+	else	//Wye-connected system/load
+	{
+		//Populate the values for constant current -- deltamode different right now (all same in future?)
+		if (*bus[indexer].dynamics_enabled == true)
+		{
+			//Create nominal magnitudes
+			adjust_nominal_voltage_val = bus[indexer].volt_base;
 
-				//Start adjustments - B
-				if ((bus[indexer].I[1] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
-				{
-					//calculate new value
-					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].I[1] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
-				}
-				else
-				{
-					adjusted_constant_current[1] = complex(0.0,0.0);
-				}
+			//Create the nominal voltage vectors
+			adjust_temp_nominal_voltage[3].SetPolar(bus[indexer].volt_base,0.0);
+			adjust_temp_nominal_voltage[4].SetPolar(bus[indexer].volt_base,-2.0*PI/3.0);
+			adjust_temp_nominal_voltage[5].SetPolar(bus[indexer].volt_base,2.0*PI/3.0);
 
-				//Start adjustments - C
-				if ((bus[indexer].I[2] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
-				{
-					//calculate new value
-					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].I[2] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
-				}
-				else
-				{
-					adjusted_constant_current[2] = complex(0.0,0.0);
-				}
+			//Get magnitudes of all
+			adjust_temp_voltage_mag[3] = bus_V[0].Mag();
+			adjust_temp_voltage_mag[4] = bus_V[1].Mag();
+			adjust_temp_voltage_mag[5] = bus_V[2].Mag();
 
-				if (bus[indexer].prerot_I[0] != 0.0)
-					adjusted_constant_current[0] += bus[indexer].prerot_I[0];
+			//Start adjustments - A
+			if ((bus_I[0] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[3] * ~bus_I[0] * adjust_temp_voltage_mag[3] / (bus_V[0] * adjust_nominal_voltage_val));
+			}
+			else
+			{
+				adjusted_constant_current[0] = complex(0.0,0.0);
+			}
 
-				if (bus[indexer].prerot_I[1] != 0.0)
-					adjusted_constant_current[1] += bus[indexer].prerot_I[1];
+			//Start adjustments - B
+			if ((bus_I[1] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[4] * ~bus_I[1] * adjust_temp_voltage_mag[4] / (bus_V[1] * adjust_nominal_voltage_val));
+			}
+			else
+			{
+				adjusted_constant_current[1] = complex(0.0,0.0);
+			}
 
-				if (bus[indexer].prerot_I[2] != 0.0)
-					adjusted_constant_current[2] += bus[indexer].prerot_I[2];
+			//Start adjustments - C
+			if ((bus_I[2] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[5] * ~bus_I[2] * adjust_temp_voltage_mag[5] / (bus_V[2] * adjust_nominal_voltage_val));
+			}
+			else
+			{
+				adjusted_constant_current[2] = complex(0.0,0.0);
+			}
 
-				//See if we have any "different children"
-				if ((bus[indexer].phases & 0x10) == 0x10)
-				{
-					//Create nominal magnitudes
-					adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
-
-					//Create the nominal voltage vectors
-					adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
-					adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
-					adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
-
-					//Compute delta voltages
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
-
-					//Get magnitudes of all
-					adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
-					adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
-					adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
-
-					//Start adjustments - AB
-					if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[3] = complex(0.0,0.0);
-					}
+			if (bus_prerot_I[0] != 0.0)
+				adjusted_constant_current[0] += bus_prerot_I[0];
 
-					//Start adjustments - BC
-					if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[4] = complex(0.0,0.0);
-					}
+			if (bus_prerot_I[1] != 0.0)
+				adjusted_constant_current[1] += bus_prerot_I[1];
 
-					//Start adjustments - CA
-					if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
-					{
-						//calculate new value
-						adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
-					}
-					else
-					{
-						adjusted_constant_current[5] = complex(0.0,0.0);
-					}
-				}
-				else	//Nope
-				{
-					//Set to zero, just cause
-					adjusted_constant_current[3] = complex(0.0,0.0);
-					adjusted_constant_current[4] = complex(0.0,0.0);
-					adjusted_constant_current[5] = complex(0.0,0.0);
-				}
-			}
-			else	//"Normal" modes -- handle traditionally
-			{
-				adjusted_constant_current[0] = bus[indexer].I[0];
-				adjusted_constant_current[1] = bus[indexer].I[1];
-				adjusted_constant_current[2] = bus[indexer].I[2];
+			if (bus_prerot_I[2] != 0.0)
+				adjusted_constant_current[2] += bus_prerot_I[2];
 
-				//See if we have different children too
-				if ((bus[indexer].phases & 0x10) == 0x10)
-				{
-					//Store them too
-					adjusted_constant_current[3] = bus[indexer].extra_var[6];
-					adjusted_constant_current[4] = bus[indexer].extra_var[7];
-					adjusted_constant_current[5] = bus[indexer].extra_var[8];
-				}
-				else	//Nope, just zero this for now
-				{
-					adjusted_constant_current[3] = complex(0.0,0.0);
-					adjusted_constant_current[4] = complex(0.0,0.0);
-					adjusted_constant_current[5] = complex(0.0,0.0);
-				}
-			}//End adjustment code
+			//See if we have any "different children"
+			if ((bus[indexer].phases & 0x10) == 0x10)
+			{
+				//Create nominal magnitudes
+				adjust_nominal_voltage_val = bus[indexer].volt_base * sqrt(3.0);
 
-			//For Wye-connected, only compute and store phases that exist (make top heavy)
-			temp_index = -1;
-			temp_index_b = -1;
+				//Create the nominal voltage vectors
+				adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltage_val,PI/6.0);
+				adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltage_val,-1.0*PI/2.0);
+				adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltage_val,5.0*PI/6.0);
 
-			if ((bus[indexer].phases & 0x10) == 0x10)	//"Different" child load - in this case it must be delta - also must be three phase (just because that's how I forced it to be implemented)
-			{											//Calculate all the deltas to wyes in advance (otherwise they'll get repeated)
-				//Make sure phase combinations exist
-				if ((bus[indexer].phases & 0x06) == 0x06)	//Has A-B
-				{
-					//Delta voltages
-					voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
+				//Compute delta voltages
+				voltageDel[0] = bus_V[0] - bus_V[1];
+				voltageDel[1] = bus_V[1] - bus_V[2];
+				voltageDel[2] = bus_V[2] - bus_V[0];
 
-					//Power - put into a current value (iterates less this way)
-					delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/voltageDel[0]);
+				//Get magnitudes of all
+				adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
+				adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
+				adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
 
-					//Convert delta connected load to appropriate Wye
-					delta_current[0] += voltageDel[0] * (bus[indexer].extra_var[3]);
+				//Start adjustments - AB
+				if ((bus[indexer].extra_var[6] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
+				{
+					//calculate new value
+					adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].extra_var[6] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltage_val));
 				}
 				else
 				{
-					//Zero it, for good measure
-					voltageDel[0] = complex(0.0,0.0);
-					delta_current[0] = complex(0.0,0.0);
+					adjusted_constant_current[3] = complex(0.0,0.0);
 				}
 
-				//Check for BC
-				if ((bus[indexer].phases & 0x03) == 0x03)	//Has B-C
+				//Start adjustments - BC
+				if ((bus[indexer].extra_var[7] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
 				{
-					//Delta voltages
-					voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-
-					//Power - put into a current value (iterates less this way)
-					delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/voltageDel[1]);
-
-					//Convert delta connected load to appropriate Wye
-					delta_current[1] += voltageDel[1] * (bus[indexer].extra_var[4]);
+					//calculate new value
+					adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].extra_var[7] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltage_val));
 				}
 				else
 				{
-					//Zero it, for good measure
-					voltageDel[1] = complex(0.0,0.0);
-					delta_current[1] = complex(0.0,0.0);
+					adjusted_constant_current[4] = complex(0.0,0.0);
 				}
 
-				//Check for CA
-				if ((bus[indexer].phases & 0x05) == 0x05)	//Has C-A
+				//Start adjustments - CA
+				if ((bus[indexer].extra_var[8] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
 				{
-					//Delta voltages
-					voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
-
-					//Power - put into a current value (iterates less this way)
-					delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/voltageDel[2]);
-
-					//Convert delta connected load to appropriate Wye
-					delta_current[2] += voltageDel[2] * (bus[indexer].extra_var[5]);
+					//calculate new value
+					adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].extra_var[8] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltage_val));
 				}
 				else
 				{
-					//Zero it, for good measure
-					voltageDel[2] = complex(0.0,0.0);
-					delta_current[2] = complex(0.0,0.0);
+					adjusted_constant_current[5] = complex(0.0,0.0);
 				}
-
-				//Convert delta-current into a phase current - reuse temp variable
-				undeltacurr[0]=(adjusted_constant_current[3]+delta_current[0])-(adjusted_constant_current[5]+delta_current[2]);
-				undeltacurr[1]=(adjusted_constant_current[4]+delta_current[1])-(adjusted_constant_current[3]+delta_current[0]);
-				undeltacurr[2]=(adjusted_constant_current[5]+delta_current[2])-(adjusted_constant_current[4]+delta_current[1]);
 			}
-			else	//zero the variable so we don't have excessive ifs
+			else	//Nope
 			{
-				undeltacurr[0] = undeltacurr[1] = undeltacurr[2] = complex(0.0,0.0);	//Zero it
+				//Set to zero, just cause
+				adjusted_constant_current[3] = complex(0.0,0.0);
+				adjusted_constant_current[4] = complex(0.0,0.0);
+				adjusted_constant_current[5] = complex(0.0,0.0);
 			}
+		}
+		else	//"Normal" modes -- handle traditionally
+		{
+			adjusted_constant_current[0] = bus_I[0];
+			adjusted_constant_current[1] = bus_I[1];
+			adjusted_constant_current[2] = bus_I[2];
 
-			for (jindex=0; jindex<(size_t)powerflow_values->BA_diag[indexer].size; jindex++)
+			//See if we have different children too
+			if ((bus[indexer].phases & 0x10) == 0x10)
 			{
-				switch(bus[indexer].phases & 0x07) {
-					case 0x01:	//C
-						{
-							temp_index=0;
-							temp_index_b=2;
-							break;
-						}
-					case 0x02:	//B
-						{
-							temp_index=0;
-							temp_index_b=1;
-							break;
-						}
-					case 0x03:	//BC
-						{
-							if (jindex==0)	//B
-							{
-								temp_index=0;
-								temp_index_b=1;
-							}
-							else			//C
-							{
-								temp_index=1;
-								temp_index_b=2;
-							}
-							break;
-						}
-					case 0x04:	//A
-						{
-							temp_index=0;
-							temp_index_b=0;
-							break;
-						}
-					case 0x05:	//AC
-						{
-							if (jindex==0)	//A
-							{
-								temp_index=0;
-								temp_index_b=0;
-							}
-							else			//C
-							{
-								temp_index=1;
-								temp_index_b=2;
-							}
-							break;
-						}
-					case 0x06:	//AB
-					case 0x07:	//ABC
-						{
-							temp_index=jindex;
-							temp_index_b=jindex;
-							break;
-						}
-					default:
-						break;
-				}//end case
-
-				if (jacobian_pass == false)	//Current injection pass
-				{
-					if (((int)temp_index==-1) || ((int)temp_index_b==-1))
-					{
-						GL_THROW("NR: A scheduled power update element failed.");
-						/*  TROUBLESHOOT
-						While attempting to calculate the scheduled portions of the
-						attached loads, an update failed to process correctly.
-						Submit you code and a bug report using the trac website.
-						*/
-					}
-
-					//Perform the power calculation
-					tempPbus = (bus[indexer].S[temp_index_b]).Re();									// Real power portion of constant power portion
-					tempPbus += (adjusted_constant_current[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
-					tempPbus += (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current from "different" children
-					tempPbus += (bus[indexer].Y[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (bus[indexer].Y[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant impedance component multiply the square of the magnitude of bus voltage
-					bus[indexer].PL[temp_index] = tempPbus;	//Real power portion
-
-
-					tempQbus = (bus[indexer].S[temp_index_b]).Im();									// Reactive power portion of constant power portion
-					tempQbus += (adjusted_constant_current[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
-					tempQbus += (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current from "different" children
-					tempQbus += -(bus[indexer].Y[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im() - (bus[indexer].Y[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant impedance component multiply the square of the magnitude of bus voltage
-					bus[indexer].QL[temp_index] = tempQbus;	//Reactive power portion
-				}
-				else	//Jacobian update pass
-				{
-					if (((int)temp_index==-1) || ((int)temp_index_b==-1))
-					{
-						GL_THROW("NR: A Jacobian update element failed.");
-						/*  TROUBLESHOOT
-						While attempting to calculate the "dynamic" portions of the
-						Jacobian matrix that encompass attached loads, an update failed to process correctly.
-						Submit you code and a bug report using the trac website.
-						*/
-					}
-
-					if ((bus[indexer].V[temp_index_b]).Mag()!=0)
-					{
-						bus[indexer].Jacob_A[temp_index] = ((bus[indexer].S[temp_index_b]).Im() * (pow((bus[indexer].V[temp_index_b]).Re(),2) - pow((bus[indexer].V[temp_index_b]).Im(),2)) - 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Re())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(37)
-						bus[indexer].Jacob_A[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) + (bus[indexer].Y[temp_index_b]).Im();// second part of equation(37)
-						bus[indexer].Jacob_A[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// current part of equation (37) - Handles "different" children
-
-						bus[indexer].Jacob_B[temp_index] = ((bus[indexer].S[temp_index_b]).Re() * (pow((bus[indexer].V[temp_index_b]).Re(),2) - pow((bus[indexer].V[temp_index_b]).Im(),2)) + 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Im())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(38)
-						bus[indexer].Jacob_B[temp_index] += -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() + (adjusted_constant_current[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Re();// second part of equation(38)
-						bus[indexer].Jacob_B[temp_index] += -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// current part of equation(38) - Handles "different" children
-
-						bus[indexer].Jacob_C[temp_index] = ((bus[indexer].S[temp_index_b]).Re() * (pow((bus[indexer].V[temp_index_b]).Im(),2) - pow((bus[indexer].V[temp_index_b]).Re(),2)) - 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Im())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(39)
-						bus[indexer].Jacob_C[temp_index] +=((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Re();// second part of equation(39)
-						bus[indexer].Jacob_C[temp_index] +=((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// Current part of equation(39) - Handles "different" children
-
-						bus[indexer].Jacob_D[temp_index] = ((bus[indexer].S[temp_index_b]).Im() * (pow((bus[indexer].V[temp_index_b]).Re(),2) - pow((bus[indexer].V[temp_index_b]).Im(),2)) - 2*(bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(bus[indexer].S[temp_index_b]).Re())/pow((bus[indexer].V[temp_index_b]).Mag(),4);// first part of equation(40)
-						bus[indexer].Jacob_D[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() - (adjusted_constant_current[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3) - (bus[indexer].Y[temp_index_b]).Im();// second part of equation(40)
-						bus[indexer].Jacob_D[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3);// Current part of equation(40) - Handles "different" children
+				//Store them too
+				adjusted_constant_current[3] = bus[indexer].extra_var[6];
+				adjusted_constant_current[4] = bus[indexer].extra_var[7];
+				adjusted_constant_current[5] = bus[indexer].extra_var[8];
+			}
+			else	//Nope, just zero this for now
+			{
+				adjusted_constant_current[3] = complex(0.0,0.0);
+				adjusted_constant_current[4] = complex(0.0,0.0);
+				adjusted_constant_current[5] = complex(0.0,0.0);
+			}
+		}//End adjustment code
 
-					}
-					else
-					{
-						bus[indexer].Jacob_A[temp_index]= (bus[indexer].Y[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularity issues
-						bus[indexer].Jacob_B[temp_index]= -(bus[indexer].Y[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_C[temp_index]= -(bus[indexer].Y[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_D[temp_index]= -(bus[indexer].Y[temp_index_b]).Im() - 1e-4;
-					}
-				}//End of pass-specific bus updates
-			}//End phase traversion - Wye
-		}//End wye-connected load
+		//For Wye-connected, only compute and store phases that exist (make top heavy)
+		temp_index = -1;
+		temp_index_b = -1;
 
-		//Perform delta/wye explicit load updates -- no triplex
-		if ((bus[indexer].phases & 0x80) != 0x80)	//Not triplex
-		{
-			//Delta components - populate according to what is there
-			if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
+		if ((bus[indexer].phases & 0x10) == 0x10)	//"Different" child load - in this case it must be delta - also must be three phase (just because that's how I forced it to be implemented)
+		{											//Calculate all the deltas to wyes in advance (otherwise they'll get repeated)
+			//Make sure phase combinations exist
+			if ((bus[indexer].phases & 0x06) == 0x06)	//Has A-B
 			{
-				//Voltage calculations
-				voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
+				//Delta voltages
+				voltageDel[0] = bus_V[0] - bus_V[1];
 
-				//Power - convert to a current (uses less iterations this way)
-				delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].S_dy[0]/voltageDel[0]);
+				//Power - put into a current value (iterates less this way)
+				delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus[indexer].extra_var[0]/voltageDel[0]);
 
 				//Convert delta connected load to appropriate Wye
-				delta_current[0] += voltageDel[0] * (bus[indexer].Y_dy[0]);
-
+				delta_current[0] += voltageDel[0] * (bus[indexer].extra_var[3]);
 			}
 			else
 			{
-				//Zero values - they shouldn't be used anyhow
+				//Zero it, for good measure
 				voltageDel[0] = complex(0.0,0.0);
 				delta_current[0] = complex(0.0,0.0);
 			}
 
-			if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
+			//Check for BC
+			if ((bus[indexer].phases & 0x03) == 0x03)	//Has B-C
 			{
-				//Voltage calculations
-				voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
+				//Delta voltages
+				voltageDel[1] = bus_V[1] - bus_V[2];
 
-				//Power - convert to a current (uses less iterations this way)
-				delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].S_dy[1]/voltageDel[1]);
+				//Power - put into a current value (iterates less this way)
+				delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus[indexer].extra_var[1]/voltageDel[1]);
 
 				//Convert delta connected load to appropriate Wye
-				delta_current[1] += voltageDel[1] * (bus[indexer].Y_dy[1]);
-
+				delta_current[1] += voltageDel[1] * (bus[indexer].extra_var[4]);
 			}
 			else
 			{
-				//Zero unused
+				//Zero it, for good measure
 				voltageDel[1] = complex(0.0,0.0);
 				delta_current[1] = complex(0.0,0.0);
 			}
 
-			if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
+			//Check for CA
+			if ((bus[indexer].phases & 0x05) == 0x05)	//Has C-A
 			{
-				//Voltage calculations
-				voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+				//Delta voltages
+				voltageDel[2] = bus_V[2] - bus_V[0];
 
-				//Power - convert to a current (uses less iterations this way)
-				delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].S_dy[2]/voltageDel[2]);
+				//Power - put into a current value (iterates less this way)
+				delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus[indexer].extra_var[2]/voltageDel[2]);
 
 				//Convert delta connected load to appropriate Wye
-				delta_current[2] += voltageDel[2] * (bus[indexer].Y_dy[2]);
-
+				delta_current[2] += voltageDel[2] * (bus[indexer].extra_var[5]);
 			}
 			else
 			{
-				//Zero unused
+				//Zero it, for good measure
 				voltageDel[2] = complex(0.0,0.0);
 				delta_current[2] = complex(0.0,0.0);
 			}
 
-			//Populate the values for constant current -- deltamode different right now (all same in future?)
-			if (*bus[indexer].dynamics_enabled == true)
-			{
-				//Create line-line nominal magnitude
-				adjust_nominal_voltage_val = bus[indexer].volt_base;
-				adjust_nominal_voltaged_val = bus[indexer].volt_base * sqrt(3.0);
-
-				//Create the nominal voltage vectors
-				adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltaged_val,PI/6.0);
-				adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltaged_val,-1.0*PI/2.0);
-				adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltaged_val,5.0*PI/6.0);
-				adjust_temp_nominal_voltage[3].SetPolar(adjust_nominal_voltage_val,0.0);
-				adjust_temp_nominal_voltage[4].SetPolar(adjust_nominal_voltage_val,-2.0*PI/3.0);
-				adjust_temp_nominal_voltage[5].SetPolar(adjust_nominal_voltage_val,2.0*PI/3.0);
-
-				//Compute delta voltages
-				voltageDel[0] = bus[indexer].V[0] - bus[indexer].V[1];
-				voltageDel[1] = bus[indexer].V[1] - bus[indexer].V[2];
-				voltageDel[2] = bus[indexer].V[2] - bus[indexer].V[0];
+			//Convert delta-current into a phase current - reuse temp variable
+			undeltacurr[0]=(adjusted_constant_current[3]+delta_current[0])-(adjusted_constant_current[5]+delta_current[2]);
+			undeltacurr[1]=(adjusted_constant_current[4]+delta_current[1])-(adjusted_constant_current[3]+delta_current[0]);
+			undeltacurr[2]=(adjusted_constant_current[5]+delta_current[2])-(adjusted_constant_current[4]+delta_current[1]);
+		}
+		else	//zero the variable so we don't have excessive ifs
+		{
+			undeltacurr[0] = undeltacurr[1] = undeltacurr[2] = complex(0.0,0.0);	//Zero it
+		}
 
-				//Get magnitudes of all
-				adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
-				adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
-				adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
-				adjust_temp_voltage_mag[3] = bus[indexer].V[0].Mag();
-				adjust_temp_voltage_mag[4] = bus[indexer].V[1].Mag();
-				adjust_temp_voltage_mag[5] = bus[indexer].V[2].Mag();
+		for (jindex=0; jindex<(size_t)powerflow_values->BA_diag[indexer].size; jindex++)
+		{
+			switch(bus[indexer].phases & 0x07) {
+				case 0x01:	//C
+					{
+						temp_index=0;
+						temp_index_b=2;
+						break;
+					}
+				case 0x02:	//B
+					{
+						temp_index=0;
+						temp_index_b=1;
+						break;
+					}
+				case 0x03:	//BC
+					{
+						if (jindex==0)	//B
+						{
+							temp_index=0;
+							temp_index_b=1;
+						}
+						else			//C
+						{
+							temp_index=1;
+							temp_index_b=2;
+						}
+						break;
+					}
+				case 0x04:	//A
+					{
+						temp_index=0;
+						temp_index_b=0;
+						break;
+					}
+				case 0x05:	//AC
+					{
+						if (jindex==0)	//A
+						{
+							temp_index=0;
+							temp_index_b=0;
+						}
+						else			//C
+						{
+							temp_index=1;
+							temp_index_b=2;
+						}
+						break;
+					}
+				case 0x06:	//AB
+				case 0x07:	//ABC
+					{
+						temp_index=jindex;
+						temp_index_b=jindex;
+						break;
+					}
+				default:
+					break;
+			}//end case
 
-				//Start adjustments - A
-				if ((bus[indexer].I_dy[3] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
-				{
-					//calculate new value
-					adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus[indexer].I_dy[3] * adjust_temp_voltage_mag[3] / (bus[indexer].V[0] * adjust_nominal_voltage_val));
-				}
-				else
+			if (jacobian_pass == false)	//Current injection pass
+			{
+				if (((int)temp_index==-1) || ((int)temp_index_b==-1))
 				{
-					adjusted_constant_current[3] = complex(0.0,0.0);
+					GL_THROW("NR: A scheduled power update element failed.");
+					/*  TROUBLESHOOT
+					While attempting to calculate the scheduled portions of the
+					attached loads, an update failed to process correctly.
+					Submit you code and a bug report using the trac website.
+					*/
 				}
 
-				//Start adjustments - B
-				if ((bus[indexer].I_dy[4] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
-				{
-					//calculate new value
-					adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus[indexer].I_dy[4] * adjust_temp_voltage_mag[4] / (bus[indexer].V[1] * adjust_nominal_voltage_val));
-				}
-				else
-				{
-					adjusted_constant_current[4] = complex(0.0,0.0);
-				}
+				//Perform the power calculation
+				tempPbus = (bus_S[temp_index_b]).Re();									// Real power portion of constant power portion
+				tempPbus += (adjusted_constant_current[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() * (bus_V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
+				tempPbus += (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Im();	// Real power portion of Constant current from "different" children
+				tempPbus += (bus_Y[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() + (bus_Y[temp_index_b]).Re() * (bus_V[temp_index_b]).Im() * (bus_V[temp_index_b]).Im();	// Real power portion of Constant impedance component multiply the square of the magnitude of bus voltage
+				bus_PL[temp_index] = tempPbus;	//Real power portion
 
-				//Start adjustments - C
-				if ((bus[indexer].I_dy[5] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
-				{
-					//calculate new value
-					adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus[indexer].I_dy[5] * adjust_temp_voltage_mag[5] / (bus[indexer].V[2] * adjust_nominal_voltage_val));
-				}
-				else
-				{
-					adjusted_constant_current[5] = complex(0.0,0.0);
-				}
 
-				//Start adjustments - AB
-				if ((bus[indexer].I_dy[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
-				{
-					//calculate new value
-					adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus[indexer].I_dy[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltaged_val));
-				}
-				else
+				tempQbus = (bus_S[temp_index_b]).Im();									// Reactive power portion of constant power portion
+				tempQbus += (adjusted_constant_current[temp_index_b]).Re() * (bus_V[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Im() * (bus_V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
+				tempQbus += (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Re();	// Reactive power portion of Constant current from "different" children
+				tempQbus += -(bus_Y[temp_index_b]).Im() * (bus_V[temp_index_b]).Im() * (bus_V[temp_index_b]).Im() - (bus_Y[temp_index_b]).Im() * (bus_V[temp_index_b]).Re() * (bus_V[temp_index_b]).Re();	// Reactive power portion of Constant impedance component multiply the square of the magnitude of bus voltage
+				bus_QL[temp_index] = tempQbus;	//Reactive power portion
+			}
+			else	//Jacobian update pass
+			{
+				if (((int)temp_index==-1) || ((int)temp_index_b==-1))
 				{
-					adjusted_constant_current[0] = complex(0.0,0.0);
+					GL_THROW("NR: A Jacobian update element failed.");
+					/*  TROUBLESHOOT
+					While attempting to calculate the "dynamic" portions of the
+					Jacobian matrix that encompass attached loads, an update failed to process correctly.
+					Submit you code and a bug report using the trac website.
+					*/
 				}
 
-				//Start adjustments - BC
-				if ((bus[indexer].I_dy[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
+				if ((bus_V[temp_index_b]).Mag()!=0)
 				{
-					//calculate new value
-					adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus[indexer].I_dy[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltaged_val));
+					bus_Jacob_A[temp_index] = ((bus_S[temp_index_b]).Im() * (pow((bus_V[temp_index_b]).Re(),2) - pow((bus_V[temp_index_b]).Im(),2)) - 2*(bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(bus_S[temp_index_b]).Re())/pow((bus_V[temp_index_b]).Mag(),4);// first part of equation(37)
+					bus_Jacob_A[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() + (adjusted_constant_current[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3) + (bus_Y[temp_index_b]).Im();// second part of equation(37)
+					bus_Jacob_A[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3);// current part of equation (37) - Handles "different" children
+
+					bus_Jacob_B[temp_index] = ((bus_S[temp_index_b]).Re() * (pow((bus_V[temp_index_b]).Re(),2) - pow((bus_V[temp_index_b]).Im(),2)) + 2*(bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(bus_S[temp_index_b]).Im())/pow((bus_V[temp_index_b]).Mag(),4);// first part of equation(38)
+					bus_Jacob_B[temp_index] += -((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() + (adjusted_constant_current[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3) - (bus_Y[temp_index_b]).Re();// second part of equation(38)
+					bus_Jacob_B[temp_index] += -((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3);// current part of equation(38) - Handles "different" children
+
+					bus_Jacob_C[temp_index] = ((bus_S[temp_index_b]).Re() * (pow((bus_V[temp_index_b]).Im(),2) - pow((bus_V[temp_index_b]).Re(),2)) - 2*(bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(bus_S[temp_index_b]).Im())/pow((bus_V[temp_index_b]).Mag(),4);// first part of equation(39)
+					bus_Jacob_C[temp_index] +=((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Im() - (adjusted_constant_current[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3) - (bus_Y[temp_index_b]).Re();// second part of equation(39)
+					bus_Jacob_C[temp_index] +=((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3);// Current part of equation(39) - Handles "different" children
+
+					bus_Jacob_D[temp_index] = ((bus_S[temp_index_b]).Im() * (pow((bus_V[temp_index_b]).Re(),2) - pow((bus_V[temp_index_b]).Im(),2)) - 2*(bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(bus_S[temp_index_b]).Re())/pow((bus_V[temp_index_b]).Mag(),4);// first part of equation(40)
+					bus_Jacob_D[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(adjusted_constant_current[temp_index_b]).Re() - (adjusted_constant_current[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3) - (bus_Y[temp_index_b]).Im();// second part of equation(40)
+					bus_Jacob_D[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3);// Current part of equation(40) - Handles "different" children
+
 				}
 				else
 				{
-					adjusted_constant_current[1] = complex(0.0,0.0);
+					bus_Jacob_A[temp_index]= (bus_Y[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularity issues
+					bus_Jacob_B[temp_index]= -(bus_Y[temp_index_b]).Re() - 1e-4;
+					bus_Jacob_C[temp_index]= -(bus_Y[temp_index_b]).Re() - 1e-4;
+					bus_Jacob_D[temp_index]= -(bus_Y[temp_index_b]).Im() - 1e-4;
 				}
+			}//End of pass-specific bus updates
+		}//End phase traversion - Wye
+	}//End wye-connected load
+
+	//Perform delta/wye explicit load updates -- no triplex
+	if ((bus[indexer].phases & 0x80) != 0x80)	//Not triplex
+	{
+		//Delta components - populate according to what is there
+		if ((bus[indexer].phases & 0x06) == 0x06)	//Check for AB
+		{
+			//Voltage calculations
+			voltageDel[0] = bus_V[0] - bus_V[1];
+
+			//Power - convert to a current (uses less iterations this way)
+			delta_current[0] = (voltageDel[0] == 0) ? 0 : ~(bus_S_dy[0]/voltageDel[0]);
+
+			//Convert delta connected load to appropriate Wye
+			delta_current[0] += voltageDel[0] * (bus_Y_dy[0]);
+
+		}
+		else
+		{
+			//Zero values - they shouldn't be used anyhow
+			voltageDel[0] = complex(0.0,0.0);
+			delta_current[0] = complex(0.0,0.0);
+		}
+
+		if ((bus[indexer].phases & 0x03) == 0x03)	//Check for BC
+		{
+			//Voltage calculations
+			voltageDel[1] = bus_V[1] - bus_V[2];
 
-				//Start adjustments - CA
-				if ((bus[indexer].I_dy[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
-				{
-					//calculate new value
-					adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus[indexer].I_dy[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltaged_val));
-				}
-				else
-				{
-					adjusted_constant_current[2] = complex(0.0,0.0);
-				}
-			}//End deltamode adjustment
-			else	//Normal mode
-			{
-				//Just copy the values in
-				adjusted_constant_current[0] = bus[indexer].I_dy[0];
-				adjusted_constant_current[1] = bus[indexer].I_dy[1];
-				adjusted_constant_current[2] = bus[indexer].I_dy[2];
-				adjusted_constant_current[3] = bus[indexer].I_dy[3];
-				adjusted_constant_current[4] = bus[indexer].I_dy[4];
-				adjusted_constant_current[5] = bus[indexer].I_dy[5];
-			}
+			//Power - convert to a current (uses less iterations this way)
+			delta_current[1] = (voltageDel[1] == 0) ? 0 : ~(bus_S_dy[1]/voltageDel[1]);
 
-			//Convert delta-current into a phase current, where appropriate - reuse temp variable
-			//Everything will be accumulated into the "current" field for ease (including differents)
-			//Also handle wye currents in here (was a differently connected child code before)
-			if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
-			{
-				undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
+			//Convert delta connected load to appropriate Wye
+			delta_current[1] += voltageDel[1] * (bus_Y_dy[1]);
 
-				//Apply explicit wye-connected loads
+		}
+		else
+		{
+			//Zero unused
+			voltageDel[1] = complex(0.0,0.0);
+			delta_current[1] = complex(0.0,0.0);
+		}
 
-				//Power values
-				undeltacurr[0] += (bus[indexer].V[0] == 0) ? 0 : ~(bus[indexer].S_dy[3]/bus[indexer].V[0]);
+		if ((bus[indexer].phases & 0x05) == 0x05)	//Check for CA
+		{
+			//Voltage calculations
+			voltageDel[2] = bus_V[2] - bus_V[0];
 
-				//Shunt values
-				undeltacurr[0] += bus[indexer].Y_dy[3]*bus[indexer].V[0];
+			//Power - convert to a current (uses less iterations this way)
+			delta_current[2] = (voltageDel[2] == 0) ? 0 : ~(bus_S_dy[2]/voltageDel[2]);
 
-				//Current values
-				undeltacurr[0] += adjusted_constant_current[3];
+			//Convert delta connected load to appropriate Wye
+			delta_current[2] += voltageDel[2] * (bus_Y_dy[2]);
+
+		}
+		else
+		{
+			//Zero unused
+			voltageDel[2] = complex(0.0,0.0);
+			delta_current[2] = complex(0.0,0.0);
+		}
+
+		//Populate the values for constant current -- deltamode different right now (all same in future?)
+		if (*bus[indexer].dynamics_enabled == true)
+		{
+			//Create line-line nominal magnitude
+			adjust_nominal_voltage_val = bus[indexer].volt_base;
+			adjust_nominal_voltaged_val = bus[indexer].volt_base * sqrt(3.0);
+
+			//Create the nominal voltage vectors
+			adjust_temp_nominal_voltage[0].SetPolar(adjust_nominal_voltaged_val,PI/6.0);
+			adjust_temp_nominal_voltage[1].SetPolar(adjust_nominal_voltaged_val,-1.0*PI/2.0);
+			adjust_temp_nominal_voltage[2].SetPolar(adjust_nominal_voltaged_val,5.0*PI/6.0);
+			adjust_temp_nominal_voltage[3].SetPolar(adjust_nominal_voltage_val,0.0);
+			adjust_temp_nominal_voltage[4].SetPolar(adjust_nominal_voltage_val,-2.0*PI/3.0);
+			adjust_temp_nominal_voltage[5].SetPolar(adjust_nominal_voltage_val,2.0*PI/3.0);
+
+			//Compute delta voltages
+			voltageDel[0] = bus_V[0] - bus_V[1];
+			voltageDel[1] = bus_V[1] - bus_V[2];
+			voltageDel[2] = bus_V[2] - bus_V[0];
+
+			//Get magnitudes of all
+			adjust_temp_voltage_mag[0] = voltageDel[0].Mag();
+			adjust_temp_voltage_mag[1] = voltageDel[1].Mag();
+			adjust_temp_voltage_mag[2] = voltageDel[2].Mag();
+			adjust_temp_voltage_mag[3] = bus_V[0].Mag();
+			adjust_temp_voltage_mag[4] = bus_V[1].Mag();
+			adjust_temp_voltage_mag[5] = bus_V[2].Mag();
+
+			//Start adjustments - A
+			if ((bus_I_dy[3] != 0.0) && (adjust_temp_voltage_mag[3] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[3] = ~(adjust_temp_nominal_voltage[3] * ~bus_I_dy[3] * adjust_temp_voltage_mag[3] / (bus_V[0] * adjust_nominal_voltage_val));
 			}
 			else
 			{
-				//Zero it, just in case
-				undeltacurr[0] = complex(0.0,0.0);
+				adjusted_constant_current[3] = complex(0.0,0.0);
 			}
 
-			if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
+			//Start adjustments - B
+			if ((bus_I_dy[4] != 0.0) && (adjust_temp_voltage_mag[4] != 0.0))
 			{
-				undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
-
-				//Apply explicit wye-connected loads
+				//calculate new value
+				adjusted_constant_current[4] = ~(adjust_temp_nominal_voltage[4] * ~bus_I_dy[4] * adjust_temp_voltage_mag[4] / (bus_V[1] * adjust_nominal_voltage_val));
+			}
+			else
+			{
+				adjusted_constant_current[4] = complex(0.0,0.0);
+			}
 
-				//Power values
-				undeltacurr[1] += (bus[indexer].V[1] == 0) ? 0 : ~(bus[indexer].S_dy[4]/bus[indexer].V[1]);
+			//Start adjustments - C
+			if ((bus_I_dy[5] != 0.0) && (adjust_temp_voltage_mag[5] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[5] = ~(adjust_temp_nominal_voltage[5] * ~bus_I_dy[5] * adjust_temp_voltage_mag[5] / (bus_V[2] * adjust_nominal_voltage_val));
+			}
+			else
+			{
+				adjusted_constant_current[5] = complex(0.0,0.0);
+			}
 
-				//Shunt values
-				undeltacurr[1] += bus[indexer].Y_dy[4]*bus[indexer].V[1];
+			//Start adjustments - AB
+			if ((bus_I_dy[0] != 0.0) && (adjust_temp_voltage_mag[0] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[0] = ~(adjust_temp_nominal_voltage[0] * ~bus_I_dy[0] * adjust_temp_voltage_mag[0] / (voltageDel[0] * adjust_nominal_voltaged_val));
+			}
+			else
+			{
+				adjusted_constant_current[0] = complex(0.0,0.0);
+			}
 
-				//Current values
-				undeltacurr[1] += adjusted_constant_current[4];
+			//Start adjustments - BC
+			if ((bus_I_dy[1] != 0.0) && (adjust_temp_voltage_mag[1] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[1] = ~(adjust_temp_nominal_voltage[1] * ~bus_I_dy[1] * adjust_temp_voltage_mag[1] / (voltageDel[1] * adjust_nominal_voltaged_val));
 			}
 			else
 			{
-				//Zero it, just in case
-				undeltacurr[1] = complex(0.0,0.0);
+				adjusted_constant_current[1] = complex(0.0,0.0);
 			}
 
-			if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
+			//Start adjustments - CA
+			if ((bus_I_dy[2] != 0.0) && (adjust_temp_voltage_mag[2] != 0.0))
+			{
+				//calculate new value
+				adjusted_constant_current[2] = ~(adjust_temp_nominal_voltage[2] * ~bus_I_dy[2] * adjust_temp_voltage_mag[2] / (voltageDel[2] * adjust_nominal_voltaged_val));
+			}
+			else
 			{
-				undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+				adjusted_constant_current[2] = complex(0.0,0.0);
+			}
+		}//End deltamode adjustment
+		else	//Normal mode
+		{
+			//Just copy the values in
+			adjusted_constant_current[0] = bus_I_dy[0];
+			adjusted_constant_current[1] = bus_I_dy[1];
+			adjusted_constant_current[2] = bus_I_dy[2];
+			adjusted_constant_current[3] = bus_I_dy[3];
+			adjusted_constant_current[4] = bus_I_dy[4];
+			adjusted_constant_current[5] = bus_I_dy[5];
+		}
 
-				//Apply explicit wye-connected loads
+		//Convert delta-current into a phase current, where appropriate - reuse temp variable
+		//Everything will be accumulated into the "current" field for ease (including differents)
+		//Also handle wye currents in here (was a differently connected child code before)
+		if ((bus[indexer].phases & 0x04) == 0x04)	//Has a phase A
+		{
+			undeltacurr[0]=(adjusted_constant_current[0]+delta_current[0])-(adjusted_constant_current[2]+delta_current[2]);
 
-				//Power values
-				undeltacurr[2] += (bus[indexer].V[2] == 0) ? 0 : ~(bus[indexer].S_dy[5]/bus[indexer].V[2]);
+			//Apply explicit wye-connected loads
 
-				//Shunt values
-				undeltacurr[2] += bus[indexer].Y_dy[5]*bus[indexer].V[2];
+			//Power values
+			undeltacurr[0] += (bus_V[0] == 0) ? 0 : ~(bus_S_dy[3]/bus_V[0]);
 
-				//Current values
-				undeltacurr[2] += adjusted_constant_current[5];
-			}
-			else
+			//Shunt values
+			undeltacurr[0] += bus_Y_dy[3]*bus_V[0];
+
+			//Current values
+			undeltacurr[0] += adjusted_constant_current[3];
+		}
+		else
+		{
+			//Zero it, just in case
+			undeltacurr[0] = complex(0.0,0.0);
+		}
+
+		if ((bus[indexer].phases & 0x02) == 0x02)	//Has a phase B
+		{
+			undeltacurr[1]=(adjusted_constant_current[1]+delta_current[1])-(adjusted_constant_current[0]+delta_current[0]);
+
+			//Apply explicit wye-connected loads
+
+			//Power values
+			undeltacurr[1] += (bus_V[1] == 0) ? 0 : ~(bus_S_dy[4]/bus_V[1]);
+
+			//Shunt values
+			undeltacurr[1] += bus_Y_dy[4]*bus_V[1];
+
+			//Current values
+			undeltacurr[1] += adjusted_constant_current[4];
+		}
+		else
+		{
+			//Zero it, just in case
+			undeltacurr[1] = complex(0.0,0.0);
+		}
+
+		if ((bus[indexer].phases & 0x01) == 0x01)	//Has a phase C
+		{
+			undeltacurr[2]=(adjusted_constant_current[2]+delta_current[2])-(adjusted_constant_current[1]+delta_current[1]);
+
+			//Apply explicit wye-connected loads
+
+			//Power values
+			undeltacurr[2] += (bus_V[2] == 0) ? 0 : ~(bus_S_dy[5]/bus_V[2]);
+
+			//Shunt values
+			undeltacurr[2] += bus_Y_dy[5]*bus_V[2];
+
+			//Current values
+			undeltacurr[2] += adjusted_constant_current[5];
+		}
+		else
+		{
+			//Zero it, just in case
+			undeltacurr[2] = complex(0.0,0.0);
+		}
+
+		//Provide updates to relevant phases
+		//only compute and store phases that exist (make top heavy)
+		temp_index = -1;
+		temp_index_b = -1;
+
+		for (jindex=0; jindex<(size_t)powerflow_values->BA_diag[indexer].size; jindex++)
+		{
+			switch(bus[indexer].phases & 0x07) {
+				case 0x01:	//C
+					{
+						temp_index=0;
+						temp_index_b=2;
+						break;
+					}
+				case 0x02:	//B
+					{
+						temp_index=0;
+						temp_index_b=1;
+						break;
+					}
+				case 0x03:	//BC
+					{
+						if (jindex==0)	//B
+						{
+							temp_index=0;
+							temp_index_b=1;
+						}
+						else			//C
+						{
+							temp_index=1;
+							temp_index_b=2;
+						}
+						break;
+					}
+				case 0x04:	//A
+					{
+						temp_index=0;
+						temp_index_b=0;
+						break;
+					}
+				case 0x05:	//AC
+					{
+						if (jindex==0)	//A
+						{
+							temp_index=0;
+							temp_index_b=0;
+						}
+						else			//C
+						{
+							temp_index=1;
+							temp_index_b=2;
+						}
+						break;
+					}
+				case 0x06:	//AB
+				case 0x07:	//ABC
+					{
+						temp_index=jindex;
+						temp_index_b=jindex;
+						break;
+					}
+				default:
+					break;
+			}//end case
+
+			if (jacobian_pass == false)	//Current injection update
 			{
-				//Zero it, just in case
-				undeltacurr[2] = complex(0.0,0.0);
+				if (((int)temp_index==-1) || ((int)temp_index_b==-1))
+				{
+					GL_THROW("NR: A scheduled power update element failed.");
+					//Defined below
+				}
+
+				//Real power calculations
+				tempPbus = (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
+				bus_PL[temp_index] += tempPbus;	//Real power portion - all is current based -- accumulate in case mixed and matched with old above
+
+				//Reactive load calculations
+				tempQbus = (undeltacurr[temp_index_b]).Re() * (bus_V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus_V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
+				bus_QL[temp_index] += tempQbus;	//Reactive power portion - all is current based -- accumulate in case mixed and matched with old above
 			}
+			else	//Jacobian update
+			{
+				if (((int)temp_index==-1) || ((int)temp_index_b==-1))
+				{
+					GL_THROW("NR: A Jacobian update element failed.");
+					//Defined below
+				}
+
+				if ((bus_V[temp_index_b]).Mag()!=0)
+				{
+					//Apply as an accumulation, in case any "normal" connections are present too
+					bus_Jacob_A[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3); // + (undeltaimped[temp_index_b]).Im();// second part of equation(37) - no power term needed
+					bus_Jacob_B[temp_index] += -((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(38) - no power term needed
+					bus_Jacob_C[temp_index] +=((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus_V[temp_index_b]).Im(),2))/pow((bus_V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(39) - no power term needed
+					bus_Jacob_D[temp_index] += ((bus_V[temp_index_b]).Re()*(bus_V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus_V[temp_index_b]).Re(),2))/pow((bus_V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Im();// second part of equation(40) - no power term needed
+				}
+				else	//Zero voltage = only impedance is valid (others get divided by VMag, so are IND) - not entirely sure how this gets in here anyhow
+				{
+					bus_Jacob_A[temp_index] += -1e-4; //(undeltaimped[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularities (if impedance is zero too)
+					bus_Jacob_B[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
+					bus_Jacob_C[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
+					bus_Jacob_D[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Im() - 1e-4;
+				}
+			}//End pass differentiation
+		}//End phase traversion
+	}//End delta/wye explicit loads
 
+	if (jacobian_pass == true)	//This part only gets done on the Jacobian update
+	{
+		//Delta load components  get added to the Jacobian values too -- mostly because this is the most convenient place to do it
+		//See if we're even needed first
+		if (bus[indexer].full_Y_load != NULL)
+		{
 			//Provide updates to relevant phases
 			//only compute and store phases that exist (make top heavy)
 			temp_index = -1;
@@ -5103,133 +5643,209 @@ void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT
 						break;
 				}//end case
 
-				if (jacobian_pass == false)	//Current injection update
+				if (((int)temp_index==-1) || ((int)temp_index_b==-1))
 				{
-					if (((int)temp_index==-1) || ((int)temp_index_b==-1))
-					{
-						GL_THROW("NR: A scheduled power update element failed.");
-						//Defined below
-					}
-
-					//Real power calculations
-					tempPbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Im();	// Real power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].PL[temp_index] += tempPbus;	//Real power portion - all is current based -- accumulate in case mixed and matched with old above
-
-					//Reactive load calculations
-					tempQbus = (undeltacurr[temp_index_b]).Re() * (bus[indexer].V[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Im() * (bus[indexer].V[temp_index_b]).Re();	// Reactive power portion of Constant current component multiply the magnitude of bus voltage
-					bus[indexer].QL[temp_index] += tempQbus;	//Reactive power portion - all is current based -- accumulate in case mixed and matched with old above
+					GL_THROW("NR: A Jacobian update element failed.");
+					//Defined below
 				}
-				else	//Jacobian update
-				{
-					if (((int)temp_index==-1) || ((int)temp_index_b==-1))
-					{
-						GL_THROW("NR: A Jacobian update element failed.");
-						//Defined below
-					}
 
-					if ((bus[indexer].V[temp_index_b]).Mag()!=0)
-					{
-						//Apply as an accumulation, in case any "normal" connections are present too
-						bus[indexer].Jacob_A[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() + (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // + (undeltaimped[temp_index_b]).Im();// second part of equation(37) - no power term needed
-						bus[indexer].Jacob_B[temp_index] += -((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() + (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(38) - no power term needed
-						bus[indexer].Jacob_C[temp_index] +=((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Im() - (undeltacurr[temp_index_b]).Re() *pow((bus[indexer].V[temp_index_b]).Im(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Re();// second part of equation(39) - no power term needed
-						bus[indexer].Jacob_D[temp_index] += ((bus[indexer].V[temp_index_b]).Re()*(bus[indexer].V[temp_index_b]).Im()*(undeltacurr[temp_index_b]).Re() - (undeltacurr[temp_index_b]).Im() *pow((bus[indexer].V[temp_index_b]).Re(),2))/pow((bus[indexer].V[temp_index_b]).Mag(),3); // - (undeltaimped[temp_index_b]).Im();// second part of equation(40) - no power term needed
-					}
-					else	//Zero voltage = only impedance is valid (others get divided by VMag, so are IND) - not entirely sure how this gets in here anyhow
-					{
-						bus[indexer].Jacob_A[temp_index] += -1e-4; //(undeltaimped[temp_index_b]).Im() - 1e-4;	//Small offset to avoid singularities (if impedance is zero too)
-						bus[indexer].Jacob_B[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_C[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Re() - 1e-4;
-						bus[indexer].Jacob_D[temp_index] += -1e-4; //-(undeltaimped[temp_index_b]).Im() - 1e-4;
-					}
-				}//End pass differentiation
+				//Accumulate the values
+				bus_Jacob_A[temp_index] += bus[indexer].full_Y_load[temp_index_b].Im();
+				bus_Jacob_B[temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
+				bus_Jacob_C[temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
+				bus_Jacob_D[temp_index] -= bus[indexer].full_Y_load[temp_index_b].Im();
 			}//End phase traversion
-		}//End delta/wye explicit loads
+		}//End deltamode-enabled in-rush loads updates
+	}//End Jacobian pass for deltamode loads
+}
 
-		if (jacobian_pass == true)	//This part only gets done on the Jacobian update
-		{
-			//Delta load components  get added to the Jacobian values too -- mostly because this is the most convenient place to do it
-			//See if we're even needed first
-			if (bus[indexer].full_Y_load != NULL)
-			{
-				//Provide updates to relevant phases
-				//only compute and store phases that exist (make top heavy)
-				temp_index = -1;
-				temp_index_b = -1;
+//Evaluates one part of the binned buses - part of parts of each bin, so threads get similar work
+template <bool jacobian_pass> static void compute_load_part(BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, unsigned int part, unsigned int parts)
+{
+	NR_SOLVER_STATE *state = &powerflow_values->state;
+	unsigned int bin, count, first, last, index;
 
-				for (jindex=0; jindex<(size_t)powerflow_values->BA_diag[indexer].size; jindex++)
-				{
-					switch(bus[indexer].phases & 0x07) {
-						case 0x01:	//C
-							{
-								temp_index=0;
-								temp_index_b=2;
-								break;
-							}
-						case 0x02:	//B
-							{
-								temp_index=0;
-								temp_index_b=1;
-								break;
-							}
-						case 0x03:	//BC
-							{
-								if (jindex==0)	//B
-								{
-									temp_index=0;
-									temp_index_b=1;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x04:	//A
-							{
-								temp_index=0;
-								temp_index_b=0;
-								break;
-							}
-						case 0x05:	//AC
-							{
-								if (jindex==0)	//A
-								{
-									temp_index=0;
-									temp_index_b=0;
-								}
-								else			//C
-								{
-									temp_index=1;
-									temp_index_b=2;
-								}
-								break;
-							}
-						case 0x06:	//AB
-						case 0x07:	//ABC
-							{
-								temp_index=jindex;
-								temp_index_b=jindex;
-								break;
-							}
-						default:
-							break;
-					}//end case
+	for (bin=0; bin<NR_LOAD_BINS; bin++)
+	{
+		count = state->load_bin[bin+1] - state->load_bin[bin];
+		first = state->load_bin[bin] + (unsigned int)(((size_t)count*part)/parts);
+		last = state->load_bin[bin] + (unsigned int)(((size_t)count*(part+1))/parts);
+
+		switch (bin) {
+			case NR_LOAD_WYE:
+				for (index=first; index<last; index++)
+					compute_load_wye<jacobian_pass>(bus,powerflow_values,state->load_bus[index]);
+				break;
+			case NR_LOAD_TRIPLEX:
+				for (index=first; index<last; index++)
+					compute_load_triplex<jacobian_pass>(bus,state,state->load_bus[index]);
+				break;
+			default:
+				for (index=first; index<last; index++)
+					compute_load_general<jacobian_pass>(bus,powerflow_values,state->load_bus[index]);
+				break;
+		}
+	}
+}
 
-					if (((int)temp_index==-1) || ((int)temp_index_b==-1))
-					{
-						GL_THROW("NR: A Jacobian update element failed.");
-						//Defined below
-					}
+//Worker threads kept by the solver state for the load calculations.  They are started the first
+//time a solution is split and wait on the condition variable between calls, so each Jacobian and
+//current injection pass only wakes them instead of creating and joining threads.
+typedef struct s_nr_load_worker {
+	pthread_t thread;
+	struct s_nr_load_pool *pool;
+	unsigned int part;
+} NR_LOAD_WORKER;
+
+typedef struct s_nr_load_pool {
+	unsigned int parts;			///< parts the pool was started for - the calling thread does part 0
+	unsigned int started;		///< workers running, they take parts 1 to started-1
+	NR_LOAD_WORKER worker[NR_LOAD_MAX_THREADS];
+	pthread_mutex_t lock;
+	pthread_cond_t go;			///< signalled when a new request is posted or the pool stops
+	pthread_cond_t done;		///< signalled when the last worker finishes a request
+	unsigned int request;		///< incremented for each request
+	unsigned int pending;		///< workers still working on the current request
+	bool stop;
+	BUSDATA *bus;				///< current request
+	NR_SOLVER_STRUCT *powerflow_values;
+	bool jacobian_pass;
+} NR_LOAD_POOL;
+
+static void *compute_load_worker(void *ptr)
+{
+	NR_LOAD_WORKER *data = (NR_LOAD_WORKER*)ptr;
+	NR_LOAD_POOL *pool = data->pool;
+	unsigned int seen = 0;	//a new pool starts at request 0
+
+	pthread_mutex_lock(&pool->lock);
+	while (true)
+	{
+		while ((pool->request == seen) && (pool->stop == false))
+			pthread_cond_wait(&pool->go,&pool->lock);
+		if (pool->stop == true)
+			break;
+		seen = pool->request;
+		pthread_mutex_unlock(&pool->lock);
+
+		if (pool->jacobian_pass == true)
+			compute_load_part<true>(pool->bus,pool->powerflow_values,data->part,pool->parts);
+		else
+			compute_load_part<false>(pool->bus,pool->powerflow_values,data->part,pool->parts);
+
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->pending == 0)
+			pthread_cond_signal(&pool->done);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+
+//Stops and releases the load calculation workers
+static void stop_load_pool(NR_SOLVER_STATE *state)
+{
+	NR_LOAD_POOL *pool = state->load_pool;
+	unsigned int part;
+
+	if (pool == NULL)
+		return;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = true;
+	pthread_cond_broadcast(&pool->go);
+	pthread_mutex_unlock(&pool->lock);
 
-					//Accumulate the values
-					bus[indexer].Jacob_A[temp_index] += bus[indexer].full_Y_load[temp_index_b].Im();
-					bus[indexer].Jacob_B[temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
-					bus[indexer].Jacob_C[temp_index] += bus[indexer].full_Y_load[temp_index_b].Re();
-					bus[indexer].Jacob_D[temp_index] -= bus[indexer].full_Y_load[temp_index_b].Im();
-				}//End phase traversion
-			}//End deltamode-enabled in-rush loads updates
-		}//End Jacobian pass for deltamode loads
-	}//end bus traversion for Jacobian or current injection items
+	for (part=1; part<pool->started; part++)
+		pthread_join(pool->worker[part].thread,NULL);
+
+	pthread_cond_destroy(&pool->go);
+	pthread_cond_destroy(&pool->done);
+	pthread_mutex_destroy(&pool->lock);
+	gl_free(pool);
+	state->load_pool = NULL;
+}
+
+//Gets the workers for the current number of parts, restarting them if the split changed
+static NR_LOAD_POOL *get_load_pool(NR_SOLVER_STATE *state)
+{
+	NR_LOAD_POOL *pool = state->load_pool;
+
+	if ((pool != NULL) && (pool->parts == state->load_parts))
+		return pool;
+
+	stop_load_pool(state);
+
+	pool = (NR_LOAD_POOL*)gl_malloc(sizeof(NR_LOAD_POOL));
+	if (pool == NULL)
+		return NULL;
+	memset(pool,0,sizeof(NR_LOAD_POOL));
+	pool->parts = state->load_parts;
+	pthread_mutex_init(&pool->lock,NULL);
+	pthread_cond_init(&pool->go,NULL);
+	pthread_cond_init(&pool->done,NULL);
+
+	//Parts that do not get a thread are done by the calling thread
+	for (pool->started=1; pool->started<pool->parts; pool->started++)
+	{
+		pool->worker[pool->started].pool = pool;
+		pool->worker[pool->started].part = pool->started;
+		if (pthread_create(&pool->worker[pool->started].thread,NULL,compute_load_worker,&pool->worker[pool->started]) != 0)
+			break;
+	}
+
+	state->load_pool = pool;
+	return pool;
+}
+
+//Performs the load calculation portions of the current injection or Jacobian update
+//jacobian_pass should be set to true for the a,b,c, and d updates
+// For first approach, working on system load at each bus for current injection
+// For the second approach, calculate the elements of a,b,c,d in equations(14),(15),(16),(17).
+//Buses are processed by the kernel for their bin (see gather_solver_state) and, on large systems,
+//split across NR_load_threads threads.  Each bus only writes its own entries, so the results do
+//not depend on the number of threads.
+void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, bool jacobian_pass)
+{
+	NR_SOLVER_STATE *state = &powerflow_values->state;
+	NR_LOAD_POOL *pool = NULL;
+	unsigned int parts = state->load_parts;
+	unsigned int part, started = 1;
+
+	if (parts > 1)
+		pool = get_load_pool(state);
+	else
+		stop_load_pool(state);
+
+	//Post the request to the workers
+	if (pool != NULL)
+	{
+		pthread_mutex_lock(&pool->lock);
+		pool->bus = bus;
+		pool->powerflow_values = powerflow_values;
+		pool->jacobian_pass = jacobian_pass;
+		pool->pending = pool->started - 1;
+		pool->request++;
+		pthread_cond_broadcast(&pool->go);
+		pthread_mutex_unlock(&pool->lock);
+		started = pool->started;
+	}
+
+	//Main thread takes the first part and anything that did not get a thread
+	for (part=0; part<parts; part++)
+	{
+		if (part!=0 && part<started)
+			continue;
+		if (jacobian_pass == true)
+			compute_load_part<true>(bus,powerflow_values,part,parts);
+		else
+			compute_load_part<false>(bus,powerflow_values,part,parts);
+	}
+
+	if (pool != NULL)
+	{
+		pthread_mutex_lock(&pool->lock);
+		while (pool->pending > 0)
+			pthread_cond_wait(&pool->done,&pool->lock);
+		pthread_mutex_unlock(&pool->lock);
+	}
 }//End load update function
@@ -28,8 +28,6 @@ typedef struct  {
 	complex *house_var;		///< Extra variable - used mainly for nominal house current 
 	int *Link_Table;		///< table of links that connect to us (for population purposes)
 	unsigned int Link_Table_Size;	///< Number of entries in the link table (number of links connected to us)
-	double PL[3];			///< real power component of total bus load
-	double QL[3];			///< reactive power component of total bus load
 	bool *dynamics_enabled;	///< Flag indicating this particular node has a dynamics contribution function
 	bool swing_functions_enabled;	///< Flag indicating if this particular node is a swing node, and if so, if it is behaving "all swingy"
 	complex *PGenTotal;		///< Total output of any generation at this node - lumped for now for dynamics
@@ -38,10 +36,6 @@ typedef struct  {
 	complex *BusSatTerm;	///< Saturation term pointer for in-rush-based transformer calculations - separate for ease
 	double volt_base;		///< voltage basis
     double mva_base;		/// MVA basis
-	double Jacob_A[3];		// Element a in equation (37), which is used to update the Jacobian matrix at each iteration
-	double Jacob_B[3];		// Element b in equation (38), which is used to update the Jacobian matrix at each iteration
-	double Jacob_C[3];		// Element c in equation (39), which is used to update the Jacobian matrix at each iteration
-	double Jacob_D[3];		// Element d in equation (40), which is used to update the Jacobian matrix at each iteration
 	unsigned int Matrix_Loc;// Starting index of this object's place in all matrices/equations
 	double max_volt_error;	///< Maximum voltage error specified for that node
 	const char *name;				///< original name
@@ -113,6 +107,51 @@ typedef struct {
 	unsigned int ncols;
 } SPARSE;
 
+//Load calculation kernels - each bus is binned by the connection its loads need
+typedef enum {
+	NR_LOAD_WYE=0,		///< wye-connected, no deltamode adjustments, "different" children, explicit delta/wye loads or in-rush admittance
+	NR_LOAD_TRIPLEX=1,	///< split-phase, no in-rush admittance
+	NR_LOAD_GENERAL=2,	///< everything else
+	NR_LOAD_BINS=3
+	} NR_LOADBIN;
+
+#define NR_LOAD_THREAD_BUSES 1024	///< minimum number of buses per thread for the load calculations
+#define NR_LOAD_MAX_THREADS 64		///< maximum number of threads for the load calculations
+#define NR_PREDICTOR_MAX_STEP 0.05	///< largest change (per unit of the bus voltage basis) the voltage predictor makes to a bus
+
+//Contiguous working copy of the bus and branch values the NR iterations read, owned by the solver.
+//Per-bus values are indexed 3*bus+phase (6*bus+n for the explicit delta/wye values), branch
+//admittances 9*branch+n.  Filled from BUSDATA/BRANCHDATA at the start of each solution.
+typedef struct {
+	unsigned int max_bus_count;		///< Number of buses the arrays are allocated for
+	unsigned int max_branch_count;	///< Number of branches the arrays are allocated for
+	dcomplex *V;				///< bus voltages - updates are written through to the nodes
+	dcomplex *S;				///< constant power
+	dcomplex *Y;				///< constant admittance
+	dcomplex *I;				///< constant current
+	dcomplex *prerot_I;		///< pre-rotated current (deltamode)
+	dcomplex *S_dy;			///< constant power -- explicit delta/wye values
+	dcomplex *Y_dy;			///< constant admittance -- explicit delta/wye values
+	dcomplex *I_dy;			///< constant current -- explicit delta/wye values
+	double *PL;				///< real power component of total bus load
+	double *QL;				///< reactive power component of total bus load
+	double *Jacob_A;		///< Element a in equation (37), which is used to update the Jacobian matrix at each iteration
+	double *Jacob_B;		///< Element b in equation (38), which is used to update the Jacobian matrix at each iteration
+	double *Jacob_C;		///< Element c in equation (39), which is used to update the Jacobian matrix at each iteration
+	double *Jacob_D;		///< Element d in equation (40), which is used to update the Jacobian matrix at each iteration
+	dcomplex *Yfrom;			///< branch admittance of from side of link
+	dcomplex *Yto;			///< branch admittance of to side of link
+	unsigned int *load_bus;	///< bus indices grouped by load calculation kernel
+	unsigned int load_bin[NR_LOAD_BINS+1];	///< first entry of each kernel's buses in load_bus
+	unsigned int load_parts;	///< number of threads the load calculations are split across
+	struct s_nr_load_pool *load_pool;	///< threads kept for the load calculations between calls - NULL until a solution is split
+	dcomplex *V_hist[2];		///< converged voltages of the last two timesteps - [0] is the latest
+	TIMESTAMP hist_time[2];		///< timesteps V_hist was saved at - 0 if empty
+	unsigned int hist_bus_count;	///< number of buses V_hist was saved for
+	TIMESTAMP predicted_time;	///< last timestep the voltage predictor ran at
+	double predicted_step;		///< largest change the voltage predictor made for the current solution [pu] - 0 if it did not run
+} NR_SOLVER_STATE;
+
 typedef struct {
 	double *deltaI_NR;					/// Storage array for current injection
 	unsigned int size_offdiag_PQ;		/// Number of fixed off-diagonal matrix elements
@@ -129,6 +168,7 @@ typedef struct {
 	Y_NR *Y_diag_fixed;					///Y_diag_fixed store the row,column and value of fixed diagonal elements of 6n*6n Y_NR matrix. No PV bus is included.
 	Y_NR *Y_diag_update;				///Y_diag_update store the row,column and value of updated diagonal elements of 6n*6n Y_NR matrix at each iteration. No PV bus is included.
 	SPARSE *Y_Amatrix;					///Y_Amatrix store all the elements of Amatrix in equation AX=B;
+	NR_SOLVER_STATE state;				///Contiguous copy of the bus and branch values used by the iterations
 } NR_SOLVER_STRUCT;
 
 //Mesh-fault-related structure - passing information
@@ -145,6 +185,7 @@ typedef struct {
 //void ext_solver_destroy(void *ext_array, bool new_iteration);
 
 int64 solver_nr(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STRUCT *powerflow_values, NRSOLVERMODE powerflow_type , NR_MESHFAULT_IMPEDANCE *mesh_imped_vals, bool *bad_computations);
+void gather_solver_state(unsigned int bus_count, BUSDATA *bus, unsigned int branch_count, BRANCHDATA *branch, NR_SOLVER_STATE *state);
 void compute_load_values(unsigned int bus_count, BUSDATA *bus, NR_SOLVER_STRUCT *powerflow_values, bool jacobian_pass);
 
 #endif
@@ -56,6 +56,7 @@ volt_var_control::volt_var_control(MODULE *mod) : powerflow_object(mod)
 			PT_char1024, "high_load_deadband",PADDR(vbw_high_txt),PT_DESCRIPTION,"High loading case voltage deadband for each regulator, separated by commas",
 			PT_char1024, "low_load_deadband",PADDR(vbw_low_txt),PT_DESCRIPTION,"Low loading case voltage deadband for each regulator, separated by commas",
 			PT_bool, "pf_signed",PADDR(pf_signed),PT_DESCRIPTION,"Set to true to consider the sign on the power factor.  Otherwise, it just maintains the deadband of +/-desired_pf",
+			PT_bool, "sensitivity_caching",PADDR(sensitivity_caching),PT_DESCRIPTION,"Set to true to cache the measured effect of each capacitor switch and use it to coordinate capacitor and regulator actions",
 			NULL) < 1) GL_THROW("unable to publish properties in %s",__FILE__);
     }
 }
@@ -112,6 +113,19 @@ int volt_var_control::create(void)
 
 	PrevRegState = NULL;
 
+	sensitivity_caching = false;	//Traditional one-action-at-a-time operation by default
+	reg_tap_moved = false;
+	cap_dV_to = NULL;
+	cap_dV_min = NULL;
+	cap_dQ = NULL;
+	cap_sens_valid = NULL;
+	sens_V_to = NULL;
+	sens_V_min = NULL;
+	sens_Q = 0.0;
+	sens_cap = -1;
+	sens_dir = 1.0;
+	sens_time = 0;
+
 
 	return result;
 }
@@ -1496,6 +1510,37 @@ int volt_var_control::init(OBJECT *parent)
 		}//end default
 	}//end 1 regulator, not dual listed
 
+	//Set up the capacitor sensitivity cache
+	if ((sensitivity_caching == true) && (num_caps > 0))
+	{
+		cap_dV_to = (double*)gl_malloc(num_caps*num_regs*3*sizeof(double));
+		cap_dV_min = (double*)gl_malloc(num_caps*num_regs*3*sizeof(double));
+		cap_dQ = (double*)gl_malloc(num_caps*sizeof(double));
+		cap_sens_valid = (bool*)gl_malloc(num_caps*sizeof(bool));
+		sens_V_to = (double*)gl_malloc(num_regs*3*sizeof(double));
+		sens_V_min = (double*)gl_malloc(num_regs*3*sizeof(double));
+
+		if ((cap_dV_to == NULL) || (cap_dV_min == NULL) || (cap_dQ == NULL) || (cap_sens_valid == NULL) || (sens_V_to == NULL) || (sens_V_min == NULL))
+		{
+			GL_THROW("volt_var_control %s: sensitivity cache allocation failure",obj->name);
+			/*  TROUBLESHOOT
+			While attempting to allocate space for the capacitor sensitivity cache, a memory allocation
+			error occurred.  Please try again.  If the problem persists, please submit your code and a bug
+			report via the trac website.
+			*/
+		}
+
+		//Nothing has been measured yet
+		for (index=0; (int)index < num_caps; index++)
+		{
+			cap_sens_valid[index] = false;
+		}
+	}
+	else	//Nothing to cache
+	{
+		sensitivity_caching = false;
+	}
+
 	//Determine phases to monitor - if none selected, default to the link phases
 	if ((pf_phase & (PHASE_A | PHASE_B | PHASE_C)) == 0)	//No phase (that we care about)
 	{
@@ -1565,9 +1610,20 @@ TIMESTAMP volt_var_control::presync(TIMESTAMP t0)
 	int prop_tap_changes[3];
 	bool limit_hit = false;	//mainly for banked operations
 	char LimitExceed = 0x00;	// U_D - XCBA_XCBA
+	bool predict_cap = false, defer_regs = false;
 
 	//Start out assuming a regulator change hasn't occurred
 	Regulator_Change = false;
+	reg_tap_moved = false;
+
+	//See if a capacitor was switched in the last pass - the voltages we see are from before it
+	if ((sensitivity_caching == true) && (sens_cap >= 0) && (sens_time == t0))
+	{
+		if (cap_sens_valid[sens_cap] == true)
+			predict_cap = true;		//Known effect, so predict where the voltages will end up
+		else
+			defer_regs = true;		//Unknown effect - leave the regulators until it has been solved and measured
+	}
 
 	//Now loop through the list - if one is over t0, then it is still changing
 	for (index=0; index<num_regs; index++)
@@ -1649,14 +1705,11 @@ TIMESTAMP volt_var_control::presync(TIMESTAMP t0)
 	{
 		for (reg_index=0; reg_index<num_regs; reg_index++)
 		{
-			if ((TRegUpdate[reg_index] <= t0) || (TRegUpdate[reg_index] == TS_NEVER))	//See if we're allowed to update
+			if (((TRegUpdate[reg_index] <= t0) || (TRegUpdate[reg_index] == TS_NEVER)) && (defer_regs == false))	//See if we're allowed to update
 			{
 				//Clear flag
 				LimitExceed = 0x00;
 
-				//Initialize "minimums" to something big
-				vmin[0] = vmin[1] = vmin[2] = 999999999999.0;
-
 				//Initialize VDrop and VSet value
 				VDrop[0] = VDrop[1] = VDrop[2] = 0.0;
 				VSet[0] = VSet[1] = VSet[2] = desired_voltage[reg_index];	//Default VSet to where we want
@@ -1664,42 +1717,19 @@ TIMESTAMP volt_var_control::presync(TIMESTAMP t0)
 				//Initialize tap changes
 				prop_tap_changes[0] = prop_tap_changes[1] = prop_tap_changes[2] = 0;
 
-				//Parse through the measurement list - find the lowest voltage - do by PT_PHASE
-				for (indexer=0; indexer<num_meas[reg_index]; indexer++)
-				{
-					//See if this node has phase A
-					if ((pMeasurement_list[reg_index][indexer]->phases & PHASE_A) == PHASE_A)	//Has phase A
-					{
-						if (pMeasurement_list[reg_index][indexer]->voltage[0].Mag() < vmin[0])	//New minimum
-						{
-							vmin[0] = pMeasurement_list[reg_index][indexer]->voltage[0].Mag();
-						}
-					}
+				//Pull the lowest measured voltage and the regulator's to-side voltage
+				get_reg_voltages(reg_index,vmin,VRegTo);
 
-					//See if this node has phase B
-					if ((pMeasurement_list[reg_index][indexer]->phases & PHASE_B) == PHASE_B)	//Has phase B
-					{
-						if (pMeasurement_list[reg_index][indexer]->voltage[1].Mag() < vmin[1])	//New minimum
-						{
-							vmin[1] = pMeasurement_list[reg_index][indexer]->voltage[1].Mag();
-						}
-					}
-
-					//See if this node has phase C
-					if ((pMeasurement_list[reg_index][indexer]->phases & PHASE_C) == PHASE_C)	//Has phase A
+				//A capacitor switched in the last pass hasn't been solved yet - use its cached effect
+				if (predict_cap == true)
+				{
+					for (indexer=0; indexer<3; indexer++)
 					{
-						if (pMeasurement_list[reg_index][indexer]->voltage[2].Mag() < vmin[2])	//New minimum
-						{
-							vmin[2] = pMeasurement_list[reg_index][indexer]->voltage[2].Mag();
-						}
+						vmin[indexer] += sens_dir * cap_dV_min[(sens_cap*num_regs+reg_index)*3+indexer];
+						VRegTo[indexer] += sens_dir * cap_dV_to[(sens_cap*num_regs+reg_index)*3+indexer];
 					}
 				}
 
-				//Populate VRegTo (to end voltages)
-				VRegTo[0] = RegToNodes[reg_index]->voltage[0].Mag();
-				VRegTo[1] = RegToNodes[reg_index]->voltage[1].Mag();
-				VRegTo[2] = RegToNodes[reg_index]->voltage[2].Mag();
-
 				//Populate VDrop and VSet based on PT_PHASE
 				if ((pRegulator_configs[reg_index]->PT_phase & PHASE_A) == PHASE_A)	//We have an A
 				{
@@ -2045,6 +2075,7 @@ TIMESTAMP volt_var_control::presync(TIMESTAMP t0)
 
 								//Flag as change
 								Regulator_Change = true;
+								reg_tap_moved = true;
 								TRegUpdate[reg_index] = t0 + (TIMESTAMP)RegUpdateTimes[reg_index];	//Set return time
 							}
 						}//end tap up
@@ -2062,6 +2093,7 @@ TIMESTAMP volt_var_control::presync(TIMESTAMP t0)
 
 								//Flag the change
 								Regulator_Change = true;
+								reg_tap_moved = true;
 								TRegUpdate[reg_index] = t0 + (TIMESTAMP)RegUpdateTimes[reg_index];	//Set return time
 							}
 						}//end tap down
@@ -2260,6 +2292,7 @@ TIMESTAMP volt_var_control::presync(TIMESTAMP t0)
 							pRegulator_list[reg_index]->tap[2]++;
 
 							Regulator_Change = true;					//Flag the change
+							reg_tap_moved = true;
 							TRegUpdate[reg_index] = t0 + (TIMESTAMP)RegUpdateTimes[reg_index];	//Set return time
 						}
 						//Default else - limit hit, so "no change"
@@ -2292,6 +2325,7 @@ TIMESTAMP volt_var_control::presync(TIMESTAMP t0)
 							pRegulator_list[reg_index]->tap[2]--;
 
 							Regulator_Change = true;					//Flag the change
+							reg_tap_moved = true;
 							TRegUpdate[reg_index] = t0 + (TIMESTAMP)RegUpdateTimes[reg_index];	//Set return time
 						}
 						//Default else - limit hit, so "no change"
@@ -2333,12 +2367,12 @@ TIMESTAMP volt_var_control::postsync(TIMESTAMP t0)
 	bool change_requested;
 	bool allow_change;
 	capacitor::CAPSWITCH bank_status;
-	double temp_size;
+	double temp_size, cap_var;
 	double curr_pf_temp = 0.0, react_pwr_temp = 0.0, des_react_pwr_temp = 0.0;
 	bool pf_add_capacitor = false, pf_check;	
 
 	//Grab power values and all of those related calculations
-	if ((control_method == ACTIVE) && (Regulator_Change == false))	//no regulator changes in progress and we're active
+	if ((control_method == ACTIVE) && ((Regulator_Change == false) || (sensitivity_caching == true)))	//no regulator changes in progress (or they can be predicted around) and we're active
 	{
 		link_power_vals = complex(0.0,0.0);	//Zero the power
 
@@ -2377,6 +2411,15 @@ TIMESTAMP volt_var_control::postsync(TIMESTAMP t0)
 			curr_pf = fabs(link_power_vals.Re())/link_power_vals.Mag();	//Pull in power factor
 		}
 
+		//A capacitor switched in the last pass has now been solved - see what it did
+		if (sens_cap >= 0)
+		{
+			if ((sens_time == t0) && (reg_tap_moved == false))	//Only the capacitor changed
+				measure_cap_sensitivity();
+
+			sens_cap = -1;	//Either way, it is handled
+		}
+
 		//Update "proceeding" variable
 		if (((solver_method == SM_NR) && (first_cycle==true)) || ((solver_method == SM_FBS) && (first_cycle == false)))
 			allow_change = true;	//Intermediate assignment since FBS likes to mess up power calculations on the first cycle
@@ -2466,6 +2509,12 @@ TIMESTAMP volt_var_control::postsync(TIMESTAMP t0)
 			//Parse through the capacitor list - see where they sit in the categories - break after one switching operation
 			for (index=0; index < num_caps; index++)
 			{
+				//Use the measured VAr change of the capacitor if we have one, otherwise its rating
+				if ((sensitivity_caching == true) && (cap_sens_valid[index] == true))
+					cap_var = fabs(cap_dQ[index]);
+				else
+					cap_var = Capacitor_size[index];
+
 				//Find the phases being watched, check their switch
 				if ((pCapacitor_list[index]->pt_phase & PHASE_A) == PHASE_A)
 					bank_status = (capacitor::CAPSWITCH)pCapacitor_list[index]->switchA_state;
@@ -2479,9 +2528,9 @@ TIMESTAMP volt_var_control::postsync(TIMESTAMP t0)
 					//Now perform logic based on where it is
 					if ((bank_status == capacitor::CLOSED) && (pf_add_capacitor==false))	//We are on and need to remove someone
 					{
-						temp_size = Capacitor_size[index] * d_max; //min;
+						temp_size = cap_var * d_max; //min;
 
-						if (react_pwr_temp >= temp_size)
+						if ((react_pwr_temp >= temp_size) && ((Regulator_Change == false) || cap_switch_safe(index,false)))
 						{
 							pCapacitor_list[index]->toggle_bank_status(false);	//Turn all off
 							change_requested = true;							//Flag a change
@@ -2490,9 +2539,9 @@ TIMESTAMP volt_var_control::postsync(TIMESTAMP t0)
 					}//end cap was on
 					else if ((bank_status == capacitor::OPEN) && (pf_add_capacitor==true))	//We're off and want to turn someone on
 					{
-						temp_size = Capacitor_size[index] * d_max;
+						temp_size = cap_var * d_max;
 
-						if (react_pwr_temp >= temp_size)
+						if ((react_pwr_temp >= temp_size) && ((Regulator_Change == false) || cap_switch_safe(index,true)))
 						{
 							pCapacitor_list[index]->toggle_bank_status(true);	//Turn all on
 							change_requested = true;							//Flag a change
@@ -2506,9 +2555,9 @@ TIMESTAMP volt_var_control::postsync(TIMESTAMP t0)
 					//Now perform logic based on where it is
 					if (bank_status == capacitor::CLOSED)	//We are on
 					{
-						temp_size = Capacitor_size[index] * d_min;
+						temp_size = cap_var * d_min;
 
-						if (react_pwr < temp_size)
+						if ((react_pwr < temp_size) && ((Regulator_Change == false) || cap_switch_safe(index,false)))
 						{
 							pCapacitor_list[index]->toggle_bank_status(false);	//Turn all off
 							change_requested = true;							//Flag a change
@@ -2517,9 +2566,9 @@ TIMESTAMP volt_var_control::postsync(TIMESTAMP t0)
 					}//end cap was on
 					else	//Must be false, so we're off
 					{
-						temp_size = Capacitor_size[index] * d_max;
+						temp_size = cap_var * d_max;
 
-						if (react_pwr > temp_size)
+						if ((react_pwr > temp_size) && ((Regulator_Change == false) || cap_switch_safe(index,true)))
 						{
 							pCapacitor_list[index]->toggle_bank_status(true);	//Turn all on
 							change_requested = true;							//Flag a change
@@ -2547,13 +2596,13 @@ TIMESTAMP volt_var_control::postsync(TIMESTAMP t0)
 							bank_status =(capacitor::CAPSWITCH) pCapacitor_list[index]->switchC_state;
 
 						//Now perform logic based on where it is - if anything is found to "fit" the criterion, just enact it
-						if ((bank_status == capacitor::CLOSED) && (pf_add_capacitor==false))	//We are on and need to remove someone
+						if ((bank_status == capacitor::CLOSED) && (pf_add_capacitor==false) && ((Regulator_Change == false) || cap_switch_safe(index,false)))	//We are on and need to remove someone
 						{
 							pCapacitor_list[index]->toggle_bank_status(false);	//Turn all off
 							change_requested = true;							//Flag a change
 							break;	//No more loop, only one control per loop
 						}//end cap was on
-						else if ((bank_status == capacitor::OPEN) && (pf_add_capacitor==true))	//We're off and want to turn someone on
+						else if ((bank_status == capacitor::OPEN) && (pf_add_capacitor==true) && ((Regulator_Change == false) || cap_switch_safe(index,true)))	//We're off and want to turn someone on
 						{
 							pCapacitor_list[index]->toggle_bank_status(true);	//Turn all on
 							change_requested = true;							//Flag a change
@@ -2567,6 +2616,10 @@ TIMESTAMP volt_var_control::postsync(TIMESTAMP t0)
 
 			if (change_requested == true)	//Something changed
 			{
+				//Keep the values from before the switch, so the next solution shows its effect
+				if (sensitivity_caching == true)
+					start_cap_sensitivity(index,t0);
+
 				TCapUpdate = t0 + (TIMESTAMP)CapUpdateTimes[index];	//Figure out where we want to go
 
 				return t0;	//But then stay here, mainly so the capacitor change we just enacted goes through
@@ -2622,6 +2675,142 @@ TIMESTAMP volt_var_control::postsync(TIMESTAMP t0)
 	}//End Non-accumulation cycle
 }
 
+//Function to pull the lowest measured voltage and the to-side voltage of a regulator, by phase
+void volt_var_control::get_reg_voltages(int reg_index, double *vmin, double *VRegTo)
+{
+	int indexer;
+
+	//Initialize "minimums" to something big
+	vmin[0] = vmin[1] = vmin[2] = 999999999999.0;
+
+	//Parse through the measurement list - find the lowest voltage - do by PT_PHASE
+	for (indexer=0; indexer<num_meas[reg_index]; indexer++)
+	{
+		//See if this node has phase A
+		if ((pMeasurement_list[reg_index][indexer]->phases & PHASE_A) == PHASE_A)	//Has phase A
+		{
+			if (pMeasurement_list[reg_index][indexer]->voltage[0].Mag() < vmin[0])	//New minimum
+			{
+				vmin[0] = pMeasurement_list[reg_index][indexer]->voltage[0].Mag();
+			}
+		}
+
+		//See if this node has phase B
+		if ((pMeasurement_list[reg_index][indexer]->phases & PHASE_B) == PHASE_B)	//Has phase B
+		{
+			if (pMeasurement_list[reg_index][indexer]->voltage[1].Mag() < vmin[1])	//New minimum
+			{
+				vmin[1] = pMeasurement_list[reg_index][indexer]->voltage[1].Mag();
+			}
+		}
+
+		//See if this node has phase C
+		if ((pMeasurement_list[reg_index][indexer]->phases & PHASE_C) == PHASE_C)	//Has phase A
+		{
+			if (pMeasurement_list[reg_index][indexer]->voltage[2].Mag() < vmin[2])	//New minimum
+			{
+				vmin[2] = pMeasurement_list[reg_index][indexer]->voltage[2].Mag();
+			}
+		}
+	}
+
+	//Populate VRegTo (to end voltages)
+	VRegTo[0] = RegToNodes[reg_index]->voltage[0].Mag();
+	VRegTo[1] = RegToNodes[reg_index]->voltage[1].Mag();
+	VRegTo[2] = RegToNodes[reg_index]->voltage[2].Mag();
+}
+
+//Function to store the regulator voltages and substation VArs right before a capacitor is switched
+void volt_var_control::start_cap_sensitivity(int cap_index, TIMESTAMP t0)
+{
+	capacitor::CAPSWITCH bank_status;
+	int reg_index;
+
+	//See which way it went - same phase as the switching logic watches
+	if ((pCapacitor_list[cap_index]->pt_phase & PHASE_A) == PHASE_A)
+		bank_status = (capacitor::CAPSWITCH)pCapacitor_list[cap_index]->switchA_state;
+	else if ((pCapacitor_list[cap_index]->pt_phase & PHASE_B) == PHASE_B)
+		bank_status = (capacitor::CAPSWITCH)pCapacitor_list[cap_index]->switchB_state;
+	else
+		bank_status = (capacitor::CAPSWITCH)pCapacitor_list[cap_index]->switchC_state;
+
+	sens_dir = (bank_status == capacitor::CLOSED) ? 1.0 : -1.0;
+
+	for (reg_index=0; reg_index<num_regs; reg_index++)
+	{
+		get_reg_voltages(reg_index,&sens_V_min[reg_index*3],&sens_V_to[reg_index*3]);
+	}
+
+	sens_Q = react_pwr;
+	sens_cap = cap_index;
+	sens_time = t0;
+}
+
+//Function to cache the effect of the capacitor switched in the last pass, now that it has been solved
+void volt_var_control::measure_cap_sensitivity(void)
+{
+	double vmin[3], VRegTo[3];
+	int reg_index, indexer, offset;
+
+	for (reg_index=0; reg_index<num_regs; reg_index++)
+	{
+		get_reg_voltages(reg_index,vmin,VRegTo);
+
+		offset = (sens_cap*num_regs+reg_index)*3;
+		for (indexer=0; indexer<3; indexer++)
+		{
+			//Phases without measurements stay at the "big" initial value - no change there
+			cap_dV_min[offset+indexer] = sens_dir * (vmin[indexer] - sens_V_min[reg_index*3+indexer]);
+			cap_dV_to[offset+indexer] = sens_dir * (VRegTo[indexer] - sens_V_to[reg_index*3+indexer]);
+		}
+	}
+
+	cap_dQ[sens_cap] = sens_dir * (react_pwr - sens_Q);
+	cap_sens_valid[sens_cap] = true;
+}
+
+//Function to predict, from the cached sensitivities, if switching a capacitor leaves the regulators alone.
+//Used to let capacitors switch while regulator changes are still in progress.
+bool volt_var_control::cap_switch_safe(int cap_index, bool close_cap)
+{
+	double vmin[3], VRegTo[3], vmin_pred, VRegTo_pred, VDrop_pred, bandwidth;
+	double dir = close_cap ? 1.0 : -1.0;
+	int reg_index, indexer, offset;
+	set phase_mask[3] = {PHASE_A, PHASE_B, PHASE_C};
+
+	if (cap_sens_valid[cap_index] == false)	//Never measured, so we can't say
+		return false;
+
+	for (reg_index=0; reg_index<num_regs; reg_index++)
+	{
+		get_reg_voltages(reg_index,vmin,VRegTo);
+
+		offset = (cap_index*num_regs+reg_index)*3;
+		for (indexer=0; indexer<3; indexer++)
+		{
+			if ((pRegulator_configs[reg_index]->PT_phase & phase_mask[indexer]) != phase_mask[indexer])
+				continue;
+
+			vmin_pred = vmin[indexer] + dir * cap_dV_min[offset+indexer];
+			VRegTo_pred = VRegTo[indexer] + dir * cap_dV_to[offset+indexer];
+
+			//Must not take us past a limit we aren't already past
+			if ((vmin_pred < minimum_voltage[reg_index]) && (vmin_pred < vmin[indexer]))
+				return false;
+			if ((VRegTo_pred > maximum_voltage[reg_index]) && (VRegTo_pred > VRegTo[indexer]))
+				return false;
+
+			//Must not push the regulator further out of its deadband - VSet-VRegTo is desired_voltage-vmin
+			VDrop_pred = VRegTo_pred - vmin_pred;
+			bandwidth = (VDrop_pred > max_vdrop[reg_index]) ? vbw_high[reg_index] : vbw_low[reg_index];
+			if ((fabs(desired_voltage[reg_index] - vmin_pred) > bandwidth) && (fabs(desired_voltage[reg_index] - vmin_pred) > fabs(desired_voltage[reg_index] - vmin[indexer])))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 //Function to parse a comma-separated list to get the next double (or the last double)
 char *volt_var_control::dbl_token(char *start_token, double *dbl_val)
 {
@@ -39,6 +39,7 @@ public:
 	double react_pwr;					//Reactive power quantity at the substation
 	double curr_pf;						//Current pf at the substation
 	bool pf_signed;						//Flag to indicate if a signed pf value should be maintained, or just a "deadband around 1"
+	bool sensitivity_caching;			//Flag to cache the measured effect of capacitor switching and use it to coordinate capacitor and regulator actions
 
 	volt_var_control(MODULE *mod);
 	volt_var_control(CLASS *cl=oclass):powerflow_object(cl){};
@@ -80,9 +81,24 @@ private:
 	regulator_configuration::Control_enum *PrevRegState;	//Previous state of the regulators
 	capacitor::CAPCONTROL *PrevCapState;					//Previous state of the capacitors
 	TIMESTAMP prev_time;
+	bool reg_tap_moved;							//Flag to indicate a regulator tap was moved this pass
+	double *cap_dV_to;							//Change of each regulator's to-side voltage when a capacitor closes - [cap][reg][phase]
+	double *cap_dV_min;							//Change of each regulator's lowest measured voltage when a capacitor closes - [cap][reg][phase]
+	double *cap_dQ;								//Change of the substation reactive power when a capacitor closes
+	bool *cap_sens_valid;						//Flag to indicate a capacitor's effect has been measured
+	double *sens_V_to;							//Regulator to-side voltages before the last capacitor switch - [reg][phase]
+	double *sens_V_min;							//Lowest measured voltages before the last capacitor switch - [reg][phase]
+	double sens_Q;								//Substation reactive power before the last capacitor switch
+	int sens_cap;								//Capacitor switched in the last pass, waiting on a solution to measure it (-1 if none)
+	double sens_dir;							//1.0 if that capacitor closed, -1.0 if it opened
+	TIMESTAMP sens_time;						//Time that capacitor was switched
 	void size_sorter(double *cap_size, int *cap_Index, int cap_num, double *temp_cap_size, int *temp_cap_Index);					//Capacitor size sorting function (recursive)
 	char *dbl_token(char *start_token, double *dbl_val);	//Function to parse a comma-separated list to get the next double (or the last double)
 	char *obj_token(char *start_token, OBJECT **obj_val);	//Function to parse a comma-separated list to get the next object (or the last object)
+	void get_reg_voltages(int reg_index, double *vmin, double *VRegTo);	//Function to pull the lowest measured and to-side voltages of a regulator
+	void start_cap_sensitivity(int cap_index, TIMESTAMP t0);	//Function to store the values before a capacitor switch
+	void measure_cap_sensitivity(void);						//Function to cache the effect of the last capacitor switch
+	bool cap_switch_safe(int cap_index, bool close_cap);	//Function to predict if a capacitor switch leaves the regulators alone
 };
 
 #endif // _VOLT_VAR_CONTROL_H
@@ -1938,36 +1938,46 @@ void house_e::update_model(double dt)
 	if(Ua < 0)
 		throw "UA must be positive";
 
-	a = Cm*Ca/Hm;
-	
-	if (window_open == 1)
-	{
-		b = Cm*(10*Ua+Hm)/Hm+Ca;
-		c = 10*Ua;
-		c1 = -(10*Ua + Hm)/Ca;
-	}
-	else
+	// the constants only change when the ETP parameters change
+	if ( Ca!=etp_Ca || Cm!=etp_Cm || Hm!=etp_Hm || Ua!=etp_Ua || window_open!=etp_window_open )
 	{
-		b = Cm*(Ua+Hm)/Hm+Ca;
-		c = Ua;
-		c1 = -(Ua + Hm)/Ca;
-	}
+		a = Cm*Ca/Hm;
 
-	c2 = Hm/Ca;
-	double rr = sqrt(b*b-4*a*c)/(2*a);
-	double r = -b/(2*a);
-	r1 = r+rr;
-	r2 = r-rr;
+		if (window_open == 1)
+		{
+			b = Cm*(10*Ua+Hm)/Hm+Ca;
+			c = 10*Ua;
+			c1 = -(10*Ua + Hm)/Ca;
+		}
+		else
+		{
+			b = Cm*(Ua+Hm)/Hm+Ca;
+			c = Ua;
+			c1 = -(Ua + Hm)/Ca;
+		}
 
-	if (window_open == 1)
-	{
-		A3 = Ca/Hm * r1 + (10*Ua+Hm)/Hm;
-		A4 = Ca/Hm * r2 + (10*Ua+Hm)/Hm;
-	}
-	else
-	{
-		A3 = Ca/Hm * r1 + (Ua+Hm)/Hm;
-		A4 = Ca/Hm * r2 + (Ua+Hm)/Hm;
+		c2 = Hm/Ca;
+		double rr = sqrt(b*b-4*a*c)/(2*a);
+		double r = -b/(2*a);
+		r1 = r+rr;
+		r2 = r-rr;
+
+		if (window_open == 1)
+		{
+			A3 = Ca/Hm * r1 + (10*Ua+Hm)/Hm;
+			A4 = Ca/Hm * r2 + (10*Ua+Hm)/Hm;
+		}
+		else
+		{
+			A3 = Ca/Hm * r1 + (Ua+Hm)/Hm;
+			A4 = Ca/Hm * r2 + (Ua+Hm)/Hm;
+		}
+
+		etp_Ca = Ca;
+		etp_Cm = Cm;
+		etp_Hm = Hm;
+		etp_Ua = Ua;
+		etp_window_open = window_open;
 	}
 
 	//for (i=1; i<9; i++) //Compass points of pSolar include direct normal and diffuse radiation into one value
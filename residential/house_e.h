@@ -423,6 +423,7 @@ private:
 	// internal variables used to track state of house */
 	double dTair;
 	double a,b,c,d,c1,c2,A3,A4,k1,k2,r1,r2,Teq,Tevent,Qi,Qa,Qm,adj_cooling_cap,adj_heating_cap,adj_cooling_cop,adj_heating_cop;
+	double etp_Ca,etp_Cm,etp_Hm,etp_Ua,etp_window_open; // ETP parameters used to compute a,b,c,c1,c2,r1,r2,A3,A4
 	double Qlatent;
 	static bool warn_control;
 	static double warn_low_temp;
@@ -63,9 +63,9 @@ double e2solve(double _a, double _n, double _b, double _m, double _c, double p,
 
 double e2solve(double a, double n, double b, double m, double c, double p, double *e)
 {
-	// load the solver if not yet loaded
-	static glsolver *etp = NULL;
-	static struct etpdata {
+	// load the solver if not yet loaded (the solver data is per thread because houses sync in parallel)
+	static thread_local glsolver *etp = NULL;
+	static thread_local struct etpdata {
 		double t,a,n,b,m,c,p,e;
 		unsigned int i;
 	} data;
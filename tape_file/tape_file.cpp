@@ -18,7 +18,10 @@
 #include <ctype.h>
 #include <time.h>
 
+#define DLMAIN
 #include "gridlabd.h"
+EXPORT int do_kill(void*) { return 0; }
+
 #include "../tape/tape.h"
 #include "../tape/histogram.h"
 #include "tape_file.h"
@@ -39,8 +42,8 @@ EXPORT void set_csv_keep_clean()
  */
 EXPORT int open_player(struct player *my, char *fname, char *flags)
 {
-	//char *ff = gl_findfile(fname,NULL,FF_READ);
-	char *ff = fname;
+	char buffer[1024];
+	const char *ff = gl_findfile(fname,NULL,R_OK,buffer,sizeof(buffer));
 
 	/* "-" means stdin */
 	my->fp = (strcmp(fname,"-")==0?stdin:(ff?fopen(ff,flags):NULL));